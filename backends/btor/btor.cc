@@ -37,6 +37,10 @@ PRIVATE_NAMESPACE_BEGIN
 
 struct BtorWorker
 {
+	// With -share or -coi the nodes are collected here and rewritten by
+	// reduce_nodes() before being written to the output stream.
+	std::stringstream node_buf;
+	std::ostream &out;
 	std::ostream &f;
 	SigMap sigmap;
 	RTLIL::Module *module;
@@ -44,6 +48,8 @@ struct BtorWorker
 	bool single_bad;
 	bool cover_mode;
 	bool print_internal_names;
+	bool share;
+	bool coi;
 
 	int next_nid = 1;
 	int initstate_nid = -1;
@@ -1158,8 +1164,207 @@ struct BtorWorker
 		return nid;
 	}
 
-	BtorWorker(std::ostream &f, RTLIL::Module *module, bool verbose, bool single_bad, bool cover_mode, bool print_internal_names, string info_filename, string ywmap_filename) :
-			f(f), sigmap(module), module(module), verbose(verbose), single_bad(single_bad), cover_mode(cover_mode), print_internal_names(print_internal_names), info_filename(info_filename)
+	// Operand layout of a BTOR line: the token indices (after "<nid> <op>")
+	// that refer to other nodes. The remaining tokens are literals or the
+	// symbol.
+	static void btor_operands(const std::vector<std::string> &tok, std::vector<int> &refs, int &end)
+	{
+		const std::string &op = tok[1];
+		int n = GetSize(tok);
+		refs.clear();
+		auto add_refs = [&](int first, int count) {
+			for (int i = first; i < first + count && i < n; i++)
+				refs.push_back(i);
+			end = std::min(first + count, n);
+		};
+
+		if (op == "sort") {
+			if (n > 2 && tok[2] == "array")
+				add_refs(3, 2);
+			else
+				end = std::min(4, n);
+		} else if (op == "input" || op == "state" || op == "zero" || op == "one" || op == "ones") {
+			add_refs(2, 1);
+		} else if (op == "const" || op == "constd" || op == "consth") {
+			add_refs(2, 1);
+			end = std::min(4, n);
+		} else if (op == "bad" || op == "constraint" || op == "fair" || op == "output") {
+			add_refs(2, 1);
+		} else if (op == "justice") {
+			add_refs(3, n > 2 ? atoi(tok[2].c_str()) : 0);
+		} else if (op == "slice") {
+			add_refs(2, 2);
+			end = std::min(6, n);
+		} else if (op == "uext" || op == "sext") {
+			add_refs(2, 2);
+			end = std::min(5, n);
+		} else if (op == "not" || op == "inc" || op == "dec" || op == "neg" || op == "redand" || op == "redor" || op == "redxor") {
+			add_refs(2, 2);
+		} else if (op == "ite" || op == "write") {
+			add_refs(2, 4);
+		} else {
+			add_refs(2, 3);
+		}
+	}
+
+	// Merges structurally identical nodes (-share) and removes the nodes
+	// that are not in the cone of influence of the bad states, constraints
+	// and fairness/justice properties (-coi). The remaining nodes are
+	// renumbered, as are the node references in the info file.
+	void reduce_nodes()
+	{
+		struct node_t {
+			std::string indent;
+			std::vector<std::string> tok;
+			std::vector<int> refs;
+			int end = 0;
+			int nid = 0;
+		};
+
+		std::vector<node_t> nodes;
+		dict<int, int> canonical;
+		dict<std::string, int> node_keys;
+		dict<int, int> nid_node;
+		dict<int, std::vector<int>> state_updates;
+		int num_nodes = 0, num_merged = 0;
+
+		std::string line;
+		while (std::getline(node_buf, line))
+		{
+			node_t node;
+			size_t pos = line.find_first_not_of(' ');
+			node.indent = line.substr(0, pos == std::string::npos ? line.size() : pos);
+
+			if (pos == std::string::npos || line[pos] == ';') {
+				node.tok.push_back(line.substr(node.indent.size()));
+				nodes.push_back(node);
+				continue;
+			}
+
+			node.tok = split_tokens(line.substr(pos), " ");
+			log_assert(GetSize(node.tok) >= 2);
+			node.nid = atoi(node.tok[0].c_str());
+			btor_operands(node.tok, node.refs, node.end);
+			num_nodes++;
+
+			for (int i : node.refs) {
+				int ref = atoi(node.tok[i].c_str());
+				int target = canonical.at(abs(ref), abs(ref));
+				node.tok[i] = stringf("%d", ref < 0 ? -target : target);
+			}
+
+			const std::string &op = node.tok[1];
+			bool shareable = !(op == "input" || op == "state" || op == "init" || op == "next" || op == "bad" ||
+					op == "constraint" || op == "fair" || op == "justice" || op == "output");
+
+			if (share && shareable) {
+				std::vector<std::string> key_tok(node.tok.begin() + 1, node.tok.begin() + node.end);
+				if ((op == "and" || op == "or" || op == "xor" || op == "nand" || op == "nor" || op == "xnor" ||
+						op == "add" || op == "mul" || op == "eq" || op == "neq" || op == "iff") && GetSize(key_tok) == 4 &&
+						key_tok[3] < key_tok[2])
+					std::swap(key_tok[2], key_tok[3]);
+				std::string key;
+				for (auto &t : key_tok)
+					key += t + " ";
+				auto found = node_keys.find(key);
+				if (found != node_keys.end()) {
+					canonical[node.nid] = found->second;
+					num_merged++;
+					continue;
+				}
+				node_keys[key] = node.nid;
+			}
+
+			if (op == "init" || op == "next")
+				state_updates[atoi(node.tok[3].c_str())].push_back(GetSize(nodes));
+			nid_node[node.nid] = GetSize(nodes);
+			nodes.push_back(node);
+		}
+
+		std::vector<bool> keep(GetSize(nodes), !coi);
+
+		if (coi) {
+			// States outside the cone keep their declaration (but lose their
+			// init and next nodes) so that the witness input and state
+			// indices do not depend on -coi.
+			std::vector<int> worklist, declarations;
+			for (int i = 0; i < GetSize(nodes); i++) {
+				if (nodes[i].nid == 0) {
+					keep[i] = true;
+					continue;
+				}
+				const std::string &op = nodes[i].tok[1];
+				if (op == "bad" || op == "constraint" || op == "fair" || op == "justice")
+					worklist.push_back(i);
+				if (op == "input" || op == "state")
+					declarations.push_back(i);
+			}
+			for (int pass = 0; pass < 2; pass++) {
+				while (!worklist.empty()) {
+					int i = worklist.back();
+					worklist.pop_back();
+					if (keep[i])
+						continue;
+					keep[i] = true;
+					for (int ref : nodes[i].refs)
+						worklist.push_back(nid_node.at(abs(atoi(nodes[i].tok[ref].c_str()))));
+					if (pass == 0 && nodes[i].tok[1] == "state")
+						for (int update : state_updates[nodes[i].nid])
+							worklist.push_back(update);
+				}
+				worklist = declarations;
+			}
+			for (int i = 0; i < GetSize(nodes); i++)
+				if (nodes[i].nid != 0 && nodes[i].tok[1] == "output")
+					keep[i] = keep[nid_node.at(abs(atoi(nodes[i].tok[2].c_str())))];
+		}
+
+		dict<int, int> renumber;
+		int next = 1;
+		for (int i = 0; i < GetSize(nodes); i++) {
+			auto &node = nodes[i];
+			if (node.nid == 0) {
+				if (keep[i])
+					out << node.indent << node.tok[0] << "\n";
+				continue;
+			}
+			if (!keep[i])
+				continue;
+			renumber[node.nid] = next;
+			node.tok[0] = stringf("%d", next++);
+			for (int ref : node.refs) {
+				int old = atoi(node.tok[ref].c_str());
+				int target = renumber.at(abs(old));
+				node.tok[ref] = stringf("%d", old < 0 ? -target : target);
+			}
+			out << node.indent;
+			for (int j = 0; j < GetSize(node.tok); j++)
+				out << (j ? " " : "") << node.tok[j];
+			out << "\n";
+		}
+
+		// info lines that refer to a removed node are dropped
+		vector<string> new_info_lines;
+		for (auto &info : info_lines) {
+			auto tok = split_tokens(info, " \n");
+			if (GetSize(tok) < 2 || tok[0] == "name") {
+				new_info_lines.push_back(info);
+				continue;
+			}
+			int old = atoi(tok[1].c_str());
+			int target = canonical.at(old, old);
+			if (!renumber.count(target))
+				continue;
+			new_info_lines.push_back(tok[0] + " " + stringf("%d", renumber.at(target)) + info.substr(info.find(tok[1]) + tok[1].size()));
+		}
+		info_lines.swap(new_info_lines);
+
+		log("Reduced the BTOR model from %d to %d nodes (%d merged by -share).\n", num_nodes, next - 1, num_merged);
+	}
+
+	BtorWorker(std::ostream &f, RTLIL::Module *module, bool verbose, bool single_bad, bool cover_mode, bool print_internal_names, bool share, bool coi, string info_filename, string ywmap_filename) :
+			out(f), f(share || coi ? node_buf : f), sigmap(module), module(module), verbose(verbose), single_bad(single_bad), cover_mode(cover_mode), print_internal_names(print_internal_names),
+			share(share), coi(coi), info_filename(info_filename)
 	{
 		if (!info_filename.empty())
 			infof("name %s\n", log_id(module));
@@ -1480,7 +1685,13 @@ struct BtorWorker
 					log_abort();
 				}
 			}
+		}
 
+		if (share || coi)
+			reduce_nodes();
+
+		if (!info_filename.empty())
+		{
 			std::ofstream f;
 			f.open(info_filename.c_str(), std::ofstream::trunc);
 			if (f.fail())
@@ -1556,10 +1767,22 @@ struct BtorBackend : public Backend {
 		log("  -ywmap <filename>\n");
 		log("    Create a map file for conversion to and from Yosys witness traces\n");
 		log("\n");
+		log("  -share\n");
+		log("    Emit structurally identical nodes only once. Nodes are compared after\n");
+		log("    their operands have been merged, so identical expression trees are\n");
+		log("    shared across the whole module.\n");
+		log("\n");
+		log("  -coi\n");
+		log("    Remove all nodes outside the cone of influence of the bad states,\n");
+		log("    constraints and fairness/justice properties. This drops e.g. taint\n");
+		log("    tracking logic that is not observed by any property. Inputs and states\n");
+		log("    are always declared so witness traces keep the same layout.\n");
+		log("\n");
 	}
 	void execute(std::ostream *&f, std::string filename, std::vector<std::string> args, RTLIL::Design *design) override
 	{
 		bool verbose = false, single_bad = false, cover_mode = false, print_internal_names = false;
+		bool share = false, coi = false;
 		string info_filename;
 		string ywmap_filename;
 
@@ -1598,6 +1821,14 @@ struct BtorBackend : public Backend {
 				ywmap_filename = args[++argidx];
 				continue;
 			}
+			if (args[argidx] == "-share") {
+				share = true;
+				continue;
+			}
+			if (args[argidx] == "-coi") {
+				coi = true;
+				continue;
+			}
 			break;
 		}
 		extra_args(f, filename, args, argidx);
@@ -1610,7 +1841,7 @@ struct BtorBackend : public Backend {
 		*f << stringf("; BTOR description generated by %s for module %s.\n",
 				yosys_version_str, log_id(topmod));
 
-		BtorWorker(*f, topmod, verbose, single_bad, cover_mode, print_internal_names, info_filename, ywmap_filename);
+		BtorWorker(*f, topmod, verbose, single_bad, cover_mode, print_internal_names, share, coi, info_filename, ywmap_filename);
 
 		*f << stringf("; end of yosys output\n");
 	}
@@ -34,7 +34,7 @@ struct Smt2Worker
 	CellTypes ct;
 	SigMap sigmap;
 	RTLIL::Module *module;
-	bool bvmode, memmode, wiresmode, verbose, statebv, statedt, forallmode;
+	bool bvmode, memmode, wiresmode, verbose, statebv, statedt, forallmode, share, coi;
 	dict<IdString, int> &mod_stbv_width;
 	int idcounter = 0, statebv_width = 0;
 
@@ -54,6 +54,11 @@ struct Smt2Worker
 	std::map<int, int> bvsizes;
 	dict<IdString, char*> ids;
 
+	// -share: functions already defined for an expression, -coi: the bits
+	// in the cone of influence of the properties
+	dict<std::string, int> shared_funs;
+	pool<SigBit> coi_bits;
+
 	bool is_smtlib2_module;
 
 	const char *get_id(IdString n)
@@ -115,9 +120,9 @@ struct Smt2Worker
 	}
 
 	Smt2Worker(RTLIL::Module *module, bool bvmode, bool memmode, bool wiresmode, bool verbose, bool statebv, bool statedt, bool forallmode,
-		   dict<IdString, int> &mod_stbv_width, dict<IdString, dict<IdString, pair<bool, bool>>> &mod_clk_cache)
+		   bool share, bool coi, dict<IdString, int> &mod_stbv_width, dict<IdString, dict<IdString, pair<bool, bool>>> &mod_clk_cache)
 	    : ct(module->design), sigmap(module), module(module), bvmode(bvmode), memmode(memmode), wiresmode(wiresmode), verbose(verbose),
-	      statebv(statebv), statedt(statedt), forallmode(forallmode), mod_stbv_width(mod_stbv_width),
+	      statebv(statebv), statedt(statedt), forallmode(forallmode), share(share), coi(coi), mod_stbv_width(mod_stbv_width),
 	      is_smtlib2_module(module->has_attribute(ID::smtlib2_module))
 	{
 		pool<SigBit> noclock;
@@ -303,7 +308,10 @@ struct Smt2Worker
 		log_assert(bvmode);
 		sigmap.apply(sig);
 
-		log_assert(bvsizes.count(id) == 0);
+		if (bvsizes.count(id)) {
+			// a function shared with -share
+			log_assert(share && bvsizes.at(id) == GetSize(sig));
+		}
 		bvsizes[id] = GetSize(sig);
 
 		for (int i = 0; i < GetSize(sig); i++) {
@@ -325,6 +333,21 @@ struct Smt2Worker
 			sigmap.add(sig[i], RTLIL::State::S0);
 	}
 
+	int define_fun(const std::string &type, const std::string &expr, const std::string &comment)
+	{
+		std::string key = type + " " + expr;
+		if (share) {
+			auto it = shared_funs.find(key);
+			if (it != shared_funs.end())
+				return it->second;
+			shared_funs[key] = idcounter;
+		}
+
+		decls.push_back(stringf("(define-fun |%s#%d| ((state |%s_s|)) %s %s) ; %s\n",
+				get_id(module), idcounter, get_id(module), type.c_str(), expr.c_str(), comment.c_str()));
+		return idcounter++;
+	}
+
 	std::string get_bool(RTLIL::SigBit bit, const char *state_name = "state")
 	{
 		sigmap.apply(bit);
@@ -448,9 +471,7 @@ struct Smt2Worker
 		if (verbose)
 			log("%*s-> import cell: %s\n", 2+2*GetSize(recursive_cells), "", log_id(cell));
 
-		decls.push_back(stringf("(define-fun |%s#%d| ((state |%s_s|)) Bool %s) ; %s\n",
-				get_id(module), idcounter, get_id(module), processed_expr.c_str(), log_signal(bit)));
-		register_bool(bit, idcounter++);
+		register_bool(bit, define_fun("Bool", processed_expr, log_signal(bit)));
 		recursive_cells.erase(cell);
 	}
 
@@ -499,13 +520,9 @@ struct Smt2Worker
 			log("%*s-> import cell: %s\n", 2+2*GetSize(recursive_cells), "", log_id(cell));
 
 		if (type == 'b') {
-			decls.push_back(stringf("(define-fun |%s#%d| ((state |%s_s|)) Bool %s) ; %s\n",
-					get_id(module), idcounter, get_id(module), processed_expr.c_str(), log_signal(sig_y)));
-			register_boolvec(sig_y, idcounter++);
+			register_boolvec(sig_y, define_fun("Bool", processed_expr, log_signal(sig_y)));
 		} else {
-			decls.push_back(stringf("(define-fun |%s#%d| ((state |%s_s|)) (_ BitVec %d) %s) ; %s\n",
-					get_id(module), idcounter, get_id(module), GetSize(sig_y), processed_expr.c_str(), log_signal(sig_y)));
-			register_bv(sig_y, idcounter++);
+			register_bv(sig_y, define_fun(stringf("(_ BitVec %d)", GetSize(sig_y)), processed_expr, log_signal(sig_y)));
 		}
 
 		recursive_cells.erase(cell);
@@ -529,9 +546,7 @@ struct Smt2Worker
 		if (verbose)
 			log("%*s-> import cell: %s\n", 2+2*GetSize(recursive_cells), "", log_id(cell));
 
-		decls.push_back(stringf("(define-fun |%s#%d| ((state |%s_s|)) Bool %s) ; %s\n",
-				get_id(module), idcounter, get_id(module), processed_expr.c_str(), log_signal(sig_y)));
-		register_boolvec(sig_y, idcounter++);
+		register_boolvec(sig_y, define_fun("Bool", processed_expr, log_signal(sig_y)));
 		recursive_cells.erase(cell);
 	}
 
@@ -751,9 +766,7 @@ struct Smt2Worker
 					log("%*s-> import cell: %s\n", 2+2*GetSize(recursive_cells), "", log_id(cell));
 
 				RTLIL::SigSpec sig = sigmap(cell->getPort(ID::Y));
-				decls.push_back(stringf("(define-fun |%s#%d| ((state |%s_s|)) (_ BitVec %d) %s) ; %s\n",
-						get_id(module), idcounter, get_id(module), width, processed_expr.c_str(), log_signal(sig)));
-				register_bv(sig, idcounter++);
+				register_bv(sig, define_fun(stringf("(_ BitVec %d)", width), processed_expr, log_signal(sig)));
 				recursive_cells.erase(cell);
 				return;
 			}
@@ -952,8 +965,67 @@ struct Smt2Worker
 					  log_id(wire));
 	}
 
+	// Collect the bits the properties (and, in submodules, the outputs)
+	// depend on, following the logic through registers and memories.
+	void find_coi_bits()
+	{
+		bool is_top = module == module->design->top_module();
+		dict<SigBit, Cell*> drivers;
+		std::vector<SigBit> worklist;
+
+		for (auto cell : module->cells()) {
+			bool is_property = cell->type.in(ID($assert), ID($assume), ID($cover));
+			bool is_hier = module->design->module(cell->type) != nullptr;
+			for (auto &conn : cell->connections()) {
+				if (cell->output(conn.first)) {
+					for (auto bit : sigmap(conn.second))
+						if (bit.wire)
+							drivers[bit] = cell;
+				} else if (is_property || is_hier) {
+					for (auto bit : sigmap(conn.second))
+						worklist.push_back(bit);
+				}
+			}
+		}
+
+		for (auto wire : module->wires())
+			if (wire->port_output && !is_top)
+				for (auto bit : sigmap(wire))
+					worklist.push_back(bit);
+
+		pool<Cell*> visited;
+		while (!worklist.empty()) {
+			SigBit bit = worklist.back();
+			worklist.pop_back();
+			if (bit.wire == nullptr || coi_bits.count(bit))
+				continue;
+			coi_bits.insert(bit);
+			auto it = drivers.find(bit);
+			if (it == drivers.end() || visited.count(it->second))
+				continue;
+			visited.insert(it->second);
+			for (auto &conn : it->second->connections())
+				if (!it->second->output(conn.first))
+					for (auto b : sigmap(conn.second))
+						worklist.push_back(b);
+		}
+	}
+
+	bool in_coi(RTLIL::Wire *wire)
+	{
+		if (!coi || wire->port_input)
+			return true;
+		for (auto bit : sigmap(wire))
+			if (coi_bits.count(bit))
+				return true;
+		return false;
+	}
+
 	void run()
 	{
+		if (coi)
+			find_coi_bits();
+
 		if (verbose) log("=> export logic driving outputs\n");
 
 		if (is_smtlib2_module)
@@ -991,6 +1063,8 @@ struct Smt2Worker
 			if (is_smtlib2_comb_expr && !is_smtlib2_module)
 				log_error("smtlib2_comb_expr is only valid in a module with the smtlib2_module attribute: wire %s.%s", log_id(module),
 					  log_id(wire));
+			if (!in_coi(wire))
+				continue;
 			if (wire->port_id || is_register || contains_clock || wire->get_bool_attribute(ID::keep) || (wiresmode && wire->name.isPublic())) {
 				RTLIL::SigSpec sig = sigmap(wire);
 				std::vector<std::string> comments;
@@ -1070,7 +1144,7 @@ struct Smt2Worker
 
 		vector<string> init_list;
 		for (auto wire : module->wires())
-			if (wire->attributes.count(ID::init)) {
+			if (wire->attributes.count(ID::init) && in_coi(wire)) {
 				if (is_smtlib2_module)
 					log_error("init attribute not allowed on wires in module with smtlib2_module attribute: wire %s.%s",
 						  log_id(module), log_id(wire));
@@ -1686,6 +1760,17 @@ struct Smt2Backend : public Backend {
 		log("        create '<mod>_n' functions for all public wires. by default only ports,\n");
 		log("        registers, and wires with the 'keep' attribute are exported.\n");
 		log("\n");
+		log("    -share\n");
+		log("        define a function only once for structurally identical expressions.\n");
+		log("        as operands are shared first, this merges identical expression trees\n");
+		log("        across the whole module.\n");
+		log("\n");
+		log("    -coi\n");
+		log("        only export registers and wires in the cone of influence of the\n");
+		log("        $assert, $assume and $cover cells (and of the submodule instances).\n");
+		log("        in the top module this also drops output ports outside the cone,\n");
+		log("        e.g. taint tracking outputs that are not checked by any property.\n");
+		log("\n");
 		log("    -tpl <template_file>\n");
 		log("        use the given template file. the line containing only the token '%%%%'\n");
 		log("        is replaced with the regular output of this command.\n");
@@ -1747,7 +1832,7 @@ struct Smt2Backend : public Backend {
 	{
 		std::ifstream template_f;
 		bool bvmode = true, memmode = true, wiresmode = false, verbose = false, statebv = false, statedt = false;
-		bool forallmode = false;
+		bool forallmode = false, share = false, coi = false;
 		dict<std::string, std::string> solver_options;
 
 		log_header(design, "Executing SMT2 backend.\n");
@@ -1797,6 +1882,14 @@ struct Smt2Backend : public Backend {
 				verbose = true;
 				continue;
 			}
+			if (args[argidx] == "-share") {
+				share = true;
+				continue;
+			}
+			if (args[argidx] == "-coi") {
+				coi = true;
+				continue;
+			}
 			if (args[argidx] == "-solver-option" && argidx+2 < args.size()) {
 				solver_options.emplace(args[argidx+1], args[argidx+2]);
 				argidx += 2;
@@ -1891,7 +1984,7 @@ struct Smt2Backend : public Backend {
 
 			log("Creating SMT-LIBv2 representation of module %s.\n", log_id(module));
 
-			Smt2Worker worker(module, bvmode, memmode, wiresmode, verbose, statebv, statedt, forallmode, mod_stbv_width, mod_clk_cache);
+			Smt2Worker worker(module, bvmode, memmode, wiresmode, verbose, statebv, statedt, forallmode, share, coi, mod_stbv_width, mod_clk_cache);
 			worker.run();
 			worker.write(*f);
 
@@ -472,32 +472,94 @@ void dump_memory(std::ostream &f, std::string indent, Mem &mem)
 				else
 					extmem_filename_esc += c;
 			}
-			f << stringf("%s" "initial $readmemb(\"%s\", %s);\n", indent.c_str(), extmem_filename_esc.c_str(), mem_id.c_str());
+			// Only the initialized words are written, using "@<addr>" to skip
+			// the gaps between them, and with hex digits unless a digit would
+			// mix x or z with other bits. The inits are moved into a scratch
+			// Mem for coalescing rather than copied, and handed back (in their
+			// equivalent coalesced form) once the file is written.
+			Mem init_mem(mem.module, mem.memid, mem.width, mem.start_offset, mem.size);
+			init_mem.inits.swap(mem.inits);
+			init_mem.coalesce_inits();
+
+			std::vector<const MemInit*> inits;
+			for (auto &init : init_mem.inits)
+				if (!init.removed)
+					inits.push_back(&init);
+			std::sort(inits.begin(), inits.end(), [](const MemInit *a, const MemInit *b) { return a->addr.as_int() < b->addr.as_int(); });
+
+			bool hex = true;
+			for (auto init : inits)
+				for (int i = 0; hex && i < GetSize(init->data); i += 4) {
+					int n = std::min(4, mem.width - i % mem.width);
+					State first = init->data[i];
+					for (int j = 0; j < n; j++) {
+						State bit = init->data[i+j];
+						if (first == State::S0 || first == State::S1) {
+							if (bit != State::S0 && bit != State::S1)
+								hex = false;
+						} else if (bit != first || (bit != State::Sx && bit != State::Sz))
+							hex = false;
+					}
+					i += n - 4;
+				}
+
+			f << stringf("%s" "initial $readmem%c(\"%s\", %s);\n", indent.c_str(), hex ? 'h' : 'b', extmem_filename_esc.c_str(), mem_id.c_str());
 
 			std::ofstream extmem_f(extmem_filename, std::ofstream::trunc);
 			if (extmem_f.fail())
 				log_error("Can't open file `%s' for writing: %s\n", extmem_filename.c_str(), strerror(errno));
 			else
 			{
-				Const data = mem.get_init_data();
-				for (int i=0; i<mem.size; i++)
+				// negative addresses can't be given with "@", in that case
+				// the gaps are filled with undefined words instead
+				bool use_addr = mem.start_offset >= 0;
+				int cursor = mem.start_offset;
+				std::string word;
+				auto dump_word = [&](const Const &data, int offset) {
+					word.clear();
+					for (int j = mem.width; j > 0; j -= hex ? 4 : 1) {
+						int lsb = hex ? (j - 1) / 4 * 4 : j - 1;
+						State bit = data[offset + lsb];
+						if (bit == State::Sm)
+							log_error("Found marker state in final netlist.");
+						if (bit == State::Sx)
+							word += 'x';
+						else if (bit == State::Sz)
+							word += 'z';
+						else if (bit == State::Sa)
+							word += '_';
+						else {
+							int value = 0;
+							for (int k = j - 1; k >= lsb; k--)
+								value = value * 2 + (data[offset + k] == State::S1);
+							word += "0123456789abcdef"[value];
+						}
+						j = lsb + (hex ? 4 : 1);
+					}
+					extmem_f << word << '\n';
+				};
+				Const undef_word(State::Sx, mem.width);
+				for (auto init : inits)
 				{
-					RTLIL::Const element = data.extract(i*mem.width, mem.width);
-					for (int j=0; j<element.size(); j++)
+					int addr = init->addr.as_int();
+					for (int i = 0; i < GetSize(init->data) / mem.width; i++, addr++)
 					{
-						switch (element[element.size()-j-1])
-						{
-							case State::S0: extmem_f << '0'; break;
-							case State::S1: extmem_f << '1'; break;
-							case State::Sx: extmem_f << 'x'; break;
-							case State::Sz: extmem_f << 'z'; break;
-							case State::Sa: extmem_f << '_'; break;
-							case State::Sm: log_error("Found marker state in final netlist.");
+						if (addr < mem.start_offset || addr >= mem.start_offset + mem.size)
+							continue;
+						if (addr != cursor) {
+							if (use_addr)
+								extmem_f << stringf("@%x\n", addr);
+							else
+								for (; cursor < addr; cursor++)
+									dump_word(undef_word, 0);
 						}
+						dump_word(init->data, i * mem.width);
+						cursor = addr + 1;
 					}
-					extmem_f << '\n';
 				}
 			}
+
+			mem.inits.swap(init_mem.inits);
 		}
 		else
 		{
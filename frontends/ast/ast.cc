@@ -29,6 +29,7 @@
 
 #include "kernel/yosys.h"
 #include "libs/sha1/sha1.h"
+#include "backends/rtlil/rtlil_backend.h"
 #include "ast.h"
 
 YOSYS_NAMESPACE_BEGIN
@@ -47,6 +48,7 @@ namespace AST {
 namespace AST_INTERNAL {
 	bool flag_nodisplay, flag_dump_ast1, flag_dump_ast2, flag_no_dump_ptr, flag_dump_vlog1, flag_dump_vlog2, flag_dump_rtlil, flag_nolatches, flag_nomeminit;
 	bool flag_nomem2reg, flag_mem2reg, flag_noblackbox, flag_lib, flag_nowb, flag_noopt, flag_icells, flag_pwires, flag_autowire;
+	std::string flag_cache_dir;
 	AstNode *current_ast, *current_ast_mod;
 	std::map<std::string, AstNode*> current_scope;
 	const dict<RTLIL::SigBit, RTLIL::SigBit> *genRTLIL_subst_ptr = NULL;
@@ -229,6 +231,7 @@ AstNode::AstNode(AstNodeType type, AstNode *child1, AstNode *child2, AstNode *ch
 	realvalue = 0;
 	id2ast = NULL;
 	basic_prep = false;
+	clean_epoch = 0;
 	lookahead = false;
 	in_lvalue_from_above = false;
 	in_param_from_above = false;
@@ -252,6 +255,7 @@ AstNode *AstNode::clone() const
 {
 	AstNode *that = new AstNode;
 	*that = *this;
+	that->clean_epoch = 0;
 	for (auto &it : that->children)
 		it = it->clone();
 	for (auto &it : that->attributes)
@@ -1067,6 +1071,150 @@ static bool param_has_no_default(const AstNode *param) {
 		(children.size() == 1 && children[0]->type == AST_RANGE);
 }
 
+// append everything in an AST that can affect the generated RTLIL to a string,
+// this is used as the key of the persistent module cache
+static void serialize_ast(const AstNode *node, std::string &out)
+{
+	out += stringf("(%d %zu:%s %zu:%s %u.%u-%u.%u ", node->type, node->str.size(), node->str.c_str(),
+			node->filename.size(), node->filename.c_str(), node->location.first_line, node->location.first_column,
+			node->location.last_line, node->location.last_column);
+	for (auto bit : node->bits)
+		out.push_back('0' + int(bit));
+	out += stringf(" %d%d%d%d%d%d%d%d%d%d%d%d%d %d %d %d %u %a %d", node->is_input, node->is_output, node->is_reg,
+			node->is_logic, node->is_signed, node->is_string, node->is_wand, node->is_wor, node->range_valid,
+			node->range_swapped, node->is_unsized, node->is_custom_type, node->is_enum, node->port_id,
+			node->range_left, node->range_right, node->integer, node->realvalue, node->unpacked_dimensions);
+	for (auto &dim : node->dimensions)
+		out += stringf(" [%d %d %d]", dim.range_right, dim.range_width, dim.range_swapped);
+	for (auto &it : node->attributes) {
+		out += " @" + it.first.str();
+		serialize_ast(it.second, out);
+	}
+	for (auto child : node->children)
+		if (child != nullptr)
+			serialize_ast(child, out);
+	out += ")";
+}
+
+// collect the types of the instantiated cells, returns false for modules that
+// can't be cached because they generate more than the RTLIL module itself or
+// read data files whose contents are not part of the key
+static bool collect_celltypes(const AstNode *node, std::set<std::string> &celltypes)
+{
+	if (node->type == AST_BIND)
+		return false;
+	if (node->type == AST_TCALL && (node->str == "\\$readmemh" || node->str == "\\$readmemb"))
+		return false;
+	if (node->type == AST_CELLTYPE && node->str.compare(0, 1, "$") != 0)
+		celltypes.insert(node->str);
+	for (auto child : node->children)
+		if (child != nullptr && !collect_celltypes(child, celltypes))
+			return false;
+	return true;
+}
+
+// the name of the cache file for the RTLIL generated from the given AST with
+// the current flags, or an empty string if the module can't be cached
+static std::string module_cache_file(RTLIL::Design *design, AstNode *ast)
+{
+	std::set<std::string> celltypes;
+	if (!collect_celltypes(ast, celltypes))
+		return std::string();
+
+	std::string key = stringf("%s\n%d%d%d%d%d%d%d%d%d%d%d%d\n", yosys_version_str, flag_nodisplay, flag_nolatches,
+			flag_nomeminit, flag_nomem2reg, flag_mem2reg, flag_noblackbox, flag_lib, flag_nowb, flag_noopt,
+			flag_icells, flag_pwires, flag_autowire);
+	serialize_ast(ast, key);
+
+	// simplify() looks up the instantiated modules in the design, so their
+	// definitions and the derived variants that already exist are part of the key
+	std::set<std::string> context;
+	for (auto mod : design->modules()) {
+		std::string name = mod->name.str();
+		for (auto &type : celltypes)
+			if (name == type || name == "$abstract" + type ||
+					(name.compare(0, 8, "$paramod") == 0 && name.find(type) != std::string::npos)) {
+				context.insert(name);
+				break;
+			}
+	}
+
+	for (auto &name : context) {
+		RTLIL::Module *mod = design->module(name);
+		key += "\n" + name + "\n";
+		AstModule *ast_mod = dynamic_cast<AstModule*>(mod);
+		if (ast_mod != nullptr && ast_mod->ast != nullptr) {
+			serialize_ast(ast_mod->ast, key);
+		} else {
+			std::stringstream buf;
+			RTLIL_BACKEND::dump_module(buf, "", mod, design, false);
+			key += buf.str();
+		}
+	}
+
+	return flag_cache_dir + "/" + sha1(key) + ".il";
+}
+
+static bool load_cached_module(RTLIL::Module *module, const std::string &filename)
+{
+	std::ifstream f(filename);
+	if (f.fail())
+		return false;
+
+	RTLIL::Design *cache_design = new RTLIL::Design;
+	{
+		LogMakeDebugHdl debug_hdl(true);
+		Frontend::frontend_call(cache_design, &f, filename, "read_rtlil");
+	}
+
+	RTLIL::Module *cached = cache_design->module(module->name);
+	if (cached != nullptr)
+		cached->cloneInto(module);
+	delete cache_design;
+	return cached != nullptr;
+}
+
+static void store_cached_module(RTLIL::Design *design, RTLIL::Module *module, const std::string &filename)
+{
+	// write to a temporary file first so that concurrent runs never see a
+	// partially written cache entry
+	std::string tmp_filename = make_temp_file(filename + ".XXXXXX");
+	std::ofstream f(tmp_filename);
+	if (f.fail()) {
+		log_warning("Can't write module cache file `%s'.\n", tmp_filename.c_str());
+		return;
+	}
+	RTLIL_BACKEND::dump_module(f, "", module, design, false);
+	f.close();
+
+	if (rename(tmp_filename.c_str(), filename.c_str()) != 0)
+		remove(tmp_filename.c_str());
+}
+
+// the AST of a module is only used to elaborate it again: to derive variants
+// with other parameter values or interfaces, and to reprocess it once the modules
+// it instantiates are available. A module that instantiates other user modules
+// can also be derived with the hierarchical defparams of its parent, whatever
+// the declaration order. Returns false if none of this can happen.
+static bool module_ast_needed(const AstNode *ast, RTLIL::Module *module)
+{
+	if (ast->type == AST_INTERFACE)
+		return true;
+	for (auto child : ast->children)
+		if (child->type == AST_PARAMETER)
+			return true;
+	for (auto wire : module->wires())
+		if (wire->get_bool_attribute(ID::is_interface))
+			return true;
+	for (auto cell : module->cells()) {
+		if (cell->has_attribute(ID::reprocess_after))
+			return true;
+		if (!cell->type.begins_with("$"))
+			return true;
+	}
+	return false;
+}
+
 static RTLIL::Module *process_module(RTLIL::Design *design, AstNode *ast, bool defer, AstNode *original_ast = NULL, bool quiet = false)
 {
 	log_assert(current_scope.empty());
@@ -1104,7 +1252,16 @@ static RTLIL::Module *process_module(RTLIL::Design *design, AstNode *ast, bool d
 		log("--- END OF AST DUMP ---\n");
 	}
 
-	if (!defer)
+	std::string cache_file;
+	bool cache_hit = false;
+	if (!defer && !flag_cache_dir.empty() && !flag_dump_ast2 && !flag_dump_vlog2) {
+		cache_file = module_cache_file(design, ast);
+		cache_hit = !cache_file.empty() && load_cached_module(module, cache_file);
+		if (cache_hit)
+			log("Loaded RTLIL representation for module `%s' from the cache.\n", ast->str.c_str());
+	}
+
+	if (!defer && !cache_hit)
 	{
 		for (const AstNode *node : ast->children)
 			if (node->type == AST_PARAMETER && param_has_no_default(node))
@@ -1252,7 +1409,7 @@ static RTLIL::Module *process_module(RTLIL::Design *design, AstNode *ast, bool d
 		ignoreThisSignalsInInitial = RTLIL::SigSpec();
 		current_scope.clear();
 	}
-	else {
+	else if (defer) {
 		for (auto &attr : ast->attributes) {
 			if (attr.second->type != AST_CONSTANT)
 				continue;
@@ -1277,8 +1434,17 @@ static RTLIL::Module *process_module(RTLIL::Design *design, AstNode *ast, bool d
 	module->icells = flag_icells;
 	module->pwires = flag_pwires;
 	module->autowire = flag_autowire;
+	module->cache_dir = flag_cache_dir;
 	module->fixup_ports();
 
+	if (!cache_file.empty() && !cache_hit)
+		store_cached_module(design, module, cache_file);
+
+	if (!defer && !module_ast_needed(ast_before_simplify, module)) {
+		delete module->ast;
+		module->ast = nullptr;
+	}
+
 	if (flag_dump_rtlil) {
 		log("Dumping generated RTLIL:\n");
 		log_module(module);
@@ -1345,7 +1511,7 @@ static void rename_in_package_stmts(AstNode *pkg)
 
 // create AstModule instances for all modules in the AST tree and add them to 'design'
 void AST::process(RTLIL::Design *design, AstNode *ast, bool nodisplay, bool dump_ast1, bool dump_ast2, bool no_dump_ptr, bool dump_vlog1, bool dump_vlog2, bool dump_rtlil,
-		bool nolatches, bool nomeminit, bool nomem2reg, bool mem2reg, bool noblackbox, bool lib, bool nowb, bool noopt, bool icells, bool pwires, bool nooverwrite, bool overwrite, bool defer, bool autowire)
+		bool nolatches, bool nomeminit, bool nomem2reg, bool mem2reg, bool noblackbox, bool lib, bool nowb, bool noopt, bool icells, bool pwires, bool nooverwrite, bool overwrite, bool defer, bool autowire, std::string cache_dir)
 {
 	current_ast = ast;
 	current_ast_mod = nullptr;
@@ -1367,6 +1533,7 @@ void AST::process(RTLIL::Design *design, AstNode *ast, bool nodisplay, bool dump
 	flag_icells = icells;
 	flag_pwires = pwires;
 	flag_autowire = autowire;
+	flag_cache_dir = cache_dir;
 
 	ast->fixup_hierarchy_flags(true);
 
@@ -1430,6 +1597,10 @@ void AST::process(RTLIL::Design *design, AstNode *ast, bool nodisplay, bool dump
 
 			process_module(design, child, defer_local);
 			current_ast_mod = nullptr;
+
+			// the module keeps its own copy of the AST if it needs one, so
+			// free the (possibly much larger) simplified AST right away
+			child->delete_children();
 		}
 		else if (child->type == AST_PACKAGE) {
 			// process enum/other declarations
@@ -1564,6 +1735,9 @@ void AstModule::expand_interfaces(RTLIL::Design *design, const dict<RTLIL::IdStr
 {
 	loadconfig();
 
+	if (ast == nullptr)
+		log_error("Module `%s' instantiates interfaces that were not available when it was elaborated.\n", log_id(name));
+
 	AstNode *new_ast = ast->clone();
 	for (auto &intf : local_interfaces) {
 		std::string intfname = intf.first.str();
@@ -1779,6 +1953,12 @@ std::string AstModule::derive_common(RTLIL::Design *design, const dict<RTLIL::Id
 	std::string stripped_name = name.str();
 	(*new_ast_out) = nullptr;
 
+	if (ast == nullptr) {
+		if (!parameters.empty())
+			log_error("Module `%s' has no parameters and can't be derived with parameter values.\n", log_id(name));
+		return stripped_name;
+	}
+
 	if (stripped_name.compare(0, 9, "$abstract") == 0)
 		stripped_name = stripped_name.substr(9);
 
@@ -1878,7 +2058,7 @@ RTLIL::Module *AstModule::clone() const
 	new_mod->name = name;
 	cloneInto(new_mod);
 
-	new_mod->ast = ast->clone();
+	new_mod->ast = ast ? ast->clone() : nullptr;
 	new_mod->nolatches = nolatches;
 	new_mod->nomeminit = nomeminit;
 	new_mod->nomem2reg = nomem2reg;
@@ -1890,6 +2070,7 @@ RTLIL::Module *AstModule::clone() const
 	new_mod->icells = icells;
 	new_mod->pwires = pwires;
 	new_mod->autowire = autowire;
+	new_mod->cache_dir = cache_dir;
 
 	return new_mod;
 }
@@ -1912,6 +2093,7 @@ void AstModule::loadconfig() const
 	flag_icells = icells;
 	flag_pwires = pwires;
 	flag_autowire = autowire;
+	flag_cache_dir = cache_dir;
 }
 
 void AstNode::input_error(const char *format, ...) const
@@ -600,6 +600,30 @@ static std::string prefix_id(const std::string &prefix, const std::string &str)
 	return prefix + str;
 }
 
+// Module items that are at a fixpoint of simplify() in stage 1 are marked with
+// the current epoch and skipped by the following passes over the module, so that
+// only the items that changed are visited again. The epoch is advanced whenever
+// something changes that other items can depend on: a declaration, a cell or any
+// other item that isn't a procedural block or an assignment, or the set of items.
+static unsigned int simplify_epoch = 1;
+
+static bool item_changes_context(AstNodeType type)
+{
+	switch (type) {
+	case AST_ASSIGN:
+	case AST_ALWAYS:
+	case AST_INITIAL:
+	case AST_ASSERT:
+	case AST_ASSUME:
+	case AST_LIVE:
+	case AST_FAIR:
+	case AST_COVER:
+		return false;
+	default:
+		return true;
+	}
+}
+
 // direct access to this global should be limited to the following two functions
 static const RTLIL::Design *simplify_design_context = nullptr;
 
@@ -934,7 +958,9 @@ bool AstNode::simplify(bool const_fold, int stage, int width_hint, bool sign_hin
 		log_assert(type == AST_MODULE || type == AST_INTERFACE);
 
 		deep_recursion_warning = true;
+		simplify_epoch++;
 		while (simplify(const_fold, 1, width_hint, sign_hint)) { }
+		simplify_epoch++;
 
 		if (!flag_nomem2reg && !get_bool_attribute(ID::nomem2reg))
 		{
@@ -1165,6 +1191,7 @@ bool AstNode::simplify(bool const_fold, int stage, int width_hint, bool sign_hin
 					}
 					children.erase(children.begin()+(i--));
 					did_something = true;
+					simplify_epoch++;
 					delete node;
 					continue;
 				wires_are_incompatible:
@@ -1194,9 +1221,13 @@ bool AstNode::simplify(bool const_fold, int stage, int width_hint, bool sign_hin
 		}
 		for (size_t i = 0; i < children.size(); i++) {
 			AstNode *node = children[i];
+			if (stage == 1 && const_fold && node->clean_epoch == simplify_epoch)
+				continue;
 			if (node->type == AST_PARAMETER || node->type == AST_LOCALPARAM || node->type == AST_WIRE || node->type == AST_AUTOWIRE || node->type == AST_MEMORY || node->type == AST_TYPEDEF)
-				while (node->simplify(true, 1, -1, false))
+				while (node->simplify(true, 1, -1, false)) {
 					did_something = true;
+					simplify_epoch++;
+				}
 			if (node->type == AST_ENUM) {
 				for (auto enode : node->children){
 					log_assert(enode->type==AST_ENUM_ITEM);
@@ -1390,8 +1421,10 @@ bool AstNode::simplify(bool const_fold, int stage, int width_hint, bool sign_hin
 		child_0_is_self_determined = true;
 		// test only once, before optimizations and memory mappings but after assignment LHS was mapped to an identifier
 		if (children[0]->id2ast && !children[0]->was_checked) {
-			if ((type == AST_ASSIGN_LE || type == AST_ASSIGN_EQ) && children[0]->id2ast->is_logic)
+			if ((type == AST_ASSIGN_LE || type == AST_ASSIGN_EQ) && children[0]->id2ast->is_logic && !children[0]->id2ast->is_reg) {
 				children[0]->id2ast->is_reg = true; // if logic type is used in a block asignment
+				simplify_epoch++;
+			}
 			if ((type == AST_ASSIGN_LE || type == AST_ASSIGN_EQ) && !children[0]->id2ast->is_reg)
 				log_warning("wire '%s' is assigned in a block at %s.\n", children[0]->str.c_str(), loc_string().c_str());
 			if (type == AST_ASSIGN && children[0]->id2ast->is_reg) {
@@ -1690,7 +1723,13 @@ bool AstNode::simplify(bool const_fold, int stage, int width_hint, bool sign_hin
 
 	// simplify all children first
 	// (iterate by index as e.g. auto wires can add new children in the process)
+	bool skip_clean_items = stage == 1 && const_fold && (type == AST_MODULE || type == AST_INTERFACE);
 	for (size_t i = 0; i < children.size(); i++) {
+		if (skip_clean_items && children[i]->clean_epoch == simplify_epoch)
+			continue;
+		size_t num_items = children.size();
+		AstNodeType item_type = children[i]->type;
+		bool item_changed = false;
 		bool did_something_here = true;
 		bool backup_flag_autowire = flag_autowire;
 		bool backup_unevaluated_tern_branch = unevaluated_tern_branch;
@@ -1736,7 +1775,14 @@ bool AstNode::simplify(bool const_fold, int stage, int width_hint, bool sign_hin
 				width_hint_here = -1, sign_hint_here = false;
 			did_something_here = children[i]->simplify(const_fold_here, stage, width_hint_here, sign_hint_here);
 			if (did_something_here)
-				did_something = true;
+				did_something = item_changed = true;
+		}
+		if (skip_clean_items) {
+			if (children.size() != num_items || (item_changed && (item_changes_context(item_type) ||
+					i >= children.size() || item_changes_context(children[i]->type))))
+				simplify_epoch++;
+			if (!did_something_here && i < children.size())
+				children[i]->clean_epoch = simplify_epoch;
 		}
 		if (stage == 2 && children[i]->type == AST_INITIAL && current_ast_mod != this) {
 			current_ast_mod->children.push_back(children[i]);
@@ -4374,6 +4420,7 @@ AstNode *AstNode::readmem(bool is_readmemh, std::string mem_filename, AstNode *m
 	int next_meminit_cursor=0;
 	vector<State> meminit_bits;
 	vector<State> en_bits;
+	vector<State> word_bits;
 	int meminit_size=0;
 
 	for (int i = 0; i < mem_width; i++)
@@ -4444,7 +4491,9 @@ AstNode *AstNode::readmem(bool is_readmemh, std::string mem_filename, AstNode *m
 				continue;
 			}
 
-			AstNode *value = VERILOG_FRONTEND::const2ast(stringf("%d'%c", mem_width, is_readmemh ? 'h' : 'b') + token);
+			// the words are parsed straight into bits, the data of an
+			// unconditional init never has to become an AST node per word
+			VERILOG_FRONTEND::digits2bits(word_bits, token.c_str(), mem_width, is_readmemh ? 16 : 2);
 
 			if (unconditional_init)
 			{
@@ -4471,11 +4520,11 @@ AstNode *AstNode::readmem(bool is_readmemh, std::string mem_filename, AstNode *m
 
 				meminit_size++;
 				next_meminit_cursor++;
-				meminit_bits.insert(meminit_bits.end(), value->bits.begin(), value->bits.end());
-				delete value;
+				meminit_bits.insert(meminit_bits.end(), word_bits.begin(), word_bits.end());
 			}
 			else
 			{
+				AstNode *value = AstNode::mkconst_bits(word_bits, false);
 				block->children.push_back(new AstNode(AST_ASSIGN_EQ, new AstNode(AST_IDENTIFIER, new AstNode(AST_RANGE, AstNode::mkconst_int(cursor, false))), value));
 				block->children.back()->children[0]->str = memory->str;
 				block->children.back()->children[0]->id2ast = memory;
@@ -19,43 +19,106 @@
 
 #include "blifparse.h"
 
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 YOSYS_NAMESPACE_BEGIN
 
 const int lut_input_plane_limit = 12;
 
-static bool read_next_line(char *&buffer, size_t &buffer_size, int &line_count, std::istream &f)
+// The lines of a BLIF file in a writable buffer. Lines are split and tokenized
+// in place, so the tokens stay valid for as long as the buffer does.
+struct BlifBuffer
 {
-	string strbuf;
-	int buffer_len = 0;
-	buffer[0] = 0;
+	char *pos, *end;
+	std::vector<char> last_line;
 
-	while (1)
+	BlifBuffer(char *data, size_t size) : pos(data), end(data + size) { }
+
+	// Get the next non-empty line without trailing whitespace, lines ending
+	// in a backslash are joined with the following line.
+	bool next_line(char *&line, int &line_count)
 	{
-		buffer_len += strlen(buffer + buffer_len);
-		while (buffer_len > 0 && (buffer[buffer_len-1] == ' ' || buffer[buffer_len-1] == '\t' ||
-				buffer[buffer_len-1] == '\r' || buffer[buffer_len-1] == '\n'))
-			buffer[--buffer_len] = 0;
-
-		if (buffer_size-buffer_len < 4096) {
-			buffer_size *= 2;
-			buffer = (char*)realloc(buffer, buffer_size);
-		}
+		char *start = pos, *wr = pos;
 
-		if (buffer_len == 0 || buffer[buffer_len-1] == '\\') {
-			if (buffer_len > 0 && buffer[buffer_len-1] == '\\')
-				buffer[--buffer_len] = 0;
+		while (1)
+		{
 			line_count++;
-			if (!std::getline(f, strbuf))
+			if (pos == end)
 				return false;
-			while (buffer_size-buffer_len < strbuf.size()+1) {
-				buffer_size *= 2;
-				buffer = (char*)realloc(buffer, buffer_size);
+
+			char *nl = (char*)memchr(pos, '\n', end - pos);
+			char *seg_end = nl ? nl : end;
+			if (wr != pos)
+				memmove(wr, pos, seg_end - pos);
+			wr += seg_end - pos;
+			pos = nl ? nl + 1 : end;
+
+			while (wr > start && (wr[-1] == ' ' || wr[-1] == '\t' || wr[-1] == '\r' || wr[-1] == '\n'))
+				wr--;
+
+			if (wr == start) {
+				start = wr = pos;
+				continue;
 			}
-			strcpy(buffer+buffer_len, strbuf.c_str());
-		} else
-			return true;
+
+			if (wr[-1] == '\\') {
+				wr--;
+				continue;
+			}
+
+			break;
+		}
+
+		if (wr == end) {
+			// last line without newline, no room for the terminator
+			last_line.assign(start, wr);
+			last_line.push_back(0);
+			line = last_line.data();
+		} else {
+			*wr = 0;
+			line = start;
+		}
+		return true;
 	}
-}
+};
+
+#ifndef _WIN32
+// A private writable memory mapping of a file, the changes made by the
+// tokenizer are not written back to the file
+struct BlifMappedFile
+{
+	void *data = MAP_FAILED;
+	size_t size = 0;
+
+	BlifMappedFile(const std::string &filename)
+	{
+		int fd = open(filename.c_str(), O_RDONLY);
+		if (fd < 0)
+			return;
+		struct stat st;
+		if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+			size = st.st_size;
+			data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		}
+		close(fd);
+		if (data != MAP_FAILED)
+			madvise(data, size, MADV_SEQUENTIAL);
+	}
+
+	bool ok() const { return data != MAP_FAILED; }
+
+	~BlifMappedFile()
+	{
+		if (ok())
+			munmap(data, size);
+	}
+};
+#endif
 
 static std::pair<RTLIL::IdString, int> wideports_split(std::string name)
 {
@@ -84,7 +147,7 @@ failed:
 	return std::pair<RTLIL::IdString, int>(RTLIL::IdString(), 0);
 }
 
-void parse_blif(RTLIL::Design *design, std::istream &f, IdString dff_name, bool run_clean, bool sop_mode, bool wideports)
+static void parse_blif_buffer(RTLIL::Design *design, BlifBuffer &lines, IdString dff_name, bool run_clean, bool sop_mode, bool wideports)
 {
 	RTLIL::Module *module = nullptr;
 	RTLIL::Const *lutptr = NULL;
@@ -94,22 +157,39 @@ void parse_blif(RTLIL::Design *design, std::istream &f, IdString dff_name, bool
 	std::string err_reason;
 	int blif_maxnum = 0, sopmode = -1;
 
-	auto blif_wire = [&](const std::string &wire_name) -> Wire*
+	// The names are tokens in the buffer, look up each one only once
+	dict<const char*, Wire*, hash_cstr_ops> wire_cache;
+	dict<const char*, IdString, hash_cstr_ops> id_cache;
+
+	auto blif_id = [&](const char *name) -> IdString
+	{
+		auto it = id_cache.find(name);
+		if (it != id_cache.end())
+			return it->second;
+		IdString id = RTLIL::escape_id(name);
+		id_cache[name] = id;
+		return id;
+	};
+
+	auto blif_wire = [&](const char *wire_name) -> Wire*
 	{
+		auto it = wire_cache.find(wire_name);
+		if (it != wire_cache.end())
+			return it->second;
+
 		if (wire_name[0] == '$')
 		{
-			for (int i = 0; i+1 < GetSize(wire_name); i++)
+			for (int i = 0; wire_name[i] && wire_name[i+1]; i++)
 			{
 				if (wire_name[i] != '$')
 					continue;
 
 				int len = 0;
-				while (i+len+1 < GetSize(wire_name) && '0' <= wire_name[i+len+1] && wire_name[i+len+1] <= '9')
+				while ('0' <= wire_name[i+len+1] && wire_name[i+len+1] <= '9')
 					len++;
 
 				if (len > 0) {
-					string num_str = wire_name.substr(i+1, len);
-					int num = atoi(num_str.c_str()) & 0x0fffffff;
+					int num = atoi(wire_name + i+1) & 0x0fffffff;
 					blif_maxnum = std::max(blif_maxnum, num);
 				}
 			}
@@ -121,6 +201,7 @@ void parse_blif(RTLIL::Design *design, std::istream &f, IdString dff_name, bool
 		if (wire == nullptr)
 			wire = module->addWire(wire_id);
 
+		wire_cache[wire_name] = wire;
 		return wire;
 	};
 
@@ -129,16 +210,14 @@ void parse_blif(RTLIL::Design *design, std::istream &f, IdString dff_name, bool
 
 	dict<RTLIL::IdString, std::pair<int, bool>> wideports_cache;
 
-	size_t buffer_size = 4096;
-	char *buffer = (char*)malloc(buffer_size);
+	char *buffer = nullptr;
 	int line_count = 0;
 
 	while (1)
 	{
-		if (!read_next_line(buffer, buffer_size, line_count, f)) {
+		if (!lines.next_line(buffer, line_count)) {
 			if (module != nullptr)
 				goto error;
-			free(buffer);
 			return;
 		}
 
@@ -168,6 +247,7 @@ void parse_blif(RTLIL::Design *design, std::istream &f, IdString dff_name, bool
 					goto error;
 				module = new RTLIL::Module;
 				lastcell = nullptr;
+				wire_cache.clear();
 				char *name = strtok(NULL, " \t\r\n");
 				if (name == nullptr)
 					goto error;
@@ -251,6 +331,7 @@ void parse_blif(RTLIL::Design *design, std::istream &f, IdString dff_name, bool
 
 				module = nullptr;
 				lastcell = nullptr;
+				wire_cache.clear();
 				obj_attributes = nullptr;
 				obj_parameters = nullptr;
 				continue;
@@ -392,7 +473,7 @@ void parse_blif(RTLIL::Design *design, std::istream &f, IdString dff_name, bool
 				if (p == NULL)
 					goto error;
 
-				IdString celltype = RTLIL::escape_id(p);
+				IdString celltype = blif_id(p);
 				RTLIL::Cell *cell = module->addCell(NEW_ID, celltype);
 				RTLIL::Module *cell_mod = design->module(celltype);
 
@@ -408,11 +489,11 @@ void parse_blif(RTLIL::Design *design, std::istream &f, IdString dff_name, bool
 					if (wideports) {
 						std::pair<RTLIL::IdString, int> wp = wideports_split(p);
 						if (wp.first.empty())
-							cell->setPort(RTLIL::escape_id(p), *q ? blif_wire(q) : SigSpec());
+							cell->setPort(blif_id(p), *q ? blif_wire(q) : SigSpec());
 						else
 							cell_wideports_cache[wp.first][wp.second] = blif_wire(q);
 					} else {
-						cell->setPort(RTLIL::escape_id(p), *q ? blif_wire(q) : SigSpec());
+						cell->setPort(blif_id(p), *q ? blif_wire(q) : SigSpec());
 					}
 				}
 
@@ -482,7 +563,7 @@ void parse_blif(RTLIL::Design *design, std::istream &f, IdString dff_name, bool
 				{
 					RTLIL::State state = RTLIL::State::Sa;
 					while (1) {
-						if (!read_next_line(buffer, buffer_size, line_count, f))
+						if (!lines.next_line(buffer, line_count))
 							goto error;
 						for (int i = 0; buffer[i]; i++) {
 							if (buffer[i] == ' ' || buffer[i] == '\t')
@@ -621,6 +702,44 @@ error_with_reason:
 	log_error("Syntax error in line %d: %s\n", line_count, err_reason.c_str());
 }
 
+void parse_blif(RTLIL::Design *design, char *data, size_t size, IdString dff_name, bool run_clean, bool sop_mode, bool wideports)
+{
+	BlifBuffer lines(data, size);
+	parse_blif_buffer(design, lines, dff_name, run_clean, sop_mode, wideports);
+}
+
+void parse_blif(RTLIL::Design *design, std::istream &f, IdString dff_name, bool run_clean, bool sop_mode, bool wideports)
+{
+	std::vector<char> data;
+	size_t size = 0;
+
+	while (f) {
+		data.resize(size + (1 << 20));
+		f.read(data.data() + size, data.size() - size);
+		size += f.gcount();
+	}
+
+	parse_blif(design, data.data(), size, dff_name, run_clean, sop_mode, wideports);
+}
+
+bool parse_blif_file(RTLIL::Design *design, const std::string &filename, IdString dff_name, bool run_clean, bool sop_mode, bool wideports)
+{
+#ifndef _WIN32
+	BlifMappedFile mapped(filename);
+	if (mapped.ok()) {
+		parse_blif(design, (char*)mapped.data, mapped.size, dff_name, run_clean, sop_mode, wideports);
+		return true;
+	}
+#endif
+
+	std::ifstream f(filename);
+	if (f.fail())
+		return false;
+
+	parse_blif(design, f, dff_name, run_clean, sop_mode, wideports);
+	return true;
+}
+
 struct BlifFrontend : public Frontend {
 	BlifFrontend() : Frontend("blif", "read BLIF file") { }
 	void help() override
@@ -661,6 +780,11 @@ struct BlifFrontend : public Frontend {
 		}
 		extra_args(f, filename, args, argidx);
 
+		// map plain files into memory, compressed files and here documents
+		// are read from the stream
+		if (dynamic_cast<std::ifstream*>(f) != nullptr && parse_blif_file(design, filename, "", true, sop_mode, wideports))
+			return;
+
 		parse_blif(design, *f, "", true, sop_mode, wideports);
 	}
 } BlifFrontend;
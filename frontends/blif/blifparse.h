@@ -27,6 +27,14 @@ YOSYS_NAMESPACE_BEGIN
 extern void parse_blif(RTLIL::Design *design, std::istream &f, IdString dff_name,
 		bool run_clean = false, bool sop_mode = false, bool wideports = false);
 
+// Parse a BLIF file from a writable buffer, the contents are modified.
+extern void parse_blif(RTLIL::Design *design, char *data, size_t size, IdString dff_name,
+		bool run_clean = false, bool sop_mode = false, bool wideports = false);
+
+// Parse a BLIF file by mapping it into memory, returns false if the file can't be opened.
+extern bool parse_blif_file(RTLIL::Design *design, const std::string &filename, IdString dff_name,
+		bool run_clean = false, bool sop_mode = false, bool wideports = false);
+
 YOSYS_NAMESPACE_END
 
 #endif
@@ -19,8 +19,70 @@
 
 #include "kernel/yosys.h"
 
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 YOSYS_NAMESPACE_BEGIN
 
+// Read the rest of a JSON string after the opening quote
+template<typename Reader>
+void json_read_string(Reader &f, string &str)
+{
+	str.clear();
+
+	while (1)
+	{
+		int ch = f.get();
+
+		if (ch == EOF)
+			log_error("Unexpected EOF in JSON string.\n");
+
+		if (ch == '"')
+			break;
+
+		if (ch == '\\') {
+			ch = f.get();
+
+			switch (ch) {
+				case EOF: log_error("Unexpected EOF in JSON string.\n"); break;
+				case '"':
+				case '/':
+				case '\\':           break;
+				case 'b': ch = '\b'; break;
+				case 'f': ch = '\f'; break;
+				case 'n': ch = '\n'; break;
+				case 'r': ch = '\r'; break;
+				case 't': ch = '\t'; break;
+				case 'u':
+					int val = 0;
+					for (int i = 0; i < 4; i++) {
+						ch = f.get();
+						val <<= 4;
+						if (ch >= '0' && '9' >= ch) {
+							val += ch - '0';
+						} else if (ch >= 'A' && 'F' >= ch) {
+							val += 10 + ch - 'A';
+						} else if (ch >= 'a' && 'f' >= ch) {
+							val += 10 + ch - 'a';
+						} else
+							log_error("Unexpected non-digit character in \\uXXXX sequence: %c.\n", ch);
+					}
+					if (val < 128)
+						ch = val;
+					else
+						log_error("Unsupported \\uXXXX sequence in JSON string: %04X.\n", val);
+					break;
+			}
+		}
+
+		str += ch;
+	}
+}
+
 struct JsonNode
 {
 	char type; // S=String, N=Number, A=Array, D=Dict
@@ -30,7 +92,10 @@ struct JsonNode
 	dict<string, JsonNode*> data_dict;
 	vector<string> data_dict_keys;
 
-	JsonNode(std::istream &f)
+	JsonNode(char type) : type(type), data_number(0) { }
+
+	template<typename Reader>
+	JsonNode(Reader &f)
 	{
 		type = 0;
 		data_number = 0;
@@ -48,55 +113,7 @@ struct JsonNode
 			if (ch == '"')
 			{
 				type = 'S';
-
-				while (1)
-				{
-					ch = f.get();
-
-					if (ch == EOF)
-						log_error("Unexpected EOF in JSON string.\n");
-
-					if (ch == '"')
-						break;
-
-					if (ch == '\\') {
-						ch = f.get();
-
-						switch (ch) {
-							case EOF: log_error("Unexpected EOF in JSON string.\n"); break;
-							case '"':
-							case '/':
-							case '\\':           break;
-							case 'b': ch = '\b'; break;
-							case 'f': ch = '\f'; break;
-							case 'n': ch = '\n'; break;
-							case 'r': ch = '\r'; break;
-							case 't': ch = '\t'; break;
-							case 'u':
-								int val = 0;
-								for (int i = 0; i < 4; i++) {
-									ch = f.get();
-									val <<= 4;
-									if (ch >= '0' && '9' >= ch) {
-										val += ch - '0';
-									} else if (ch >= 'A' && 'F' >= ch) {
-										val += 10 + ch - 'A';
-									} else if (ch >= 'a' && 'f' >= ch) {
-										val += 10 + ch - 'a';
-									} else
-										log_error("Unexpected non-digit character in \\uXXXX sequence: %c.\n", ch);
-								}
-								if (val < 128)
-									ch = val;
-								else
-									log_error("Unsupported \\uXXXX sequence in JSON string: %04X.\n", val);
-								break;
-						}
-					}
-
-					data_string += ch;
-				}
-
+				json_read_string(f, data_string);
 				break;
 			}
 
@@ -233,6 +250,15 @@ struct JsonNode
 		}
 	}
 
+	void set(const string &key, JsonNode *value)
+	{
+		auto it = data_dict.find(key);
+		if (it != data_dict.end())
+			delete it->second;
+		data_dict[key] = value;
+		data_dict_keys.push_back(key);
+	}
+
 	~JsonNode()
 	{
 		for (auto it : data_array)
@@ -287,7 +313,100 @@ void json_parse_attr_param(dict<IdString, Const> &results, JsonNode *node)
 	}
 }
 
-void json_import(Design *design, string &modname, JsonNode *node)
+// Signal bits of a port, netname or cell connection. Bit numbers are stored
+// as they are and constant bits as INT_MIN+State.
+typedef std::vector<int> JsonBits;
+
+static int json_const_bit(State state)
+{
+	return INT_MIN + int(state);
+}
+
+static bool json_bit_is_const(int bit)
+{
+	return bit <= json_const_bit(State::Sm);
+}
+
+static State json_bit_state(int bit)
+{
+	return State(bit - INT_MIN);
+}
+
+// Bit values of the JSON "bits" and connection arrays
+template<typename Error>
+int json_bit_value(const string &str, int i, Error error)
+{
+	if (str == "0")
+		return json_const_bit(State::S0);
+	if (str == "1")
+		return json_const_bit(State::S1);
+	if (str == "x")
+		return json_const_bit(State::Sx);
+	if (str == "z")
+		return json_const_bit(State::Sz);
+	log_error("JSON %s has invalid '%s' bit string value on bit %d.\n", error().c_str(), str.c_str(), i);
+}
+
+template<typename Error>
+void json_parse_bits(JsonBits &bits, JsonNode *node, Error error)
+{
+	bits.reserve(GetSize(node->data_array));
+	for (int i = 0; i < GetSize(node->data_array); i++)
+	{
+		JsonNode *bitval_node = node->data_array.at(i);
+
+		if (bitval_node->type == 'S')
+			bits.push_back(json_bit_value(bitval_node->data_string, i, error));
+		else if (bitval_node->type == 'N')
+			bits.push_back(bitval_node->data_number);
+		else
+			log_error("JSON %s has invalid bit value on bit %d.\n", error().c_str(), i);
+	}
+}
+
+// The contents of a module in the order in which they are imported. The bits
+// arrays, which make up most of a netlist, are kept as JsonBits and the other
+// members of the port, netname and cell dicts as JsonNode trees.
+struct JsonModule
+{
+	struct BitsItem {
+		IdString name;
+		JsonNode *node;
+		JsonBits bits;
+	};
+
+	struct CellItem {
+		IdString name;
+		JsonNode *node;
+		std::vector<std::pair<IdString, JsonBits>> connections;
+	};
+
+	// whether the JsonNode trees are owned by this object, they are not when
+	// the module was converted from a JsonNode tree of the whole file
+	bool owned = false;
+
+	JsonNode *attributes = nullptr;
+	JsonNode *memories = nullptr;
+	bool has_ports = false;
+	std::vector<BitsItem> ports, netnames;
+	std::vector<CellItem> cells;
+
+	~JsonModule()
+	{
+		if (!owned)
+			return;
+		delete attributes;
+		delete memories;
+		for (auto &it : ports)
+			delete it.node;
+		for (auto &it : netnames)
+			delete it.node;
+		for (auto &it : cells)
+			delete it.node;
+	}
+};
+
+void json_import(Design *design, const string &modname, JsonModule &data)
 {
 	log("Importing module %s from JSON tree.\n", modname.c_str());
 
@@ -299,45 +418,31 @@ void json_import(Design *design, string &modname, JsonNode *node)
 
 	design->add(module);
 
-	if (node->data_dict.count("attributes"))
-		json_parse_attr_param(module->attributes, node->data_dict.at("attributes"));
+	if (data.attributes)
+		json_parse_attr_param(module->attributes, data.attributes);
 
 	dict<int, SigBit> signal_bits;
 
-	if (node->data_dict.count("ports"))
+	if (data.has_ports)
 	{
-		JsonNode *ports_node = node->data_dict.at("ports");
-
-		if (ports_node->type != 'D')
-			log_error("JSON ports node is not a dictionary.\n");
-
-		for (int port_id = 1; port_id <= GetSize(ports_node->data_dict_keys); port_id++)
+		for (int port_id = 1; port_id <= GetSize(data.ports); port_id++)
 		{
-			IdString port_name = RTLIL::escape_id(ports_node->data_dict_keys[port_id-1].c_str());
-			JsonNode *port_node = ports_node->data_dict.at(ports_node->data_dict_keys[port_id-1]);
-
-			if (port_node->type != 'D')
-				log_error("JSON port node '%s' is not a dictionary.\n", log_id(port_name));
+			IdString port_name = data.ports[port_id-1].name;
+			JsonNode *port_node = data.ports[port_id-1].node;
+			const JsonBits &port_bits = data.ports[port_id-1].bits;
 
 			if (port_node->data_dict.count("direction") == 0)
 				log_error("JSON port node '%s' has no direction attribute.\n", log_id(port_name));
 
-			if (port_node->data_dict.count("bits") == 0)
-				log_error("JSON port node '%s' has no bits attribute.\n", log_id(port_name));
-
 			JsonNode *port_direction_node = port_node->data_dict.at("direction");
-			JsonNode *port_bits_node = port_node->data_dict.at("bits");
 
 			if (port_direction_node->type != 'S')
 				log_error("JSON port node '%s' has non-string direction attribute.\n", log_id(port_name));
 
-			if (port_bits_node->type != 'A')
-				log_error("JSON port node '%s' has non-array bits attribute.\n", log_id(port_name));
-
 			Wire *port_wire = module->wire(port_name);
 
 			if (port_wire == nullptr)
-				port_wire = module->addWire(port_name, GetSize(port_bits_node->data_array));
+				port_wire = module->addWire(port_name, GetSize(port_bits));
 
 			if (port_node->data_dict.count("upto") != 0) {
 				JsonNode *val = port_node->data_dict.at("upto");
@@ -371,44 +476,205 @@ void json_import(Design *design, string &modname, JsonNode *node)
 
 			port_wire->port_id = port_id;
 
-			for (int i = 0; i < GetSize(port_bits_node->data_array); i++)
+			for (int i = 0; i < GetSize(port_bits); i++)
 			{
-				JsonNode *bitval_node = port_bits_node->data_array.at(i);
 				SigBit sigbit(port_wire, i);
+				int bitidx = port_bits[i];
 
-				if (bitval_node->type == 'S') {
-					if (bitval_node->data_string == "0")
-						module->connect(sigbit, State::S0);
-					else if (bitval_node->data_string == "1")
-						module->connect(sigbit, State::S1);
-					else if (bitval_node->data_string == "x")
-						module->connect(sigbit, State::Sx);
-					else if (bitval_node->data_string == "z")
-						module->connect(sigbit, State::Sz);
-					else
-						log_error("JSON port node '%s' has invalid '%s' bit string value on bit %d.\n",
-								log_id(port_name), bitval_node->data_string.c_str(), i);
+				if (json_bit_is_const(bitidx)) {
+					module->connect(sigbit, json_bit_state(bitidx));
 				} else
-				if (bitval_node->type == 'N') {
-					int bitidx = bitval_node->data_number;
-					if (signal_bits.count(bitidx)) {
-						if (port_wire->port_output) {
-							module->connect(sigbit, signal_bits.at(bitidx));
-						} else {
-							module->connect(signal_bits.at(bitidx), sigbit);
-							signal_bits[bitidx] = sigbit;
-						}
+				if (signal_bits.count(bitidx)) {
+					if (port_wire->port_output) {
+						module->connect(sigbit, signal_bits.at(bitidx));
 					} else {
+						module->connect(signal_bits.at(bitidx), sigbit);
 						signal_bits[bitidx] = sigbit;
 					}
-				} else
-					log_error("JSON port node '%s' has invalid bit value on bit %d.\n", log_id(port_name), i);
+				} else {
+					signal_bits[bitidx] = sigbit;
+				}
 			}
 		}
 
 		module->fixup_ports();
 	}
 
+	for (auto &net : data.netnames)
+	{
+		IdString net_name = net.name;
+		JsonNode *net_node = net.node;
+
+		Wire *wire = module->wire(net_name);
+
+		if (wire == nullptr)
+			wire = module->addWire(net_name, GetSize(net.bits));
+
+		if (net_node->data_dict.count("upto") != 0) {
+			JsonNode *val = net_node->data_dict.at("upto");
+			if (val->type == 'N')
+				wire->upto = val->data_number != 0;
+		}
+
+		if (net_node->data_dict.count("offset") != 0) {
+			JsonNode *val = net_node->data_dict.at("offset");
+			if (val->type == 'N')
+				wire->start_offset = val->data_number;
+		}
+
+		for (int i = 0; i < GetSize(net.bits); i++)
+		{
+			SigBit sigbit(wire, i);
+			int bitidx = net.bits[i];
+
+			if (json_bit_is_const(bitidx)) {
+				module->connect(sigbit, json_bit_state(bitidx));
+			} else
+			if (signal_bits.count(bitidx)) {
+				if (sigbit != signal_bits.at(bitidx))
+					module->connect(sigbit, signal_bits.at(bitidx));
+			} else {
+				signal_bits[bitidx] = sigbit;
+			}
+		}
+
+		if (net_node->data_dict.count("attributes"))
+			json_parse_attr_param(wire->attributes, net_node->data_dict.at("attributes"));
+	}
+
+	for (auto &cell_item : data.cells)
+	{
+		IdString cell_name = cell_item.name;
+		JsonNode *cell_node = cell_item.node;
+
+		if (cell_node->data_dict.count("type") == 0)
+			log_error("JSON cells node '%s' has no type attribute.\n", log_id(cell_name));
+
+		JsonNode *type_node = cell_node->data_dict.at("type");
+
+		if (type_node->type != 'S')
+			log_error("JSON cells node '%s' has a non-string type.\n", log_id(cell_name));
+
+		IdString cell_type = RTLIL::escape_id(type_node->data_string.c_str());
+
+		Cell *cell = module->addCell(cell_name, cell_type);
+
+		for (auto &conn : cell_item.connections)
+		{
+			SigSpec sig;
+
+			for (int bitidx : conn.second)
+			{
+				if (json_bit_is_const(bitidx)) {
+					sig.append(json_bit_state(bitidx));
+				} else {
+					if (signal_bits.count(bitidx) == 0)
+						signal_bits[bitidx] = module->addWire(NEW_ID);
+					sig.append(signal_bits.at(bitidx));
+				}
+			}
+
+			cell->setPort(conn.first, sig);
+		}
+
+		if (cell_node->data_dict.count("attributes"))
+			json_parse_attr_param(cell->attributes, cell_node->data_dict.at("attributes"));
+
+		if (cell_node->data_dict.count("parameters"))
+			json_parse_attr_param(cell->parameters, cell_node->data_dict.at("parameters"));
+	}
+
+	if (data.memories)
+	{
+		JsonNode *memories_node = data.memories;
+
+		if (memories_node->type != 'D')
+			log_error("JSON memories node is not a dictionary.\n");
+
+		for (auto &memory_node_it : memories_node->data_dict)
+		{
+			IdString memory_name = RTLIL::escape_id(memory_node_it.first.c_str());
+			JsonNode *memory_node = memory_node_it.second;
+
+			RTLIL::Memory *mem = new RTLIL::Memory;
+			mem->name = memory_name;
+
+			if (memory_node->type != 'D')
+				log_error("JSON memory node '%s' is not a dictionary.\n", log_id(memory_name));
+
+			if (memory_node->data_dict.count("width") == 0)
+				log_error("JSON memory node '%s' has no width attribute.\n", log_id(memory_name));
+			JsonNode *width_node = memory_node->data_dict.at("width");
+			if (width_node->type != 'N')
+				log_error("JSON memory node '%s' has a non-number width.\n", log_id(memory_name));
+			mem->width = width_node->data_number;
+
+			if (memory_node->data_dict.count("size") == 0)
+				log_error("JSON memory node '%s' has no size attribute.\n", log_id(memory_name));
+			JsonNode *size_node = memory_node->data_dict.at("size");
+			if (size_node->type != 'N')
+				log_error("JSON memory node '%s' has a non-number size.\n", log_id(memory_name));
+			mem->size = size_node->data_number;
+
+			mem->start_offset = 0;
+			if (memory_node->data_dict.count("start_offset") != 0) {
+				JsonNode *val = memory_node->data_dict.at("start_offset");
+				if (val->type == 'N')
+					mem->start_offset = val->data_number;
+			}
+
+			if (memory_node->data_dict.count("attributes"))
+				json_parse_attr_param(mem->attributes, memory_node->data_dict.at("attributes"));
+
+			module->memories[mem->name] = mem;
+		}
+	}
+
+	// remove duplicates from connections array
+	pool<RTLIL::SigSig> unique_connections(module->connections_.begin(), module->connections_.end());
+	module->connections_ = std::vector<RTLIL::SigSig>(unique_connections.begin(), unique_connections.end());
+}
+
+// Convert the JsonNode tree of a module, netnames and cells are imported in the
+// iteration order of the dicts
+void json_import(Design *design, const string &modname, JsonNode *node)
+{
+	JsonModule data;
+
+	if (node->data_dict.count("attributes"))
+		data.attributes = node->data_dict.at("attributes");
+
+	if (node->data_dict.count("ports"))
+	{
+		JsonNode *ports_node = node->data_dict.at("ports");
+
+		if (ports_node->type != 'D')
+			log_error("JSON ports node is not a dictionary.\n");
+
+		data.has_ports = true;
+		for (auto &key : ports_node->data_dict_keys)
+		{
+			IdString port_name = RTLIL::escape_id(key.c_str());
+			JsonNode *port_node = ports_node->data_dict.at(key);
+
+			if (port_node->type != 'D')
+				log_error("JSON port node '%s' is not a dictionary.\n", log_id(port_name));
+
+			if (port_node->data_dict.count("bits") == 0)
+				log_error("JSON port node '%s' has no bits attribute.\n", log_id(port_name));
+
+			JsonNode *port_bits_node = port_node->data_dict.at("bits");
+
+			if (port_bits_node->type != 'A')
+				log_error("JSON port node '%s' has non-array bits attribute.\n", log_id(port_name));
+
+			data.ports.push_back({port_name, port_node, {}});
+			json_parse_bits(data.ports.back().bits, port_bits_node, [&]() {
+				return stringf("port node '%s'", log_id(port_name));
+			});
+		}
+	}
+
 	if (node->data_dict.count("netnames"))
 	{
 		JsonNode *netnames_node = node->data_dict.at("netnames");
@@ -432,55 +698,10 @@ void json_import(Design *design, string &modname, JsonNode *node)
 			if (bits_node->type != 'A')
 				log_error("JSON netname node '%s' has non-array bits attribute.\n", log_id(net_name));
 
-			Wire *wire = module->wire(net_name);
-
-			if (wire == nullptr)
-				wire = module->addWire(net_name, GetSize(bits_node->data_array));
-
-			if (net_node->data_dict.count("upto") != 0) {
-				JsonNode *val = net_node->data_dict.at("upto");
-				if (val->type == 'N')
-					wire->upto = val->data_number != 0;
-			}
-
-			if (net_node->data_dict.count("offset") != 0) {
-				JsonNode *val = net_node->data_dict.at("offset");
-				if (val->type == 'N')
-					wire->start_offset = val->data_number;
-			}
-
-			for (int i = 0; i < GetSize(bits_node->data_array); i++)
-			{
-				JsonNode *bitval_node = bits_node->data_array.at(i);
-				SigBit sigbit(wire, i);
-
-				if (bitval_node->type == 'S') {
-					if (bitval_node->data_string == "0")
-						module->connect(sigbit, State::S0);
-					else if (bitval_node->data_string == "1")
-						module->connect(sigbit, State::S1);
-					else if (bitval_node->data_string == "x")
-						module->connect(sigbit, State::Sx);
-					else if (bitval_node->data_string == "z")
-						module->connect(sigbit, State::Sz);
-					else
-						log_error("JSON netname node '%s' has invalid '%s' bit string value on bit %d.\n",
-								log_id(net_name), bitval_node->data_string.c_str(), i);
-				} else
-				if (bitval_node->type == 'N') {
-					int bitidx = bitval_node->data_number;
-					if (signal_bits.count(bitidx)) {
-						if (sigbit != signal_bits.at(bitidx))
-							module->connect(sigbit, signal_bits.at(bitidx));
-					} else {
-						signal_bits[bitidx] = sigbit;
-					}
-				} else
-					log_error("JSON netname node '%s' has invalid bit value on bit %d.\n", log_id(net_name), i);
-			}
-
-			if (net_node->data_dict.count("attributes"))
-				json_parse_attr_param(wire->attributes, net_node->data_dict.at("attributes"));
+			data.netnames.push_back({net_name, net_node, {}});
+			json_parse_bits(data.netnames.back().bits, bits_node, [&]() {
+				return stringf("netname node '%s'", log_id(net_name));
+			});
 		}
 	}
 
@@ -499,18 +720,6 @@ void json_import(Design *design, string &modname, JsonNode *node)
 			if (cell_node->type != 'D')
 				log_error("JSON cells node '%s' is not a dictionary.\n", log_id(cell_name));
 
-			if (cell_node->data_dict.count("type") == 0)
-				log_error("JSON cells node '%s' has no type attribute.\n", log_id(cell_name));
-
-			JsonNode *type_node = cell_node->data_dict.at("type");
-
-			if (type_node->type != 'S')
-				log_error("JSON cells node '%s' has a non-string type.\n", log_id(cell_name));
-
-			IdString cell_type = RTLIL::escape_id(type_node->data_string.c_str());
-
-			Cell *cell = module->addCell(cell_name, cell_type);
-
 			if (cell_node->data_dict.count("connections") == 0)
 				log_error("JSON cells node '%s' has no connections attribute.\n", log_id(cell_name));
 
@@ -519,6 +728,9 @@ void json_import(Design *design, string &modname, JsonNode *node)
 			if (connections_node->type != 'D')
 				log_error("JSON cells node '%s' has non-dictionary connections attribute.\n", log_id(cell_name));
 
+			data.cells.push_back({cell_name, cell_node, {}});
+			auto &connections = data.cells.back().connections;
+
 			for (auto &conn_it : connections_node->data_dict)
 			{
 				IdString conn_name = RTLIL::escape_id(conn_it.first.c_str());
@@ -527,97 +739,340 @@ void json_import(Design *design, string &modname, JsonNode *node)
 				if (conn_node->type != 'A')
 					log_error("JSON cells node '%s' connection '%s' is not an array.\n", log_id(cell_name), log_id(conn_name));
 
-				SigSpec sig;
+				connections.push_back({conn_name, {}});
+				json_parse_bits(connections.back().second, conn_node, [&]() {
+					return stringf("cells node '%s' connection '%s'", log_id(cell_name), log_id(conn_name));
+				});
+			}
+		}
+	}
 
-				for (int i = 0; i < GetSize(conn_node->data_array); i++)
-				{
-					JsonNode *bitval_node = conn_node->data_array.at(i);
-
-					if (bitval_node->type == 'S') {
-						if (bitval_node->data_string == "0")
-							sig.append(State::S0);
-						else if (bitval_node->data_string == "1")
-							sig.append(State::S1);
-						else if (bitval_node->data_string == "x")
-							sig.append(State::Sx);
-						else if (bitval_node->data_string == "z")
-							sig.append(State::Sz);
-						else
-							log_error("JSON cells node '%s' connection '%s' has invalid '%s' bit string value on bit %d.\n",
-									log_id(cell_name), log_id(conn_name), bitval_node->data_string.c_str(), i);
-					} else
-					if (bitval_node->type == 'N') {
-						int bitidx = bitval_node->data_number;
-						if (signal_bits.count(bitidx) == 0)
-							signal_bits[bitidx] = module->addWire(NEW_ID);
-						sig.append(signal_bits.at(bitidx));
-					} else
-						log_error("JSON cells node '%s' connection '%s' has invalid bit value on bit %d.\n",
-								log_id(cell_name), log_id(conn_name), i);
+	if (node->data_dict.count("memories"))
+		data.memories = node->data_dict.at("memories");
 
-				}
+	json_import(design, modname, data);
+}
 
-				cell->setPort(conn_name, sig);
-			}
+// Buffered input for the streaming parser, reading from a std::istream in
+// large chunks or directly from a memory mapped file
+struct JsonReader
+{
+	std::istream *f = nullptr;
+	std::vector<char> buffer;
+	const char *ptr = nullptr, *end = nullptr;
 
-			if (cell_node->data_dict.count("attributes"))
-				json_parse_attr_param(cell->attributes, cell_node->data_dict.at("attributes"));
+	JsonReader(std::istream *f) : f(f), buffer(1 << 20) { }
+	JsonReader(const char *data, size_t size) : ptr(data), end(data + size) { }
 
-			if (cell_node->data_dict.count("parameters"))
-				json_parse_attr_param(cell->parameters, cell_node->data_dict.at("parameters"));
+	int get()
+	{
+		if (ptr == end) {
+			if (f == nullptr || f->eof())
+				return EOF;
+			f->read(buffer.data(), buffer.size());
+			if (f->gcount() == 0)
+				return EOF;
+			ptr = buffer.data();
+			end = ptr + f->gcount();
 		}
+		return (unsigned char)*ptr++;
 	}
 
-	if (node->data_dict.count("memories"))
+	// only valid directly after get() returned a character
+	void unget()
 	{
-		JsonNode *memories_node = node->data_dict.at("memories");
+		ptr--;
+	}
+};
 
-		if (memories_node->type != 'D')
-			log_error("JSON memories node is not a dictionary.\n");
+// Streaming parser: the modules are imported one by one while reading the file,
+// so only the contents of the module being read are kept in memory, and as
+// JsonBits instead of JsonNode trees. The modules are imported in the order of
+// the file, everything within a module in the same order as with the JsonNode
+// tree of the whole file.
+struct JsonStreamParser
+{
+	JsonReader &f;
+	Design *design;
+	string key;
+	dict<string, IdString> id_cache;
 
-		for (auto &memory_node_it : memories_node->data_dict)
+	JsonStreamParser(JsonReader &f, Design *design) : f(f), design(design) { }
+
+	int next()
+	{
+		int ch;
+		do ch = f.get();
+		while (ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n');
+		return ch;
+	}
+
+	// Returns false if the next value is not a dict. Otherwise the opening
+	// brace is consumed and the members can be read with next_key().
+	bool begin_dict()
+	{
+		int ch = next();
+		if (ch == '{')
+			return true;
+		if (ch != EOF)
+			f.unget();
+		return false;
+	}
+
+	bool next_key(string &str)
+	{
+		int ch = next();
+		while (ch == ',')
+			ch = next();
+		if (ch == EOF)
+			log_error("Unexpected EOF in JSON file.\n");
+		if (ch == '}')
+			return false;
+		if (ch != '"')
+			log_error("Unexpected non-string key in JSON dict.\n");
+		json_read_string(f, str);
+		ch = next();
+		if (ch != ':')
+			f.unget();
+		return true;
+	}
+
+	// Port and cell connection names and cell types repeat a lot, escape
+	// them only once
+	IdString id(const string &str)
+	{
+		auto it = id_cache.find(str);
+		if (it != id_cache.end())
+			return it->second;
+		IdString name = RTLIL::escape_id(str.c_str());
+		id_cache[str] = name;
+		return name;
+	}
+
+	template<typename Error>
+	bool read_bits(JsonBits &bits, Error error)
+	{
+		if (next() != '[') {
+			f.unget();
+			return false;
+		}
+
+		string str;
+		for (int i = 0;; i++)
 		{
-			IdString memory_name = RTLIL::escape_id(memory_node_it.first.c_str());
-			JsonNode *memory_node = memory_node_it.second;
+			int ch = next();
+			while (ch == ',')
+				ch = next();
 
-			RTLIL::Memory *mem = new RTLIL::Memory;
-			mem->name = memory_name;
+			if (ch == EOF)
+				log_error("Unexpected EOF in JSON file.\n");
 
-			if (memory_node->type != 'D')
-				log_error("JSON memory node '%s' is not a dictionary.\n", log_id(memory_name));
+			if (ch == ']')
+				break;
 
-			if (memory_node->data_dict.count("width") == 0)
-				log_error("JSON memory node '%s' has no width attribute.\n", log_id(memory_name));
-			JsonNode *width_node = memory_node->data_dict.at("width");
-			if (width_node->type != 'N')
-				log_error("JSON memory node '%s' has a non-number width.\n", log_id(memory_name));
-			mem->width = width_node->data_number;
+			if (ch == '"') {
+				json_read_string(f, str);
+				bits.push_back(json_bit_value(str, i, error));
+				continue;
+			}
 
-			if (memory_node->data_dict.count("size") == 0)
-				log_error("JSON memory node '%s' has no size attribute.\n", log_id(memory_name));
-			JsonNode *size_node = memory_node->data_dict.at("size");
-			if (size_node->type != 'N')
-				log_error("JSON memory node '%s' has a non-number size.\n", log_id(memory_name));
-			mem->size = size_node->data_number;
+			if ('0' <= ch && ch <= '9') {
+				int64_t bitidx = ch - '0';
+				while (1) {
+					ch = f.get();
+					if (ch < '0' || '9' < ch)
+						break;
+					bitidx = bitidx*10 + (ch - '0');
+				}
+				if (ch == '.')
+					log_error("JSON %s has invalid bit value on bit %d.\n", error().c_str(), i);
+				if (ch != EOF)
+					f.unget();
+				bits.push_back(bitidx);
+				continue;
+			}
 
-			mem->start_offset = 0;
-			if (memory_node->data_dict.count("start_offset") != 0) {
-				JsonNode *val = memory_node->data_dict.at("start_offset");
-				if (val->type == 'N')
-					mem->start_offset = val->data_number;
+			f.unget();
+			JsonNode bitval_node(f);
+			if (bitval_node.type != 'N')
+				log_error("JSON %s has invalid bit value on bit %d.\n", error().c_str(), i);
+			bits.push_back(bitval_node.data_number);
+		}
+
+		return true;
+	}
+
+	JsonModule::BitsItem read_bits_item(const char *kind)
+	{
+		JsonModule::BitsItem item;
+		item.name = RTLIL::escape_id(key.c_str());
+		item.node = new JsonNode('D');
+		IdString name = item.name;
+
+		if (!begin_dict())
+			log_error("JSON %s node '%s' is not a dictionary.\n", kind, log_id(name));
+
+		bool has_bits = false;
+		string member;
+		while (next_key(member)) {
+			if (member == "bits") {
+				if (!read_bits(item.bits, [&]() { return stringf("%s node '%s'", kind, log_id(name)); }))
+					log_error("JSON %s node '%s' has non-array bits attribute.\n", kind, log_id(name));
+				has_bits = true;
+			} else
+				item.node->set(member, new JsonNode(f));
+		}
+
+		if (!has_bits)
+			log_error("JSON %s node '%s' has no bits attribute.\n", kind, log_id(name));
+		return item;
+	}
+
+	JsonModule::CellItem read_cell_item()
+	{
+		JsonModule::CellItem item;
+		item.name = RTLIL::escape_id(key.c_str());
+		item.node = new JsonNode('D');
+		IdString cell_name = item.name;
+
+		if (!begin_dict())
+			log_error("JSON cells node '%s' is not a dictionary.\n", log_id(cell_name));
+
+		bool has_connections = false;
+		string member;
+		while (next_key(member)) {
+			if (member == "connections") {
+				if (!begin_dict())
+					log_error("JSON cells node '%s' has non-dictionary connections attribute.\n", log_id(cell_name));
+				has_connections = true;
+				while (next_key(member)) {
+					IdString conn_name = id(member);
+					item.connections.push_back({conn_name, {}});
+					if (!read_bits(item.connections.back().second, [&]() {
+							return stringf("cells node '%s' connection '%s'", log_id(cell_name), log_id(conn_name)); }))
+						log_error("JSON cells node '%s' connection '%s' is not an array.\n", log_id(cell_name), log_id(conn_name));
+				}
+			} else if (member == "type") {
+				JsonNode *type_node = new JsonNode(f);
+				if (type_node->type == 'S')
+					type_node->data_string = id(type_node->data_string).str();
+				item.node->set(member, type_node);
+			} else
+				item.node->set(member, new JsonNode(f));
+		}
+
+		if (!has_connections)
+			log_error("JSON cells node '%s' has no connections attribute.\n", log_id(cell_name));
+
+		// same order as iterating over the dict of a JsonNode tree
+		std::reverse(item.connections.begin(), item.connections.end());
+		return item;
+	}
+
+	void read_module(const string &modname)
+	{
+		JsonModule data;
+		data.owned = true;
+
+		if (!begin_dict())
+			log_error("JSON module node '%s' is not a dictionary.\n", modname.c_str());
+
+		while (next_key(key))
+		{
+			if (key == "attributes") {
+				delete data.attributes;
+				data.attributes = new JsonNode(f);
+			} else
+			if (key == "memories") {
+				delete data.memories;
+				data.memories = new JsonNode(f);
+			} else
+			if (key == "ports") {
+				if (!begin_dict())
+					log_error("JSON ports node is not a dictionary.\n");
+				data.has_ports = true;
+				while (next_key(key))
+					data.ports.push_back(read_bits_item("port"));
+			} else
+			if (key == "netnames") {
+				if (!begin_dict())
+					log_error("JSON netnames node is not a dictionary.\n");
+				while (next_key(key))
+					data.netnames.push_back(read_bits_item("netname"));
+			} else
+			if (key == "cells") {
+				if (!begin_dict())
+					log_error("JSON cells node is not a dictionary.\n");
+				while (next_key(key))
+					data.cells.push_back(read_cell_item());
+			} else
+				delete new JsonNode(f);
+		}
+
+		std::reverse(data.netnames.begin(), data.netnames.end());
+		std::reverse(data.cells.begin(), data.cells.end());
+		json_import(design, modname, data);
+	}
+
+	void run()
+	{
+		if (!begin_dict())
+			log_error("JSON root node is not a dictionary.\n");
+
+		while (next_key(key))
+		{
+			if (key != "modules") {
+				delete new JsonNode(f);
+				continue;
 			}
 
-			if (memory_node->data_dict.count("attributes"))
-				json_parse_attr_param(mem->attributes, memory_node->data_dict.at("attributes"));
+			if (!begin_dict())
+				log_error("JSON modules node is not a dictionary.\n");
 
-			module->memories[mem->name] = mem;
+			string modname;
+			while (next_key(modname))
+				read_module(modname);
 		}
 	}
+};
 
-	// remove duplicates from connections array
-	pool<RTLIL::SigSig> unique_connections(module->connections_.begin(), module->connections_.end());
-	module->connections_ = std::vector<RTLIL::SigSig>(unique_connections.begin(), unique_connections.end());
-}
+#ifndef _WIN32
+// A read-only memory mapping of a regular, uncompressed file
+struct JsonMappedFile
+{
+	void *data = MAP_FAILED;
+	size_t size = 0;
+
+	JsonMappedFile(const string &filename)
+	{
+		int fd = open(filename.c_str(), O_RDONLY);
+		if (fd < 0)
+			return;
+		struct stat st;
+		if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+			size = st.st_size;
+			data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		}
+		close(fd);
+		if (data == MAP_FAILED)
+			return;
+		madvise(data, size, MADV_SEQUENTIAL);
+		const unsigned char *bytes = (const unsigned char *)data;
+		if (size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b) {
+			munmap(data, size);
+			data = MAP_FAILED;
+		}
+	}
+
+	bool ok() const { return data != MAP_FAILED; }
+
+	~JsonMappedFile()
+	{
+		if (ok())
+			munmap(data, size);
+	}
+};
+#endif
 
 struct JsonFrontend : public Frontend {
 	JsonFrontend() : Frontend("json", "read JSON file") { }
@@ -625,27 +1080,63 @@ struct JsonFrontend : public Frontend {
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
 		log("\n");
-		log("    read_json [filename]\n");
+		log("    read_json [options] [filename]\n");
 		log("\n");
 		log("Load modules from a JSON file into the current design See \"help write_json\"\n");
 		log("for a description of the file format.\n");
 		log("\n");
+		log("    -stream\n");
+		log("        import each module while reading the file, instead of reading the\n");
+		log("        whole file into memory first. This needs a fraction of the memory\n");
+		log("        for large netlists. The modules are added to the design in the order\n");
+		log("        of the file, the resulting modules are the same.\n");
+		log("\n");
+		log("    -mmap\n");
+		log("        like -stream, but map the file into memory instead of reading it.\n");
+		log("        Compressed files and standard input are read as with -stream.\n");
+		log("\n");
 	}
 	void execute(std::istream *&f, std::string filename, std::vector<std::string> args, RTLIL::Design *design) override
 	{
+		bool flag_stream = false;
+		bool flag_mmap = false;
+
 		log_header(design, "Executing JSON frontend.\n");
 
 		size_t argidx;
 		for (argidx = 1; argidx < args.size(); argidx++) {
-			// std::string arg = args[argidx];
-			// if (arg == "-sop") {
-			// 	sop_mode = true;
-			// 	continue;
-			// }
+			std::string arg = args[argidx];
+			if (arg == "-stream") {
+				flag_stream = true;
+				continue;
+			}
+			if (arg == "-mmap") {
+				flag_stream = true;
+				flag_mmap = true;
+				continue;
+			}
 			break;
 		}
 		extra_args(f, filename, args, argidx);
 
+		if (flag_mmap) {
+#ifndef _WIN32
+			JsonMappedFile mapped(filename);
+			if (mapped.ok()) {
+				JsonReader reader((const char *)mapped.data, mapped.size);
+				JsonStreamParser(reader, design).run();
+				return;
+			}
+#endif
+			log("Can't map `%s' into memory, reading it as a stream.\n", filename.c_str());
+		}
+
+		if (flag_stream) {
+			JsonReader reader(f);
+			JsonStreamParser(reader, design).run();
+			return;
+		}
+
 		JsonNode root(*f);
 
 		if (root.type != 'D')
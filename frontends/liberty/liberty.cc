@@ -488,6 +488,12 @@ struct LibertyFrontend : public Frontend {
 		log("    -setattr <attribute_name>\n");
 		log("        set the specified attribute (to the value 1) on all loaded modules\n");
 		log("\n");
+		log("A liberty file that was already parsed by read_liberty, dfflibmap or stat is\n");
+		log("not parsed again for the same design unless it has changed. The parsed file\n");
+		log("is freed with the design or by 'design -reset'. When the scratchpad variable\n");
+		log("liberty.cache_dir is set, the parsed file is also stored in that directory\n");
+		log("and loaded from there by later runs (see 'help scratchpad').\n");
+		log("\n");
 	}
 	void execute(std::istream *&f, std::string filename, std::vector<std::string> args, RTLIL::Design *design) override
 	{
@@ -546,13 +552,23 @@ struct LibertyFrontend : public Frontend {
 
 		log_header(design, "Executing Liberty frontend: %s\n", filename.c_str());
 
-		LibertyParser parser(*f);
+		// plain files go through the cache of parsed liberty files, compressed
+		// files and here documents are parsed from the stream
+		std::shared_ptr<LibertyAst> libast;
+		if (dynamic_cast<std::ifstream*>(f) != nullptr)
+			libast = LibertyCache::load(design, filename);
+		if (libast == nullptr) {
+			LibertyParser parser(*f);
+			libast.reset(parser.ast != nullptr ? parser.ast : new LibertyAst);
+			parser.ast = nullptr;
+		}
+
 		int cell_count = 0;
 
 		std::map<std::string, std::tuple<int, int, bool>> global_type_map;
-		parse_type_map(global_type_map, parser.ast);
+		parse_type_map(global_type_map, libast.get());
 
-		for (auto cell : parser.ast->children)
+		for (auto cell : libast->children)
 		{
 			if (cell->id != "cell" || cell->args.size() != 1)
 				continue;
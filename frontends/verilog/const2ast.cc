@@ -245,4 +245,9 @@ AstNode *VERILOG_FRONTEND::const2ast(std::string code, char case_type, bool warn
 	return NULL;
 }
 
+void VERILOG_FRONTEND::digits2bits(std::vector<RTLIL::State> &data, const char *digits, int len_in_bits, int base)
+{
+	my_strtobin(data, digits, len_in_bits, base, 0, false);
+}
+
 YOSYS_NAMESPACE_END
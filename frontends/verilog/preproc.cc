@@ -44,41 +44,48 @@
 YOSYS_NAMESPACE_BEGIN
 using namespace VERILOG_FRONTEND;
 
-static std::list<std::string> output_code;
-static std::list<std::string> input_buffer;
-static size_t input_buffer_charp;
+// The input is a stack of buffers, each with a read cursor. The top of the
+// stack (the back of the vector) is read first, so inserting a macro body or
+// an included file pushes a new buffer without copying the rest of the input.
+// All output is appended to a single string.
+struct input_buffer_t {
+	std::string text;
+	size_t pos;
+};
+
+static std::string output_code;
+static std::vector<input_buffer_t> input_buffers;
 
 static void return_char(char ch)
 {
-	if (input_buffer_charp == 0)
-		input_buffer.push_front(std::string() + ch);
+	if (input_buffers.empty() || input_buffers.back().pos == 0)
+		input_buffers.push_back({std::string(1, ch), 0});
 	else
-		input_buffer.front()[--input_buffer_charp] = ch;
+		input_buffers.back().text[--input_buffers.back().pos] = ch;
 }
 
 static void insert_input(std::string str)
 {
-	if (input_buffer_charp != 0) {
-		input_buffer.front() = input_buffer.front().substr(input_buffer_charp);
-		input_buffer_charp = 0;
-	}
-	input_buffer.push_front(str);
+	if (!str.empty())
+		input_buffers.push_back({std::move(str), 0});
+}
+
+static bool input_empty()
+{
+	while (!input_buffers.empty() && input_buffers.back().pos == input_buffers.back().text.size())
+		input_buffers.pop_back();
+	return input_buffers.empty();
 }
 
 static char next_char()
 {
-	if (input_buffer.empty())
-		return 0;
-
-	log_assert(input_buffer_charp <= input_buffer.front().size());
-	if (input_buffer_charp == input_buffer.front().size()) {
-		input_buffer_charp = 0;
-		input_buffer.pop_front();
-		return next_char();
+	while (!input_empty()) {
+		input_buffer_t &buf = input_buffers.back();
+		char ch = buf.text[buf.pos++];
+		if (ch != '\r')
+			return ch;
 	}
-
-	char ch = input_buffer.front()[input_buffer_charp++];
-	return ch == '\r' ? next_char() : ch;
+	return 0;
 }
 
 static std::string skip_spaces()
@@ -108,7 +115,7 @@ static std::string next_token(bool pass_newline = false)
 	token += ch;
 	if (ch == '\n') {
 		if (pass_newline) {
-			output_code.push_back(token);
+			output_code += token;
 			return "";
 		}
 		return token;
@@ -343,11 +350,13 @@ void
 define_map_t::add(const std::string &name, const std::string &txt, const arg_map_t *args)
 {
 	defines[name] = std::unique_ptr<define_body_t>(new define_body_t(txt, args));
+	generation++;
 }
 
 void define_map_t::add(const std::string &name, const define_body_t &body)
 {
 	defines[name] = std::unique_ptr<define_body_t>(new define_body_t(body));
+	generation++;
 }
 
 void define_map_t::merge(const define_map_t &map)
@@ -357,6 +366,7 @@ void define_map_t::merge(const define_map_t &map)
 		// map.defines.
 		defines[pr.first] = std::unique_ptr<define_body_t>(new define_body_t(*pr.second));
 	}
+	generation++;
 }
 
 const define_body_t *define_map_t::find(const std::string &name) const
@@ -368,11 +378,13 @@ const define_body_t *define_map_t::find(const std::string &name) const
 void define_map_t::erase(const std::string &name)
 {
 	defines.erase(name);
+	generation++;
 }
 
 void define_map_t::clear()
 {
 	defines.clear();
+	generation++;
 }
 
 void define_map_t::log() const
@@ -387,18 +399,16 @@ void define_map_t::log() const
 
 static void input_file(std::istream &f, std::string filename)
 {
-	char buffer[513];
+	char buffer[65536];
 	int rc;
 
-	insert_input("");
-	auto it = input_buffer.begin();
+	std::string text;
+	while ((rc = readsome(f, buffer, sizeof(buffer))) > 0)
+		text.append(buffer, rc);
 
-	input_buffer.insert(it, "`file_push \"" + filename + "\"\n");
-	while ((rc = readsome(f, buffer, sizeof(buffer)-1)) > 0) {
-		buffer[rc] = 0;
-		input_buffer.insert(it, buffer);
-	}
-	input_buffer.insert(it, "\n`file_pop\n");
+	insert_input("\n`file_pop\n");
+	insert_input(std::move(text));
+	insert_input("`file_push \"" + filename + "\"\n");
 }
 
 // Read tokens to get one argument (either a macro argument at a callsite or a default argument in a
@@ -471,7 +481,7 @@ static bool try_expand_macro(define_map_t &defines, macro_arg_stack_t &macro_arg
 	if (tok == "`\"") {
 		std::string literal("\"");
 		// Expand string literal
-		while (!input_buffer.empty()) {
+		while (!input_empty()) {
 			std::string ntok = next_token();
 			if (ntok == "`\"") {
 				insert_input(literal+"\"");
@@ -770,12 +780,11 @@ frontend_verilog_preproc(std::istream                 &f,
 	bool ifdef_already_satisfied = false;
 
 	output_code.clear();
-	input_buffer.clear();
-	input_buffer_charp = 0;
+	input_buffers.clear();
 
 	input_file(f, filename);
 
-	while (!input_buffer.empty())
+	while (!input_empty())
 	{
 		std::string tok = next_token();
 		// printf("token: >>%s<<\n", tok != "\n" ? tok.c_str() : "NEWLINE");
@@ -852,7 +861,7 @@ frontend_verilog_preproc(std::istream                 &f,
 
 		if (ifdef_fail_level > 0) {
 			if (tok == "\n")
-				output_code.push_back(tok);
+				output_code += tok;
 			continue;
 		}
 
@@ -910,7 +919,7 @@ frontend_verilog_preproc(std::istream                 &f,
 				}
 			}
 			if (ff.fail()) {
-				output_code.push_back("`file_notfound " + fn);
+				output_code += "`file_notfound " + fn;
 			} else {
 				input_file(ff, fixed_fn);
 				yosys_input_files.insert(fixed_fn);
@@ -923,14 +932,14 @@ frontend_verilog_preproc(std::istream                 &f,
 			std::string fn = next_token(true);
 			if (!fn.empty() && fn.front() == '"' && fn.back() == '"')
 				fn = fn.substr(1, fn.size()-2);
-			output_code.push_back(tok + " \"" + fn + "\"");
+			output_code += tok + " \"" + fn + "\"";
 			filename_stack.push_back(filename);
 			filename = fn;
 			continue;
 		}
 
 		if (tok == "`file_pop") {
-			output_code.push_back(tok);
+			output_code += tok;
 			filename = filename_stack.back();
 			filename_stack.pop_back();
 			continue;
@@ -979,7 +988,7 @@ frontend_verilog_preproc(std::istream                 &f,
 		if (try_expand_macro(defines, macro_arg_stack, tok))
 			continue;
 
-		output_code.push_back(tok);
+		output_code += tok;
 	}
 
 	if (ifdef_fail_level > 0 || ifdef_pass_level > 0) {
@@ -987,12 +996,8 @@ frontend_verilog_preproc(std::istream                 &f,
 	}
 
 	std::string output;
-	for (auto &str : output_code)
-		output += str;
-
-	output_code.clear();
-	input_buffer.clear();
-	input_buffer_charp = 0;
+	output.swap(output_code);
+	input_buffers.clear();
 
 	return output;
 }
@@ -61,6 +61,10 @@ struct define_map_t
 	void log() const;
 
 	std::map<std::string, std::unique_ptr<define_body_t>> defines;
+
+	// Incremented on every change, so callers can tell whether a map was
+	// modified (e.g. by a `define in a preprocessed file).
+	int generation = 0;
 };
 
 
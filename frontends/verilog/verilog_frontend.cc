@@ -40,6 +40,112 @@ using namespace VERILOG_FRONTEND;
 static std::vector<std::string> verilog_defaults;
 static std::list<std::vector<std::string>> verilog_defaults_stack;
 
+// The remaining files of a read_verilog command, preprocessed ahead of time
+// by -j worker processes, in command line order. The results are only used
+// as long as the global defines are unchanged since they were created. The
+// files included by a prefetched file are added to yosys_input_files when
+// the file is used.
+struct preproc_prefetch_t {
+	std::string filename, code;
+	std::vector<std::string> input_files;
+	bool available = false, changes_defines = false;
+};
+static std::deque<preproc_prefetch_t> preproc_prefetch;
+static std::vector<std::string> preproc_prefetch_args;
+static int preproc_prefetch_generation;
+
+static void prefetch_preproc(const std::vector<std::string> &filenames, const define_map_t &defines_map,
+		RTLIL::Design *design, const std::list<std::string> &include_dirs, int num_jobs)
+{
+	int num_workers = std::min(num_jobs, GetSize(filenames));
+	log("Preprocessing %d more file(s) with %d worker process(es).\n", GetSize(filenames), num_workers);
+
+	// Each file is preprocessed with the global defines as they are now. The
+	// result is "<index> <changes defines> <number of includes> <size>\n",
+	// one line per included file and the code. A file that logs anything,
+	// e.g. a warning, is left out and preprocessed again in order, so that
+	// its messages appear where they belong.
+	std::vector<bool> failed;
+	std::vector<std::string> results = run_worker_processes(num_workers, [&](int w) {
+		std::string result;
+		define_map_t base_defines;
+		base_defines.merge(*design->verilog_defines);
+		for (int i = w; i < GetSize(filenames); i += num_workers) {
+			if (filenames[i].size() > 3 && filenames[i].compare(filenames[i].size()-3, std::string::npos, ".gz") == 0)
+				continue;
+			std::ifstream f(filenames[i]);
+			if (f.fail())
+				continue;
+			define_map_t global_defines;
+			global_defines.merge(base_defines);
+			int generation = global_defines.generation;
+
+			std::stringstream log_buffer;
+			std::vector<FILE*> saved_log_files;
+			std::vector<std::ostream*> saved_log_streams;
+			std::set<std::string> saved_input_files;
+			saved_log_files.swap(log_files);
+			saved_log_streams.swap(log_streams);
+			saved_input_files.swap(yosys_input_files);
+			log_streams.push_back(&log_buffer);
+
+			std::set<std::string> input_files;
+			auto restore = [&]() {
+				input_files.swap(yosys_input_files);
+				yosys_input_files.swap(saved_input_files);
+				yosys_input_files.insert(input_files.begin(), input_files.end());
+				log_files.swap(saved_log_files);
+				log_streams.swap(saved_log_streams);
+			};
+
+			std::string code;
+			try {
+				code = frontend_verilog_preproc(f, filenames[i], defines_map, global_defines, include_dirs);
+			} catch (...) {
+				restore();
+				throw;
+			}
+			restore();
+
+			if (!log_buffer.str().empty())
+				continue;
+			result += stringf("%d %d %d %zu\n", i, global_defines.generation != generation, GetSize(input_files), code.size());
+			for (auto &fn : input_files)
+				result += fn + "\n";
+			result += code;
+		}
+		return result;
+	}, &failed);
+
+	preproc_prefetch.clear();
+	preproc_prefetch.resize(GetSize(filenames));
+	for (int i = 0; i < GetSize(filenames); i++)
+		preproc_prefetch[i].filename = filenames[i];
+
+	for (auto &result : results) {
+		size_t pos = 0;
+		while (pos < result.size()) {
+			int index, changes_defines, num_input_files;
+			size_t size, eol = result.find('\n', pos);
+			if (eol == std::string::npos || sscanf(result.c_str() + pos, "%d %d %d %zu", &index, &changes_defines, &num_input_files, &size) != 4)
+				log_error("Unexpected result from preprocessor worker process.\n");
+			auto &entry = preproc_prefetch.at(index);
+			for (int j = 0; j < num_input_files; j++) {
+				pos = eol + 1;
+				eol = result.find('\n', pos);
+				if (eol == std::string::npos)
+					log_error("Unexpected result from preprocessor worker process.\n");
+				entry.input_files.push_back(result.substr(pos, eol - pos));
+			}
+			entry.code = result.substr(eol + 1, size);
+			entry.available = true;
+			entry.changes_defines = changes_defines != 0;
+			pos = eol + 1 + size;
+		}
+	}
+	preproc_prefetch_generation = design->verilog_defines->generation;
+}
+
 static void error_on_dpi_function(AST::AstNode *node)
 {
 	if (node->type == AST::AST_DPI_FUNCTION)
@@ -165,6 +271,17 @@ struct VerilogFrontend : public Frontend {
 		log("    -nopp\n");
 		log("        do not run the pre-processor\n");
 		log("\n");
+		log("    -j <N>\n");
+		log("        when reading multiple files, run the pre-processor on the files that\n");
+		log("        follow the current one in up to N parallel worker processes (0 for\n");
+		log("        the number of CPUs). The files are still parsed and added to the\n");
+		log("        design in command line order, and a file is pre-processed again in\n");
+		log("        order if an earlier file changed the defines (e.g. with `define), so\n");
+		log("        the result is the same as without -j. A file whose pre-processing\n");
+		log("        logs a message (e.g. a warning) is also pre-processed again in order,\n");
+		log("        and the files included by prefetched files are still recorded for\n");
+		log("        the -E dependencies file.\n");
+		log("\n");
 		log("    -nodpi\n");
 		log("        disable DPI-C support\n");
 		log("\n");
@@ -207,6 +324,18 @@ struct VerilogFrontend : public Frontend {
 		log("        to a later 'hierarchy' command. Useful in cases where the default\n");
 		log("        parameters of modules yield invalid or not synthesizable code.\n");
 		log("\n");
+		log("    -cache <dir>\n");
+		log("        keep the RTLIL generated for each module in the given directory and\n");
+		log("        reuse it in later runs instead of elaborating the module again. This\n");
+		log("        applies to the modules read by this command as well as to the\n");
+		log("        parametrized variants derived from them by 'hierarchy'. The cache is\n");
+		log("        keyed on the module's syntax tree after preprocessing (i.e. the source\n");
+		log("        text, the defines and the included files that went into it), the\n");
+		log("        parameter values, the frontend options, the definitions of the\n");
+		log("        instantiated modules and the Yosys version. Messages printed during\n");
+		log("        elaboration (e.g. warnings and $display output) are not repeated for\n");
+		log("        cached modules. The directory is created if it doesn't exist.\n");
+		log("\n");
 		log("    -noautowire\n");
 		log("        make the default of `default_nettype be \"none\" instead of \"wire\".\n");
 		log("\n");
@@ -259,9 +388,11 @@ struct VerilogFrontend : public Frontend {
 		bool flag_nooverwrite = false;
 		bool flag_overwrite = false;
 		bool flag_defer = false;
+		std::string cache_dir;
 		bool flag_noblackbox = false;
 		bool flag_nowb = false;
 		bool flag_nosynthesis = false;
+		int num_jobs = 1;
 		define_map_t defines_map;
 
 		std::list<std::string> include_dirs;
@@ -276,6 +407,11 @@ struct VerilogFrontend : public Frontend {
 		specify_mode = false;
 		default_nettype_wire = true;
 
+		// Only a continuation of the same read_verilog command may use the
+		// prefetched files.
+		if (args != preproc_prefetch_args)
+			preproc_prefetch.clear();
+
 		args.insert(args.begin()+1, verilog_defaults.begin(), verilog_defaults.end());
 
 		size_t argidx;
@@ -377,6 +513,12 @@ struct VerilogFrontend : public Frontend {
 				flag_nopp = true;
 				continue;
 			}
+			if (arg == "-j" && argidx+1 < args.size()) {
+				num_jobs = atoi(args[++argidx].c_str());
+				if (num_jobs <= 0)
+					num_jobs = get_num_cpus();
+				continue;
+			}
 			if (arg == "-nodpi") {
 				flag_nodpi = true;
 				continue;
@@ -424,6 +566,12 @@ struct VerilogFrontend : public Frontend {
 				flag_defer = true;
 				continue;
 			}
+			if (arg == "-cache" && argidx+1 < args.size()) {
+				cache_dir = args[++argidx];
+				if (!create_directory(cache_dir))
+					log_cmd_error("Can't create cache directory `%s'.\n", cache_dir.c_str());
+				continue;
+			}
 			if (arg == "-noautowire") {
 				default_nettype_wire = false;
 				continue;
@@ -482,7 +630,26 @@ struct VerilogFrontend : public Frontend {
 		std::string code_after_preproc;
 
 		if (!flag_nopp) {
-			code_after_preproc = frontend_verilog_preproc(*f, filename, defines_map, *design->verilog_defines, include_dirs);
+			bool prefetched = false;
+			if (!preproc_prefetch.empty()) {
+				if (preproc_prefetch.front().filename == filename && preproc_prefetch_generation == design->verilog_defines->generation) {
+					auto &entry = preproc_prefetch.front();
+					if (entry.available && !entry.changes_defines) {
+						code_after_preproc.swap(entry.code);
+						yosys_input_files.insert(entry.input_files.begin(), entry.input_files.end());
+						log("Using prefetched preprocessor output for `%s'.\n", filename.c_str());
+						prefetched = true;
+					}
+					preproc_prefetch.pop_front();
+				} else
+					preproc_prefetch.clear();
+			}
+			if (num_jobs > 1 && preproc_prefetch.empty() && next_args.size() > argidx)
+				prefetch_preproc(std::vector<std::string>(next_args.begin() + argidx, next_args.end()),
+						defines_map, design, include_dirs, num_jobs);
+			preproc_prefetch_args = next_args;
+			if (!prefetched)
+				code_after_preproc = frontend_verilog_preproc(*f, filename, defines_map, *design->verilog_defines, include_dirs);
 			if (flag_ppdump)
 				log("-- Verilog code after preprocessor --\n%s-- END OF DUMP --\n", code_after_preproc.c_str());
 			lexin = new std::istringstream(code_after_preproc);
@@ -520,7 +687,7 @@ struct VerilogFrontend : public Frontend {
 			error_on_dpi_function(current_ast);
 
 		AST::process(design, current_ast, flag_nodisplay, flag_dump_ast1, flag_dump_ast2, flag_no_dump_ptr, flag_dump_vlog1, flag_dump_vlog2, flag_dump_rtlil, flag_nolatches,
-				flag_nomeminit, flag_nomem2reg, flag_mem2reg, flag_noblackbox, lib_mode, flag_nowb, flag_noopt, flag_icells, flag_pwires, flag_nooverwrite, flag_overwrite, flag_defer, default_nettype_wire);
+				flag_nomeminit, flag_nomem2reg, flag_mem2reg, flag_noblackbox, lib_mode, flag_nowb, flag_noopt, flag_icells, flag_pwires, flag_nooverwrite, flag_overwrite, flag_defer, default_nettype_wire, cache_dir);
 
 
 		if (!flag_nopp)
@@ -45,6 +45,10 @@ namespace VERILOG_FRONTEND
 	// this function converts a Verilog constant to an AST_CONSTANT node
 	AST::AstNode *const2ast(std::string code, char case_type = 0, bool warn_z = false);
 
+	// this function converts the digits of a sized constant (without the "<bits>'<base>" prefix) to bits,
+	// the same way as const2ast() does, e.g. for the data words of $readmemh and $readmemb
+	void digits2bits(std::vector<RTLIL::State> &data, const char *digits, int len_in_bits, int base);
+
 	// names of locally typedef'ed types in a stack
 	typedef std::map<std::string, AST::AstNode*> UserTypeMap;
 	extern std::vector<UserTypeMap> user_type_stack;
@@ -0,0 +1,728 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2026  The Yosys contributors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "kernel/bitsim.h"
+
+YOSYS_NAMESPACE_BEGIN
+
+typedef BitSim::lane_t lane_t;
+typedef BitSim::lanes_t lanes_t;
+
+static const uint64_t all_lanes = ~uint64_t(0);
+
+static lane_t lane_const(bool value)
+{
+	return {value ? all_lanes : 0, 0};
+}
+
+static lane_t lane_undef()
+{
+	return {0, all_lanes};
+}
+
+static lane_t lane_not(lane_t a)
+{
+	return {~a.val, a.undef};
+}
+
+// The gate rules below match the undef model in SatGen: a defined 0 (1) on one
+// input of an AND (OR) gate masks an undefined value on the other input.
+
+static lane_t lane_and(lane_t a, lane_t b)
+{
+	uint64_t zero = (~a.val & ~a.undef) | (~b.val & ~b.undef);
+	return {a.val & b.val, (a.undef | b.undef) & ~zero};
+}
+
+static lane_t lane_or(lane_t a, lane_t b)
+{
+	uint64_t one = (a.val & ~a.undef) | (b.val & ~b.undef);
+	return {a.val | b.val, (a.undef | b.undef) & ~one};
+}
+
+static lane_t lane_xor(lane_t a, lane_t b)
+{
+	return {a.val ^ b.val, a.undef | b.undef};
+}
+
+static lane_t lane_mux(lane_t a, lane_t b, lane_t s)
+{
+	uint64_t val = (s.val & b.val) | (~s.val & a.val);
+	uint64_t undef_sel = (s.val & b.undef) | (~s.val & a.undef);
+	uint64_t undef_any = a.undef | b.undef | (a.val ^ b.val);
+	return {val, (~s.undef & undef_sel) | (s.undef & undef_any)};
+}
+
+static lane_t lane_select(uint64_t sel, lane_t t, lane_t f)
+{
+	return {(sel & t.val) | (~sel & f.val), (sel & t.undef) | (~sel & f.undef)};
+}
+
+static lanes_t extend(lanes_t v, int width, bool is_signed)
+{
+	lane_t pad = is_signed && !v.empty() ? v.back() : lane_const(false);
+	v.resize(width, pad);
+	return v;
+}
+
+static uint64_t undef_mask(const lanes_t &v)
+{
+	uint64_t mask = 0;
+	for (auto &l : v)
+		mask |= l.undef;
+	return mask;
+}
+
+static lanes_t with_undef(lanes_t v, uint64_t mask)
+{
+	for (auto &l : v)
+		l.undef |= mask;
+	return v;
+}
+
+// Word-level arithmetic only looks at the values. The callers mark the whole
+// result as undefined in lanes where any operand bit is undefined.
+
+static lanes_t add(const lanes_t &a, const lanes_t &b, uint64_t carry, lanes_t *carries = nullptr)
+{
+	log_assert(GetSize(a) == GetSize(b));
+	lanes_t y(GetSize(a));
+	for (int i = 0; i < GetSize(a); i++) {
+		uint64_t t = a[i].val ^ b[i].val;
+		y[i] = {t ^ carry, 0};
+		carry = (a[i].val & b[i].val) | (carry & t);
+		if (carries != nullptr)
+			carries->push_back({carry, 0});
+	}
+	return y;
+}
+
+static lanes_t sub(const lanes_t &a, const lanes_t &b)
+{
+	lanes_t inv_b(GetSize(b));
+	for (int i = 0; i < GetSize(b); i++)
+		inv_b[i] = {~b[i].val, 0};
+	return add(a, inv_b, all_lanes);
+}
+
+static lanes_t mul(const lanes_t &a, const lanes_t &b)
+{
+	int width = GetSize(a);
+	lanes_t y(width, lane_const(false));
+	for (int i = 0; i < width; i++) {
+		lanes_t partial(width, lane_const(false));
+		for (int j = i; j < width; j++)
+			partial[j].val = a[j-i].val & b[i].val;
+		y = add(y, partial, 0);
+	}
+	return y;
+}
+
+static uint64_t less_than(lanes_t a, lanes_t b, bool is_signed)
+{
+	int width = max(GetSize(a), GetSize(b)) + 2;
+	lanes_t d = sub(extend(a, width, is_signed), extend(b, width, is_signed));
+	return d.back().val;
+}
+
+// Barrel shifter with the shift amount in b, treated as unsigned. Vacated
+// positions and lanes in which the amount exceeds the width get the fill value.
+static lanes_t shift(lanes_t a, const lanes_t &b, bool left, lane_t fill)
+{
+	int width = GetSize(a);
+	uint64_t overflow = 0;
+
+	for (int i = 0; i < GetSize(b); i++) {
+		if (i >= 30 || (1 << i) >= width) {
+			overflow |= b[i].val;
+			continue;
+		}
+		int dist = 1 << i;
+		lanes_t shifted(width);
+		for (int j = 0; j < width; j++) {
+			int src = left ? j - dist : j + dist;
+			shifted[j] = src >= 0 && src < width ? a[src] : fill;
+		}
+		for (int j = 0; j < width; j++)
+			a[j] = lane_select(b[i].val, shifted[j], a[j]);
+	}
+
+	for (int j = 0; j < width; j++)
+		a[j] = lane_select(overflow, fill, a[j]);
+	return a;
+}
+
+static lanes_t bit_result(lane_t bit, int width)
+{
+	lanes_t y(max(width, 1), lane_const(false));
+	y[0] = bit;
+	y.resize(width);
+	return y;
+}
+
+BitSim::BitSim(RTLIL::Module *module, uint64_t seed) : module(module), sigmap(module), max_level(0), rng_state(seed ? seed : 1)
+{
+	for (auto wire : module->wires())
+		for (auto bit : sigmap(wire))
+			add_bit(bit);
+	setup(nullptr);
+}
+
+BitSim::BitSim(RTLIL::Module *module, const RTLIL::SigSpec &cone, uint64_t seed) : module(module), sigmap(module), max_level(0), rng_state(seed ? seed : 1)
+{
+	setup(&cone);
+}
+
+void BitSim::setup(const RTLIL::SigSpec *cone)
+{
+	ct.setup_internals();
+	ct.setup_stdcells();
+
+	std::vector<RTLIL::Cell*> known;
+	dict<RTLIL::SigBit, int> bit2driver;
+
+	for (auto cell : module->cells()) {
+		if (!ct.cell_known(cell->type))
+			continue;
+		// The SAT models leave these unconstrained, so they are free bits.
+		if (cell->type.in(ID($anyconst), ID($anyseq), ID($allconst), ID($allseq)))
+			continue;
+		bool has_outputs = false;
+		for (auto &conn : cell->connections())
+			if (ct.cell_output(cell->type, conn.first))
+				for (auto bit : sigmap(conn.second))
+					if (bit.wire != nullptr) {
+						bit2driver[bit] = GetSize(known);
+						has_outputs = true;
+					}
+		if (has_outputs)
+			known.push_back(cell);
+	}
+
+	if (cone != nullptr)
+	{
+		// Only keep the cells in the input cone, found by walking back
+		// from the cone bits.
+		std::vector<bool> needed(GetSize(known));
+		std::vector<RTLIL::SigBit> queue;
+		pool<RTLIL::SigBit> seen;
+		for (auto bit : sigmap(*cone))
+			if (bit.wire != nullptr && seen.insert(bit).second)
+				queue.push_back(bit);
+
+		for (int qi = 0; qi < GetSize(queue); qi++) {
+			add_bit(queue[qi]);
+			auto it = bit2driver.find(queue[qi]);
+			if (it == bit2driver.end() || needed[it->second])
+				continue;
+			RTLIL::Cell *cell = known[it->second];
+			needed[it->second] = true;
+			for (auto &conn : cell->connections())
+				for (auto bit : sigmap(conn.second))
+					if (bit.wire != nullptr && seen.insert(bit).second)
+						queue.push_back(bit);
+		}
+
+		std::vector<RTLIL::Cell*> cone_cells;
+		bit2driver.clear();
+		for (int i = 0; i < GetSize(known); i++) {
+			if (!needed[i])
+				continue;
+			for (auto &conn : known[i]->connections())
+				if (ct.cell_output(known[i]->type, conn.first))
+					for (auto bit : sigmap(conn.second))
+						if (bit.wire != nullptr)
+							bit2driver[bit] = GetSize(cone_cells);
+			cone_cells.push_back(known[i]);
+		}
+		known.swap(cone_cells);
+	}
+
+	// Levelize with Kahn's algorithm. Cells left over afterwards are on
+	// combinational loops.
+	std::vector<int> indegree(GetSize(known)), cell_levels(GetSize(known), 1);
+	std::vector<std::vector<int>> fanout(GetSize(known));
+
+	for (int i = 0; i < GetSize(known); i++) {
+		pool<int> fanin;
+		for (auto &conn : known[i]->connections())
+			if (ct.cell_input(known[i]->type, conn.first))
+				for (auto bit : sigmap(conn.second))
+					if (bit2driver.count(bit))
+						fanin.insert(bit2driver.at(bit));
+		for (int j : fanin)
+			fanout[j].push_back(i);
+		indegree[i] = GetSize(fanin);
+	}
+
+	std::vector<int> queue;
+	for (int i = 0; i < GetSize(known); i++)
+		if (indegree[i] == 0)
+			queue.push_back(i);
+
+	for (int qi = 0; qi < GetSize(queue); qi++) {
+		int i = queue[qi];
+		cells.push_back(known[i]);
+		for (int j : fanout[i]) {
+			cell_levels[j] = max(cell_levels[j], cell_levels[i] + 1);
+			if (--indegree[j] == 0)
+				queue.push_back(j);
+		}
+	}
+
+	for (int i = 0; i < GetSize(known); i++)
+		if (indegree[i] > 0) {
+			cells.push_back(known[i]);
+			undef_cells.insert(known[i]);
+		}
+
+	for (auto cell : known)
+		if (!cell_supported(cell->type))
+			undef_cells.insert(cell);
+
+	for (auto &it : bit2driver) {
+		int level = cell_levels[it.second];
+		bit_levels[bit_index.at(it.first)] = level;
+		max_level = max(max_level, level);
+	}
+
+	for (auto &it : bit_index)
+		if (!bit2driver.count(it.first))
+			free_bits.push_back(it.second);
+}
+
+int BitSim::add_bit(RTLIL::SigBit bit)
+{
+	auto it = bit_index.find(bit);
+	if (it != bit_index.end())
+		return it->second;
+	int idx = GetSize(bit_values);
+	bit_index[bit] = idx;
+	bit_values.push_back(lane_undef());
+	bit_levels.push_back(0);
+	return idx;
+}
+
+bool BitSim::cell_supported(RTLIL::IdString type)
+{
+	return type.in(ID($_BUF_), ID($_NOT_), ID($_AND_), ID($_NAND_), ID($_OR_), ID($_NOR_), ID($_XOR_), ID($_XNOR_),
+			ID($_ANDNOT_), ID($_ORNOT_), ID($_MUX_), ID($_NMUX_), ID($_AOI3_), ID($_OAI3_), ID($_AOI4_), ID($_OAI4_)) ||
+		type.in(ID($not), ID($pos), ID($neg), ID($and), ID($or), ID($xor), ID($xnor),
+			ID($reduce_and), ID($reduce_or), ID($reduce_xor), ID($reduce_xnor), ID($reduce_bool),
+			ID($logic_not), ID($logic_and), ID($logic_or), ID($eq), ID($ne), ID($eqx), ID($nex), ID($bweqx),
+			ID($lt), ID($le), ID($gt), ID($ge), ID($add), ID($sub), ID($mul)) ||
+		type.in(ID($shl), ID($shr), ID($sshl), ID($sshr), ID($shift), ID($shiftx),
+			ID($mux), ID($bwmux), ID($pmux), ID($alu), ID($lcu), ID($fa), ID($slice), ID($concat), ID($equiv));
+}
+
+void BitSim::randomize()
+{
+	for (int idx : free_bits) {
+		rng_state ^= rng_state << 13;
+		rng_state ^= rng_state >> 7;
+		rng_state ^= rng_state << 17;
+		bit_values[idx] = {rng_state, 0};
+	}
+}
+
+void BitSim::set(RTLIL::SigBit bit, lane_t value)
+{
+	bit_values[add_bit(sigmap(bit))] = value;
+}
+
+BitSim::lane_t BitSim::get(RTLIL::SigBit bit) const
+{
+	bit = sigmap(bit);
+	if (bit.wire == nullptr)
+		return bit == State::S0 ? lane_const(false) : bit == State::S1 ? lane_const(true) : lane_undef();
+	auto it = bit_index.find(bit);
+	if (it == bit_index.end())
+		return lane_undef();
+	return bit_values[it->second];
+}
+
+BitSim::lanes_t BitSim::get(const RTLIL::SigSpec &sig) const
+{
+	lanes_t value;
+	for (auto bit : sig)
+		value.push_back(get(bit));
+	return value;
+}
+
+int BitSim::level(RTLIL::SigBit bit) const
+{
+	bit = sigmap(bit);
+	auto it = bit_index.find(bit);
+	return it == bit_index.end() ? 0 : bit_levels[it->second];
+}
+
+void BitSim::put(const RTLIL::SigSpec &sig, const lanes_t &value)
+{
+	log_assert(GetSize(sig) == GetSize(value));
+	for (int i = 0; i < GetSize(sig); i++) {
+		RTLIL::SigBit bit = sigmap(sig[i]);
+		if (bit.wire != nullptr)
+			bit_values[bit_index.at(bit)] = value[i];
+	}
+}
+
+void BitSim::eval()
+{
+	for (auto cell : cells)
+		if (undef_cells.count(cell) || !eval(cell)) {
+			for (auto &conn : cell->connections())
+				if (ct.cell_output(cell->type, conn.first))
+					put(conn.second, lanes_t(GetSize(conn.second), lane_undef()));
+		}
+}
+
+bool BitSim::eval(RTLIL::Cell *cell)
+{
+	RTLIL::IdString type = cell->type;
+
+	if (type.in(ID($_BUF_), ID($_NOT_))) {
+		lane_t a = get(cell->getPort(ID::A).as_bit());
+		put(cell->getPort(ID::Y), {type == ID($_NOT_) ? lane_not(a) : a});
+		return true;
+	}
+
+	if (type.in(ID($_AND_), ID($_NAND_), ID($_OR_), ID($_NOR_), ID($_XOR_), ID($_XNOR_), ID($_ANDNOT_), ID($_ORNOT_))) {
+		lane_t a = get(cell->getPort(ID::A).as_bit());
+		lane_t b = get(cell->getPort(ID::B).as_bit());
+		if (type.in(ID($_ANDNOT_), ID($_ORNOT_)))
+			b = lane_not(b);
+		lane_t y = type.in(ID($_AND_), ID($_NAND_), ID($_ANDNOT_)) ? lane_and(a, b) :
+				type.in(ID($_OR_), ID($_NOR_), ID($_ORNOT_)) ? lane_or(a, b) : lane_xor(a, b);
+		if (type.in(ID($_NAND_), ID($_NOR_), ID($_XNOR_)))
+			y = lane_not(y);
+		put(cell->getPort(ID::Y), {y});
+		return true;
+	}
+
+	if (type.in(ID($_MUX_), ID($_NMUX_))) {
+		lane_t y = lane_mux(get(cell->getPort(ID::A).as_bit()), get(cell->getPort(ID::B).as_bit()), get(cell->getPort(ID::S).as_bit()));
+		put(cell->getPort(ID::Y), {type == ID($_NMUX_) ? lane_not(y) : y});
+		return true;
+	}
+
+	if (type.in(ID($_AOI3_), ID($_OAI3_), ID($_AOI4_), ID($_OAI4_))) {
+		lane_t a = get(cell->getPort(ID::A).as_bit());
+		lane_t b = get(cell->getPort(ID::B).as_bit());
+		lane_t c = get(cell->getPort(ID::C).as_bit());
+		lane_t y;
+		if (type == ID($_AOI3_))
+			y = lane_or(lane_and(a, b), c);
+		else if (type == ID($_OAI3_))
+			y = lane_and(lane_or(a, b), c);
+		else {
+			lane_t d = get(cell->getPort(ID::D).as_bit());
+			y = type == ID($_AOI4_) ? lane_or(lane_and(a, b), lane_and(c, d)) : lane_and(lane_or(a, b), lane_or(c, d));
+		}
+		put(cell->getPort(ID::Y), {lane_not(y)});
+		return true;
+	}
+
+	if (type == ID($equiv)) {
+		put(cell->getPort(ID::Y), get(cell->getPort(ID::A)));
+		return true;
+	}
+
+	bool signed_a = cell->parameters.count(ID::A_SIGNED) && cell->getParam(ID::A_SIGNED).as_bool();
+	bool signed_b = cell->parameters.count(ID::B_SIGNED) && cell->getParam(ID::B_SIGNED).as_bool();
+	int y_width = cell->hasPort(ID::Y) ? GetSize(cell->getPort(ID::Y)) : 0;
+
+	if (type.in(ID($not), ID($pos), ID($neg))) {
+		lanes_t a = extend(get(cell->getPort(ID::A)), y_width, signed_a);
+		if (type == ID($not))
+			for (auto &l : a)
+				l = lane_not(l);
+		if (type == ID($neg))
+			a = with_undef(sub(lanes_t(y_width, lane_const(false)), a), undef_mask(a));
+		put(cell->getPort(ID::Y), a);
+		return true;
+	}
+
+	if (type.in(ID($and), ID($or), ID($xor), ID($xnor))) {
+		lanes_t a = extend(get(cell->getPort(ID::A)), y_width, signed_a);
+		lanes_t b = extend(get(cell->getPort(ID::B)), y_width, signed_b);
+		lanes_t y(y_width);
+		for (int i = 0; i < y_width; i++) {
+			y[i] = type == ID($and) ? lane_and(a[i], b[i]) : type == ID($or) ? lane_or(a[i], b[i]) : lane_xor(a[i], b[i]);
+			if (type == ID($xnor))
+				y[i] = lane_not(y[i]);
+		}
+		put(cell->getPort(ID::Y), y);
+		return true;
+	}
+
+	if (type.in(ID($reduce_and), ID($reduce_or), ID($reduce_xor), ID($reduce_xnor), ID($reduce_bool), ID($logic_not))) {
+		lanes_t a = get(cell->getPort(ID::A));
+		lane_t y = lane_const(type == ID($reduce_and));
+		for (auto &l : a)
+			y = type == ID($reduce_and) ? lane_and(y, l) : type.in(ID($reduce_xor), ID($reduce_xnor)) ? lane_xor(y, l) : lane_or(y, l);
+		if (type.in(ID($reduce_xnor), ID($logic_not)))
+			y = lane_not(y);
+		put(cell->getPort(ID::Y), bit_result(y, y_width));
+		return true;
+	}
+
+	if (type.in(ID($logic_and), ID($logic_or))) {
+		lane_t a = lane_const(false), b = lane_const(false);
+		for (auto &l : get(cell->getPort(ID::A)))
+			a = lane_or(a, l);
+		for (auto &l : get(cell->getPort(ID::B)))
+			b = lane_or(b, l);
+		put(cell->getPort(ID::Y), bit_result(type == ID($logic_and) ? lane_and(a, b) : lane_or(a, b), y_width));
+		return true;
+	}
+
+	if (type.in(ID($eq), ID($ne), ID($eqx), ID($nex), ID($bweqx))) {
+		lanes_t a = get(cell->getPort(ID::A));
+		lanes_t b = get(cell->getPort(ID::B));
+		int width = max(GetSize(a), GetSize(b));
+		a = extend(a, width, signed_a && signed_b);
+		b = extend(b, width, signed_a && signed_b);
+		if (type == ID($bweqx)) {
+			lanes_t y(width);
+			for (int i = 0; i < width; i++)
+				y[i] = lane_not(lane_xor(a[i], b[i]));
+			put(cell->getPort(ID::Y), y);
+			return true;
+		}
+		lane_t ne = lane_const(false);
+		for (int i = 0; i < width; i++)
+			ne = lane_or(ne, lane_xor(a[i], b[i]));
+		put(cell->getPort(ID::Y), bit_result(type.in(ID($eq), ID($eqx)) ? lane_not(ne) : ne, y_width));
+		return true;
+	}
+
+	if (type.in(ID($lt), ID($le), ID($gt), ID($ge))) {
+		lanes_t a = get(cell->getPort(ID::A));
+		lanes_t b = get(cell->getPort(ID::B));
+		bool is_signed = signed_a && signed_b;
+		uint64_t y;
+		if (type == ID($lt))
+			y = less_than(a, b, is_signed);
+		else if (type == ID($le))
+			y = ~less_than(b, a, is_signed);
+		else if (type == ID($gt))
+			y = less_than(b, a, is_signed);
+		else
+			y = ~less_than(a, b, is_signed);
+		put(cell->getPort(ID::Y), bit_result({y, undef_mask(a) | undef_mask(b)}, y_width));
+		return true;
+	}
+
+	if (type.in(ID($add), ID($sub), ID($mul))) {
+		lanes_t a = extend(get(cell->getPort(ID::A)), y_width, signed_a);
+		lanes_t b = extend(get(cell->getPort(ID::B)), y_width, signed_b);
+		lanes_t y = type == ID($add) ? add(a, b, 0) : type == ID($sub) ? sub(a, b) : mul(a, b);
+		put(cell->getPort(ID::Y), with_undef(y, undef_mask(a) | undef_mask(b)));
+		return true;
+	}
+
+	if (type.in(ID($shl), ID($shr), ID($sshl), ID($sshr), ID($shift), ID($shiftx))) {
+		lanes_t a = get(cell->getPort(ID::A));
+		lanes_t b = get(cell->getPort(ID::B));
+		if (type == ID($shiftx) && !signed_a)
+			a.resize(max(GetSize(a), y_width), lane_undef());
+		else
+			a = extend(a, max(GetSize(a), y_width), signed_a);
+		if (a.empty()) {
+			put(cell->getPort(ID::Y), lanes_t());
+			return true;
+		}
+		lane_t fill = lane_const(false);
+		if (type == ID($sshr) && signed_a)
+			fill = a.back();
+		if (type == ID($shiftx))
+			fill = lane_undef();
+		lanes_t y;
+		if (type.in(ID($shl), ID($sshl)))
+			y = shift(a, b, true, fill);
+		else if (type.in(ID($shift), ID($shiftx)) && signed_b && !b.empty()) {
+			lanes_t right = shift(a, b, false, fill);
+			lanes_t left = shift(a, sub(lanes_t(GetSize(b), lane_const(false)), b), true, fill);
+			y.resize(GetSize(a));
+			for (int i = 0; i < GetSize(a); i++)
+				y[i] = lane_select(b.back().val, left[i], right[i]);
+		} else
+			y = shift(a, b, false, fill);
+		y.resize(y_width);
+		put(cell->getPort(ID::Y), with_undef(y, undef_mask(b)));
+		return true;
+	}
+
+	if (type.in(ID($mux), ID($bwmux))) {
+		lanes_t a = get(cell->getPort(ID::A));
+		lanes_t b = get(cell->getPort(ID::B));
+		lanes_t s = get(cell->getPort(ID::S));
+		lanes_t y(GetSize(a));
+		for (int i = 0; i < GetSize(a); i++)
+			y[i] = lane_mux(a[i], b[i], s[type == ID($mux) ? 0 : i]);
+		put(cell->getPort(ID::Y), y);
+		return true;
+	}
+
+	if (type == ID($pmux)) {
+		lanes_t y = get(cell->getPort(ID::A));
+		lanes_t b = get(cell->getPort(ID::B));
+		lanes_t s = get(cell->getPort(ID::S));
+		int width = GetSize(y);
+		// Like SatGen, the last active select input wins. Lanes with several
+		// active or undefined select inputs are undefined in the undef model.
+		uint64_t active = 0, conflict = 0;
+		for (int i = 0; i < GetSize(s); i++) {
+			for (int j = 0; j < width; j++)
+				y[j] = lane_select(s[i].val, b[i*width + j], y[j]);
+			conflict |= (active & s[i].val) | s[i].undef;
+			active |= s[i].val;
+		}
+		put(cell->getPort(ID::Y), with_undef(y, conflict));
+		return true;
+	}
+
+	if (type == ID($alu)) {
+		lanes_t a = extend(get(cell->getPort(ID::A)), y_width, signed_a);
+		lanes_t b = extend(get(cell->getPort(ID::B)), y_width, signed_b);
+		lane_t bi = get(cell->getPort(ID::BI).as_bit());
+		lane_t ci = get(cell->getPort(ID::CI).as_bit());
+		uint64_t undef = undef_mask(a) | undef_mask(b) | bi.undef | ci.undef;
+		lanes_t x(y_width), co;
+		for (int i = 0; i < y_width; i++) {
+			b[i] = lane_xor(b[i], bi);
+			x[i] = lane_xor(a[i], b[i]);
+		}
+		lanes_t y = add(a, b, ci.val, &co);
+		put(cell->getPort(ID::X), x);
+		put(cell->getPort(ID::Y), with_undef(y, undef));
+		put(cell->getPort(ID::CO), with_undef(co, undef));
+		return true;
+	}
+
+	if (type == ID($lcu)) {
+		lanes_t p = get(cell->getPort(ID::P));
+		lanes_t g = get(cell->getPort(ID::G));
+		lane_t carry = get(cell->getPort(ID::CI).as_bit());
+		uint64_t undef = undef_mask(p) | undef_mask(g) | carry.undef;
+		lanes_t co(GetSize(p));
+		for (int i = 0; i < GetSize(p); i++) {
+			carry.val = g[i].val | (p[i].val & carry.val);
+			co[i] = {carry.val, undef};
+		}
+		put(cell->getPort(ID::CO), co);
+		return true;
+	}
+
+	if (type == ID($fa)) {
+		lanes_t a = get(cell->getPort(ID::A));
+		lanes_t b = get(cell->getPort(ID::B));
+		lanes_t c = get(cell->getPort(ID::C));
+		lanes_t x(GetSize(a)), y(GetSize(a));
+		for (int i = 0; i < GetSize(a); i++) {
+			uint64_t t = a[i].val ^ b[i].val;
+			uint64_t undef = a[i].undef | b[i].undef | c[i].undef;
+			y[i] = {t ^ c[i].val, undef};
+			x[i] = {(a[i].val & b[i].val) | (c[i].val & t), undef};
+		}
+		put(cell->getPort(ID::X), x);
+		put(cell->getPort(ID::Y), y);
+		return true;
+	}
+
+	if (type == ID($slice)) {
+		lanes_t a = get(cell->getPort(ID::A));
+		int offset = cell->getParam(ID::OFFSET).as_int();
+		if (offset < 0 || offset + y_width > GetSize(a))
+			return false;
+		put(cell->getPort(ID::Y), lanes_t(a.begin() + offset, a.begin() + offset + y_width));
+		return true;
+	}
+
+	if (type == ID($concat)) {
+		lanes_t y = get(cell->getPort(ID::A));
+		lanes_t b = get(cell->getPort(ID::B));
+		y.insert(y.end(), b.begin(), b.end());
+		put(cell->getPort(ID::Y), y);
+		return true;
+	}
+
+	return false;
+}
+
+ConstEvalBatch::ConstEvalBatch(RTLIL::Module *module, const RTLIL::SigSpec &outputs) : sim(module, outputs)
+{
+	for (int idx : sim.free_bits)
+		sim.bit_values[idx] = lane_undef();
+	pool<int> free_bits(sim.free_bits.begin(), sim.free_bits.end());
+	for (auto &it : sim.bit_index)
+		if (free_bits.count(it.second))
+			inputs.append(it.first);
+}
+
+void ConstEvalBatch::clear()
+{
+	for (int idx : sim.free_bits)
+		sim.bit_values[idx] = lane_undef();
+}
+
+void ConstEvalBatch::set(RTLIL::SigSpec sig, const RTLIL::Const &value)
+{
+	log_assert(GetSize(sig) == GetSize(value));
+	for (int i = 0; i < GetSize(sig); i++) {
+		State bit = value[i];
+		sim.set(sig[i], bit == State::S0 || bit == State::S1 ? lane_const(bit == State::S1) : lane_undef());
+	}
+}
+
+void ConstEvalBatch::set(RTLIL::SigSpec sig, const std::vector<RTLIL::Const> &values)
+{
+	log_assert(GetSize(values) <= 64);
+	for (int i = 0; i < GetSize(sig); i++) {
+		lane_t lane = lane_undef();
+		for (int j = 0; j < GetSize(values); j++) {
+			log_assert(GetSize(values[j]) == GetSize(sig));
+			uint64_t mask = uint64_t(1) << j;
+			State bit = values[j][i];
+			if (bit == State::S0 || bit == State::S1) {
+				lane.undef &= ~mask;
+				if (bit == State::S1)
+					lane.val |= mask;
+			}
+		}
+		sim.set(sig[i], lane);
+	}
+}
+
+uint64_t ConstEvalBatch::eval_batch(RTLIL::SigSpec sig, std::vector<RTLIL::Const> &values)
+{
+	sim.eval();
+	lanes_t lanes = sim.get(sig);
+
+	values.assign(64, RTLIL::Const(State::Sx, GetSize(sig)));
+	for (int i = 0; i < GetSize(sig); i++)
+		for (int j = 0; j < 64; j++) {
+			uint64_t mask = uint64_t(1) << j;
+			if (!(lanes[i].undef & mask))
+				values[j].bits[i] = lanes[i].val & mask ? State::S1 : State::S0;
+		}
+	return ~undef_mask(lanes);
+}
+
+YOSYS_NAMESPACE_END
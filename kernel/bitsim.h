@@ -0,0 +1,129 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2026  The Yosys contributors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef BITSIM_H
+#define BITSIM_H
+
+#include "kernel/rtlil.h"
+#include "kernel/sigtools.h"
+#include "kernel/celltypes.h"
+
+YOSYS_NAMESPACE_BEGIN
+
+// Bit-parallel random simulation of the combinational logic in a module.
+//
+// Every signal bit holds 64 independent patterns ("lanes") packed into a
+// machine word. The cells covered are the ones known to CellTypes with the
+// internal and gate-level cell libraries, i.e. the same cells ConstEval and
+// the SAT based passes look at. Bits that are not driven by such a cell
+// (module inputs, FF outputs, outputs of unknown cells, undriven wires) are
+// free and get random values. Known cells that cannot be simulated, and cells
+// on combinational loops, drive all their output lanes as undefined.
+//
+// Undef tracking is conservative: a lane that is not marked undefined holds
+// the exact value under both the 2-valued and the undef-aware SatGen models,
+// so a lane in which two bits are defined and differ is a counterexample to
+// their equivalence.
+
+struct BitSim
+{
+	struct lane_t {
+		uint64_t val, undef;
+	};
+	typedef std::vector<lane_t> lanes_t;
+
+	RTLIL::Module *module;
+	SigMap sigmap;
+	CellTypes ct;
+
+	dict<RTLIL::SigBit, int> bit_index;
+	std::vector<lane_t> bit_values;
+	std::vector<int> bit_levels;
+	std::vector<int> free_bits;
+
+	// Known cells in evaluation order, and the ones that are not simulated
+	std::vector<RTLIL::Cell*> cells;
+	pool<RTLIL::Cell*> undef_cells;
+	int max_level;
+
+	uint64_t rng_state;
+
+	BitSim(RTLIL::Module *module, uint64_t seed = 1);
+	// Only simulate the input cone of the given signals
+	BitSim(RTLIL::Module *module, const RTLIL::SigSpec &cone, uint64_t seed = 1);
+
+	static bool cell_supported(RTLIL::IdString type);
+
+	// Assign fresh random patterns to all free bits
+	void randomize();
+	void set(RTLIL::SigBit bit, lane_t value);
+	void eval();
+
+	lane_t get(RTLIL::SigBit bit) const;
+	lanes_t get(const RTLIL::SigSpec &sig) const;
+
+	// Number of cells between the bit and the free bits in its input cone
+	int level(RTLIL::SigBit bit) const;
+
+	// Lanes in which both bits are defined and have different values
+	uint64_t differ(RTLIL::SigBit a, RTLIL::SigBit b) const {
+		lane_t la = get(a), lb = get(b);
+		return (la.val ^ lb.val) & ~la.undef & ~lb.undef;
+	}
+
+private:
+	void setup(const RTLIL::SigSpec *cone);
+	int add_bit(RTLIL::SigBit bit);
+	void put(const RTLIL::SigSpec &sig, const lanes_t &value);
+	bool eval(RTLIL::Cell *cell);
+};
+
+// Evaluates the input cone of a set of signals for 64 assignments at once, in
+// the style of ConstEval. The cone is levelized once, in the constructor, and
+// each lane of the inputs holds one assignment. Inputs that are not set are
+// undefined.
+//
+// A lane in which the result is fully defined holds the value ConstEval would
+// compute for the same fully defined assignment. Lanes that are not defined
+// (undefined inputs, cells that BitSim does not simulate, combinational loops)
+// have to be evaluated with ConstEval when the exact x-propagation matters.
+
+struct ConstEvalBatch
+{
+	BitSim sim;
+	// The bits in the cone that are not driven by a known cell
+	RTLIL::SigSpec inputs;
+
+	ConstEvalBatch(RTLIL::Module *module, const RTLIL::SigSpec &outputs);
+
+	// Reset all inputs to undefined
+	void clear();
+	// Set the same value in all lanes
+	void set(RTLIL::SigSpec sig, const RTLIL::Const &value);
+	// Set values[i] in lane i, for up to 64 lanes
+	void set(RTLIL::SigSpec sig, const std::vector<RTLIL::Const> &values);
+
+	// Evaluate sig in all lanes. Stores the value of lane i in values[i], with
+	// Sx for the undefined bits, and returns the mask of the fully defined lanes.
+	uint64_t eval_batch(RTLIL::SigSpec sig, std::vector<RTLIL::Const> &values);
+};
+
+YOSYS_NAMESPACE_END
+
+#endif
@@ -97,6 +97,122 @@ static RTLIL::Const big2const(const BigInteger &val, int result_len, int undef_b
 	return result;
 }
 
+// Fully defined operands are also handled as little-endian arrays of 64 bit
+// words in two's complement, so that the common cases don't have to go
+// through BigInteger. All functions below return false if the operand has
+// undefined bits, and the callers then fall back to the BigInteger code.
+
+static int words_for_width(int width)
+{
+	return (width + 63) / 64;
+}
+
+// Convert to num_words words, extended with the sign bit of the operand
+// (as_signed) or zero.
+static bool const2words(const RTLIL::Const &val, bool as_signed, int num_words, std::vector<uint64_t> &words)
+{
+	int num_bits = GetSize(val.bits);
+	words.assign(num_words, 0);
+
+	for (int i = 0; i < num_bits; i++) {
+		RTLIL::State bit = val.bits[i];
+		if (bit == RTLIL::State::S1) {
+			if (i < 64*num_words)
+				words[i / 64] |= uint64_t(1) << (i % 64);
+		} else if (bit != RTLIL::State::S0)
+			return false;
+	}
+
+	if (as_signed && num_bits > 0 && val.bits.back() == RTLIL::State::S1 && num_bits < 64*num_words) {
+		if (num_bits % 64 != 0)
+			words[num_bits / 64] |= ~uint64_t(0) << (num_bits % 64);
+		for (int i = words_for_width(num_bits); i < num_words; i++)
+			words[i] = ~uint64_t(0);
+	}
+	return true;
+}
+
+static RTLIL::Const words2const(const std::vector<uint64_t> &words, int result_len)
+{
+	RTLIL::Const result(RTLIL::State::S0, result_len);
+	for (int i = 0; i < result_len; i++)
+		if ((words[i / 64] >> (i % 64)) & 1)
+			result.bits[i] = RTLIL::State::S1;
+	return result;
+}
+
+// Sign and magnitude of an operand with up to 64 bits, the same way
+// const2big() computes it.
+static bool const2mag(const RTLIL::Const &val, bool as_signed, bool &negative, uint64_t &mag)
+{
+	int num_bits = GetSize(val.bits);
+	if (num_bits > 64)
+		return false;
+
+	uint64_t word = 0;
+	for (int i = 0; i < num_bits; i++) {
+		RTLIL::State bit = val.bits[i];
+		if (bit == RTLIL::State::S1)
+			word |= uint64_t(1) << i;
+		else if (bit != RTLIL::State::S0)
+			return false;
+	}
+
+	negative = as_signed && num_bits > 0 && val.bits.back() == RTLIL::State::S1;
+	if (negative && num_bits < 64)
+		word |= ~uint64_t(0) << num_bits;
+	mag = negative ? 0 - word : word;
+	return true;
+}
+
+static RTLIL::Const mag2const(bool negative, uint64_t mag, int result_len)
+{
+	uint64_t word = negative ? 0 - mag : mag;
+	RTLIL::State padding = negative && mag != 0 ? RTLIL::State::S1 : RTLIL::State::S0;
+	RTLIL::Const result(padding, result_len);
+	for (int i = 0; i < result_len && i < 64; i++)
+		result.bits[i] = (word >> i) & 1 ? RTLIL::State::S1 : RTLIL::State::S0;
+	return result;
+}
+
+// Compare two operands as integers, with each operand extended according to
+// its own signedness. Sets cmp to -1, 0 or 1.
+static bool const_compare_words(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int &cmp)
+{
+	// one extra bit, so that unsigned operands stay positive
+	int num_words = words_for_width(max(GetSize(arg1), GetSize(arg2)) + 1);
+	std::vector<uint64_t> a, b;
+	if (!const2words(arg1, signed1, num_words, a) || !const2words(arg2, signed2, num_words, b))
+		return false;
+
+	cmp = 0;
+	int i = num_words - 1;
+	if (a[i] != b[i]) {
+		cmp = int64_t(a[i]) < int64_t(b[i]) ? -1 : 1;
+		return true;
+	}
+	for (i--; i >= 0; i--)
+		if (a[i] != b[i]) {
+			cmp = a[i] < b[i] ? -1 : 1;
+			break;
+		}
+	return true;
+}
+
+// The value of an operand in a logic context: S1 if any bit is set, S0 if
+// all bits are zero and Sx otherwise.
+static RTLIL::State logic_value(const RTLIL::Const &val)
+{
+	RTLIL::State result = RTLIL::State::S0;
+	for (auto bit : val.bits) {
+		if (bit == RTLIL::State::S1)
+			return RTLIL::State::S1;
+		if (bit != RTLIL::State::S0)
+			result = RTLIL::State::Sx;
+	}
+	return result;
+}
+
 static RTLIL::State logic_and(RTLIL::State a, RTLIL::State b)
 {
 	if (a == RTLIL::State::S0) return RTLIL::State::S0;
@@ -234,25 +350,20 @@ RTLIL::Const RTLIL::const_reduce_bool(const RTLIL::Const &arg1, const RTLIL::Con
 	return logic_reduce_wrapper(RTLIL::State::S0, logic_or, arg1, result_len);
 }
 
-RTLIL::Const RTLIL::const_logic_not(const RTLIL::Const &arg1, const RTLIL::Const&, bool signed1, bool, int result_len)
+RTLIL::Const RTLIL::const_logic_not(const RTLIL::Const &arg1, const RTLIL::Const&, bool, bool, int result_len)
 {
-	int undef_bit_pos_a = -1;
-	BigInteger a = const2big(arg1, signed1, undef_bit_pos_a);
-	RTLIL::Const result(a.isZero() ? undef_bit_pos_a >= 0 ? RTLIL::State::Sx : RTLIL::State::S1 : RTLIL::State::S0);
+	RTLIL::State bit_a = logic_value(arg1);
+	RTLIL::Const result(bit_a == RTLIL::State::S0 ? RTLIL::State::S1 : bit_a == RTLIL::State::S1 ? RTLIL::State::S0 : RTLIL::State::Sx);
 
 	while (int(result.bits.size()) < result_len)
 		result.bits.push_back(RTLIL::State::S0);
 	return result;
 }
 
-RTLIL::Const RTLIL::const_logic_and(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
+RTLIL::Const RTLIL::const_logic_and(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool, bool, int result_len)
 {
-	int undef_bit_pos_a = -1, undef_bit_pos_b = -1;
-	BigInteger a = const2big(arg1, signed1, undef_bit_pos_a);
-	BigInteger b = const2big(arg2, signed2, undef_bit_pos_b);
-
-	RTLIL::State bit_a = a.isZero() ? undef_bit_pos_a >= 0 ? RTLIL::State::Sx : RTLIL::State::S0 : RTLIL::State::S1;
-	RTLIL::State bit_b = b.isZero() ? undef_bit_pos_b >= 0 ? RTLIL::State::Sx : RTLIL::State::S0 : RTLIL::State::S1;
+	RTLIL::State bit_a = logic_value(arg1);
+	RTLIL::State bit_b = logic_value(arg2);
 	RTLIL::Const result(logic_and(bit_a, bit_b));
 
 	while (int(result.bits.size()) < result_len)
@@ -260,14 +371,10 @@ RTLIL::Const RTLIL::const_logic_and(const RTLIL::Const &arg1, const RTLIL::Const
 	return result;
 }
 
-RTLIL::Const RTLIL::const_logic_or(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
+RTLIL::Const RTLIL::const_logic_or(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool, bool, int result_len)
 {
-	int undef_bit_pos_a = -1, undef_bit_pos_b = -1;
-	BigInteger a = const2big(arg1, signed1, undef_bit_pos_a);
-	BigInteger b = const2big(arg2, signed2, undef_bit_pos_b);
-
-	RTLIL::State bit_a = a.isZero() ? undef_bit_pos_a >= 0 ? RTLIL::State::Sx : RTLIL::State::S0 : RTLIL::State::S1;
-	RTLIL::State bit_b = b.isZero() ? undef_bit_pos_b >= 0 ? RTLIL::State::Sx : RTLIL::State::S0 : RTLIL::State::S1;
+	RTLIL::State bit_a = logic_value(arg1);
+	RTLIL::State bit_b = logic_value(arg2);
 	RTLIL::Const result(logic_or(bit_a, bit_b));
 
 	while (int(result.bits.size()) < result_len)
@@ -282,24 +389,43 @@ RTLIL::Const RTLIL::const_logic_or(const RTLIL::Const &arg1, const RTLIL::Const
 // bounds are filled with the leftmost bit of `arg1` (arithmetic shift).
 static RTLIL::Const const_shift_worker(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool sign_ext, bool signed2, int direction, int result_len, RTLIL::State vacant_bits = RTLIL::State::S0)
 {
-	int undef_bit_pos = -1;
-	BigInteger offset = const2big(arg2, signed2, undef_bit_pos) * direction;
-
 	if (result_len < 0)
 		result_len = arg1.bits.size();
 
 	RTLIL::Const result(RTLIL::State::Sx, result_len);
-	if (undef_bit_pos >= 0)
-		return result;
+
+	// Any offset beyond +/- 2^31 shifts out all bits, so the offset is
+	// clamped to that range and the bit positions are computed natively.
+	const int64_t max_offset = int64_t(1) << 31;
+	int64_t offset;
+	bool negative;
+	uint64_t mag;
+	if (const2mag(arg2, signed2, negative, mag)) {
+		offset = int64_t(min(mag, uint64_t(max_offset)));
+		if (negative)
+			offset = -offset;
+	} else {
+		int undef_bit_pos = -1;
+		BigInteger big_offset = const2big(arg2, signed2, undef_bit_pos);
+		if (undef_bit_pos >= 0)
+			return result;
+		if (big_offset > BigInteger(max_offset))
+			offset = max_offset;
+		else if (big_offset < BigInteger(-max_offset))
+			offset = -max_offset;
+		else
+			offset = big_offset.toLong();
+	}
+	offset *= direction;
 
 	for (int i = 0; i < result_len; i++) {
-		BigInteger pos = BigInteger(i) + offset;
+		int64_t pos = i + offset;
 		if (pos < 0)
 			result.bits[i] = vacant_bits;
-		else if (pos >= BigInteger(int(arg1.bits.size())))
+		else if (pos >= GetSize(arg1.bits))
 			result.bits[i] = sign_ext ? arg1.bits.back() : vacant_bits;
 		else
-			result.bits[i] = arg1.bits[pos.toInt()];
+			result.bits[i] = arg1.bits[pos];
 	}
 
 	return result;
@@ -343,8 +469,9 @@ RTLIL::Const RTLIL::const_shiftx(const RTLIL::Const &arg1, const RTLIL::Const &a
 
 RTLIL::Const RTLIL::const_lt(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
-	int undef_bit_pos = -1;
-	bool y = const2big(arg1, signed1, undef_bit_pos) < const2big(arg2, signed2, undef_bit_pos);
+	int undef_bit_pos = -1, cmp;
+	bool y = const_compare_words(arg1, arg2, signed1, signed2, cmp) ? cmp < 0 :
+			const2big(arg1, signed1, undef_bit_pos) < const2big(arg2, signed2, undef_bit_pos);
 	RTLIL::Const result(undef_bit_pos >= 0 ? RTLIL::State::Sx : y ? RTLIL::State::S1 : RTLIL::State::S0);
 
 	while (int(result.bits.size()) < result_len)
@@ -354,8 +481,9 @@ RTLIL::Const RTLIL::const_lt(const RTLIL::Const &arg1, const RTLIL::Const &arg2,
 
 RTLIL::Const RTLIL::const_le(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
-	int undef_bit_pos = -1;
-	bool y = const2big(arg1, signed1, undef_bit_pos) <= const2big(arg2, signed2, undef_bit_pos);
+	int undef_bit_pos = -1, cmp;
+	bool y = const_compare_words(arg1, arg2, signed1, signed2, cmp) ? cmp <= 0 :
+			const2big(arg1, signed1, undef_bit_pos) <= const2big(arg2, signed2, undef_bit_pos);
 	RTLIL::Const result(undef_bit_pos >= 0 ? RTLIL::State::Sx : y ? RTLIL::State::S1 : RTLIL::State::S0);
 
 	while (int(result.bits.size()) < result_len)
@@ -428,8 +556,9 @@ RTLIL::Const RTLIL::const_nex(const RTLIL::Const &arg1, const RTLIL::Const &arg2
 
 RTLIL::Const RTLIL::const_ge(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
-	int undef_bit_pos = -1;
-	bool y = const2big(arg1, signed1, undef_bit_pos) >= const2big(arg2, signed2, undef_bit_pos);
+	int undef_bit_pos = -1, cmp;
+	bool y = const_compare_words(arg1, arg2, signed1, signed2, cmp) ? cmp >= 0 :
+			const2big(arg1, signed1, undef_bit_pos) >= const2big(arg2, signed2, undef_bit_pos);
 	RTLIL::Const result(undef_bit_pos >= 0 ? RTLIL::State::Sx : y ? RTLIL::State::S1 : RTLIL::State::S0);
 
 	while (int(result.bits.size()) < result_len)
@@ -439,8 +568,9 @@ RTLIL::Const RTLIL::const_ge(const RTLIL::Const &arg1, const RTLIL::Const &arg2,
 
 RTLIL::Const RTLIL::const_gt(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
-	int undef_bit_pos = -1;
-	bool y = const2big(arg1, signed1, undef_bit_pos) > const2big(arg2, signed2, undef_bit_pos);
+	int undef_bit_pos = -1, cmp;
+	bool y = const_compare_words(arg1, arg2, signed1, signed2, cmp) ? cmp > 0 :
+			const2big(arg1, signed1, undef_bit_pos) > const2big(arg2, signed2, undef_bit_pos);
 	RTLIL::Const result(undef_bit_pos >= 0 ? RTLIL::State::Sx : y ? RTLIL::State::S1 : RTLIL::State::S0);
 
 	while (int(result.bits.size()) < result_len)
@@ -450,6 +580,19 @@ RTLIL::Const RTLIL::const_gt(const RTLIL::Const &arg1, const RTLIL::Const &arg2,
 
 RTLIL::Const RTLIL::const_add(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
+	int width = result_len >= 0 ? result_len : max(arg1.bits.size(), arg2.bits.size());
+	std::vector<uint64_t> a, b;
+	if (const2words(arg1, signed1, words_for_width(width), a) && const2words(arg2, signed2, words_for_width(width), b)) {
+		uint64_t carry = 0;
+		for (int i = 0; i < GetSize(a); i++) {
+			uint64_t sum = a[i] + carry;
+			carry = sum < carry;
+			a[i] = sum + b[i];
+			carry += a[i] < sum;
+		}
+		return words2const(a, width);
+	}
+
 	int undef_bit_pos = -1;
 	BigInteger y = const2big(arg1, signed1, undef_bit_pos) + const2big(arg2, signed2, undef_bit_pos);
 	return big2const(y, result_len >= 0 ? result_len : max(arg1.bits.size(), arg2.bits.size()), undef_bit_pos);
@@ -457,6 +600,20 @@ RTLIL::Const RTLIL::const_add(const RTLIL::Const &arg1, const RTLIL::Const &arg2
 
 RTLIL::Const RTLIL::const_sub(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
+	int width = result_len >= 0 ? result_len : max(arg1.bits.size(), arg2.bits.size());
+	std::vector<uint64_t> a, b;
+	if (const2words(arg1, signed1, words_for_width(width), a) && const2words(arg2, signed2, words_for_width(width), b)) {
+		uint64_t borrow = 0;
+		for (int i = 0; i < GetSize(a); i++) {
+			uint64_t diff = a[i] - b[i];
+			uint64_t next_borrow = a[i] < b[i];
+			next_borrow |= diff < borrow;
+			a[i] = diff - borrow;
+			borrow = next_borrow;
+		}
+		return words2const(a, width);
+	}
+
 	int undef_bit_pos = -1;
 	BigInteger y = const2big(arg1, signed1, undef_bit_pos) - const2big(arg2, signed2, undef_bit_pos);
 	return big2const(y, result_len >= 0 ? result_len : max(arg1.bits.size(), arg2.bits.size()), undef_bit_pos);
@@ -464,6 +621,36 @@ RTLIL::Const RTLIL::const_sub(const RTLIL::Const &arg1, const RTLIL::Const &arg2
 
 RTLIL::Const RTLIL::const_mul(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
+	// the low bits of a product only depend on the low bits of the
+	// (extended) operands, so only the result width has to be computed
+	int width = result_len >= 0 ? result_len : max(arg1.bits.size(), arg2.bits.size());
+	std::vector<uint64_t> a, b;
+	if (const2words(arg1, signed1, words_for_width(width), a) && const2words(arg2, signed2, words_for_width(width), b)) {
+		if (GetSize(a) <= 1) {
+			if (!a.empty())
+				a[0] *= b[0];
+			return words2const(a, width);
+		}
+		// schoolbook multiplication on 32 bit limbs, truncated to the result
+		int num_limbs = 2 * GetSize(a);
+		auto limb = [](const std::vector<uint64_t> &w, int i) { return (w[i / 2] >> (32 * (i % 2))) & 0xffffffff; };
+		std::vector<uint64_t> y(GetSize(a));
+		std::vector<uint32_t> acc(num_limbs);
+		for (int i = 0; i < num_limbs; i++) {
+			uint64_t carry = 0, limb_a = limb(a, i);
+			if (limb_a == 0)
+				continue;
+			for (int j = 0; i + j < num_limbs; j++) {
+				uint64_t t = limb_a * limb(b, j) + acc[i + j] + carry;
+				acc[i + j] = uint32_t(t);
+				carry = t >> 32;
+			}
+		}
+		for (int i = 0; i < num_limbs; i++)
+			y[i / 2] |= uint64_t(acc[i]) << (32 * (i % 2));
+		return words2const(y, width);
+	}
+
 	int undef_bit_pos = -1;
 	BigInteger y = const2big(arg1, signed1, undef_bit_pos) * const2big(arg2, signed2, undef_bit_pos);
 	return big2const(y, result_len >= 0 ? result_len : max(arg1.bits.size(), arg2.bits.size()), min(undef_bit_pos, 0));
@@ -472,6 +659,11 @@ RTLIL::Const RTLIL::const_mul(const RTLIL::Const &arg1, const RTLIL::Const &arg2
 // truncating division
 RTLIL::Const RTLIL::const_div(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
+	bool neg_a, neg_b;
+	uint64_t mag_a, mag_b;
+	if (const2mag(arg1, signed1, neg_a, mag_a) && const2mag(arg2, signed2, neg_b, mag_b) && mag_b != 0)
+		return mag2const(neg_a != neg_b, mag_a / mag_b, result_len >= 0 ? result_len : max(arg1.bits.size(), arg2.bits.size()));
+
 	int undef_bit_pos = -1;
 	BigInteger a = const2big(arg1, signed1, undef_bit_pos);
 	BigInteger b = const2big(arg2, signed2, undef_bit_pos);
@@ -486,6 +678,11 @@ RTLIL::Const RTLIL::const_div(const RTLIL::Const &arg1, const RTLIL::Const &arg2
 // truncating modulo
 RTLIL::Const RTLIL::const_mod(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
+	bool neg_a, neg_b;
+	uint64_t mag_a, mag_b;
+	if (const2mag(arg1, signed1, neg_a, mag_a) && const2mag(arg2, signed2, neg_b, mag_b) && mag_b != 0)
+		return mag2const(neg_a, mag_a % mag_b, result_len >= 0 ? result_len : max(arg1.bits.size(), arg2.bits.size()));
+
 	int undef_bit_pos = -1;
 	BigInteger a = const2big(arg1, signed1, undef_bit_pos);
 	BigInteger b = const2big(arg2, signed2, undef_bit_pos);
@@ -499,6 +696,15 @@ RTLIL::Const RTLIL::const_mod(const RTLIL::Const &arg1, const RTLIL::Const &arg2
 
 RTLIL::Const RTLIL::const_divfloor(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
+	bool neg_a, neg_b;
+	uint64_t mag_a, mag_b;
+	if (const2mag(arg1, signed1, neg_a, mag_a) && const2mag(arg2, signed2, neg_b, mag_b) && mag_b != 0) {
+		int width = result_len >= 0 ? result_len : max(arg1.bits.size(), arg2.bits.size());
+		if (neg_a == neg_b || mag_a == 0)
+			return mag2const(false, mag_a / mag_b, width);
+		return mag2const(true, mag_a / mag_b + (mag_a % mag_b != 0), width);
+	}
+
 	int undef_bit_pos = -1;
 	BigInteger a = const2big(arg1, signed1, undef_bit_pos);
 	BigInteger b = const2big(arg2, signed2, undef_bit_pos);
@@ -521,6 +727,16 @@ RTLIL::Const RTLIL::const_divfloor(const RTLIL::Const &arg1, const RTLIL::Const
 
 RTLIL::Const RTLIL::const_modfloor(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
+	bool neg_a, neg_b;
+	uint64_t mag_a, mag_b;
+	if (const2mag(arg1, signed1, neg_a, mag_a) && const2mag(arg2, signed2, neg_b, mag_b) && mag_b != 0) {
+		int width = result_len >= 0 ? result_len : max(arg1.bits.size(), arg2.bits.size());
+		uint64_t truncated = mag_a % mag_b;
+		if (truncated == 0 || neg_a == neg_b)
+			return mag2const(neg_a, truncated, width);
+		return mag2const(neg_b, mag_b - truncated, width);
+	}
+
 	int undef_bit_pos = -1;
 	BigInteger a = const2big(arg1, signed1, undef_bit_pos);
 	BigInteger b = const2big(arg2, signed2, undef_bit_pos);
@@ -544,6 +760,29 @@ RTLIL::Const RTLIL::const_modfloor(const RTLIL::Const &arg1, const RTLIL::Const
 
 RTLIL::Const RTLIL::const_pow(const RTLIL::Const &arg1, const RTLIL::Const &arg2, bool signed1, bool signed2, int result_len)
 {
+	// with a result of up to 64 bits, computing modulo 2^64 is enough
+	int width = result_len >= 0 ? result_len : max(arg1.bits.size(), arg2.bits.size());
+	bool neg_a, neg_b;
+	uint64_t mag_a, mag_b;
+	if (width <= 64 && const2mag(arg1, signed1, neg_a, mag_a) && const2mag(arg2, signed2, neg_b, mag_b) && mag_a != 0) {
+		uint64_t y = 1;
+		if (neg_b && mag_b != 0) {
+			if (mag_a != 1)
+				y = 0;
+			else if (neg_a && mag_b % 2 == 1)
+				y = 0 - y;
+		} else {
+			for (uint64_t a = mag_a, b = mag_b; b > 0; b = b / 2) {
+				if (b % 2 == 1)
+					y *= a;
+				a *= a;
+			}
+			if (neg_a && mag_b % 2 == 1)
+				y = 0 - y;
+		}
+		return mag2const(false, y, width);
+	}
+
 	int undef_bit_pos = -1;
 
 	BigInteger a = const2big(arg1, signed1, undef_bit_pos);
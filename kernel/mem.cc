@@ -653,11 +653,11 @@ namespace {
 				} else {
 					init.en = RTLIL::Const(State::S1, mem->width);
 				}
-				inits.push_back(std::make_pair(cell->parameters.at(ID::PRIORITY).as_int(), init));
+				inits.push_back(std::make_pair(cell->parameters.at(ID::PRIORITY).as_int(), std::move(init)));
 			}
 			std::sort(inits.begin(), inits.end(), [](const std::pair<int, MemInit> &a, const std::pair<int, MemInit> &b) { return a.first < b.first; });
 			for (auto &it : inits)
-				res.inits.push_back(it.second);
+				res.inits.push_back(std::move(it.second));
 		}
 		for (int i = 0; i < GetSize(res.rd_ports); i++) {
 			auto &port = res.rd_ports[i];
@@ -705,16 +705,21 @@ namespace {
 		res.attributes = cell->attributes;
 		Const &init = cell->parameters.at(ID::INIT);
 		if (!init.is_fully_undef()) {
+			// bits beyond the end of the INIT parameter count as undefined
+			auto word_undef = [&](int pos) {
+				for (int i = pos * res.width; i < (pos + 1) * res.width && i < GetSize(init); i++)
+					if (init.bits[i] != State::Sx && init.bits[i] != State::Sz)
+						return false;
+				return true;
+			};
 			int pos = 0;
 			while (pos < res.size) {
-				Const word = init.extract(pos * res.width, res.width, State::Sx);
-				if (word.is_fully_undef()) {
+				if (word_undef(pos)) {
 					pos++;
 				} else {
 					int epos;
 					for (epos = pos; epos < res.size; epos++) {
-						Const eword = init.extract(epos * res.width, res.width, State::Sx);
-						if (eword.is_fully_undef())
+						if (word_undef(epos))
 							break;
 					}
 					MemInit minit;
@@ -19,6 +19,10 @@
 
 #include "kernel/yosys.h"
 #include "kernel/satgen.h"
+#include "libs/ezsat/ezcmdline.h"
+#ifdef YOSYS_ENABLE_IPASIR
+#  include "libs/ezsat/ezipasir.h"
+#endif
 
 #include <string.h>
 #include <stdlib.h>
@@ -992,4 +996,108 @@ struct MinisatSatSolver : public SatSolver {
 	}
 } MinisatSatSolver;
 
+#ifdef YOSYS_ENABLE_IPASIR
+struct IpasirSatSolver : public SatSolver {
+	IpasirSatSolver() : SatSolver("ipasir") {
+		yosys_satsolver = this;
+	}
+	ezSAT *create() override {
+		return new ezIpasirSAT();
+	}
+} IpasirSatSolver;
+#endif
+
+struct CmdlineSatSolver : public SatSolver {
+	std::string command;
+	CmdlineSatSolver() : SatSolver("cmdline") {
+#ifdef YOSYS_SATSOLVER_CMDLINE
+		command = YOSYS_SATSOLVER_CMDLINE;
+		yosys_satsolver = this;
+#endif
+	}
+	ezSAT *create() override {
+		if (command.empty())
+			log_error("No command set for the 'cmdline' SAT solver. Use 'satsolver cmdline -cmd <command>'.\n");
+		return new ezCmdlineSAT(command);
+	}
+} CmdlineSatSolver;
+
+struct SatSolverPass : public Pass {
+	SatSolverPass() : Pass("satsolver", "select the SAT solver used by the internal SAT passes") { }
+	void help() override
+	{
+		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
+		log("\n");
+		log("    satsolver [<name>] [-cmd <command>]\n");
+		log("\n");
+		log("Select the SAT solver backend used by all internal SAT users ('sat', 'freduce',\n");
+		log("'equiv_*', 'opt_dff -sat', 'memory_share', ...). Without arguments, the\n");
+		log("available backends are listed and the selected one is marked.\n");
+		log("\n");
+		log("    minisat\n");
+		log("        The bundled MiniSAT solver, used incrementally. (default)\n");
+		log("\n");
+		log("    ipasir\n");
+		log("        An incremental solver with the IPASIR interface, e.g. CaDiCaL, linked\n");
+		log("        in-process. The solver keeps its learned clauses between queries and\n");
+		log("        assumptions are passed natively. Only available when built with\n");
+		log("        ENABLE_IPASIR=1 and IPASIR_LIB set to the solver library, and then\n");
+		log("        used by default.\n");
+		log("\n");
+		log("    cmdline -cmd <command>\n");
+		log("        An external solver reading a DIMACS file whose name is appended to\n");
+		log("        <command> and printing its result in SAT competition format, e.g.\n");
+		log("        'cadical -q' or 'kissat -q'. This backend is not incremental: the\n");
+		log("        solver is restarted on the full CNF for each query, assumptions are\n");
+		log("        passed as unit clauses and nothing learned is kept between queries.\n");
+		log("        This makes it slow for incremental users such as 'sat -tempinduct'\n");
+		log("        or 'equiv_simple -batch'. Use the Makefile variable SATSOLVER_CMDLINE\n");
+		log("        to make it the default at build time.\n");
+		log("\n");
+	}
+	void execute(std::vector<std::string> args, RTLIL::Design*) override
+	{
+		std::string name, command;
+		bool set_command = false;
+
+		size_t argidx;
+		for (argidx = 1; argidx < args.size(); argidx++) {
+			if (args[argidx] == "-cmd" && argidx+1 < args.size()) {
+				command = args[++argidx];
+				set_command = true;
+				continue;
+			}
+			if (name.empty() && args[argidx].compare(0, 1, "-") != 0) {
+				name = args[argidx];
+				continue;
+			}
+			break;
+		}
+		if (argidx != args.size())
+			cmd_error(args, argidx, "Unexpected argument.");
+
+		if (set_command) {
+			if (!name.empty() && name != CmdlineSatSolver.name)
+				log_cmd_error("Option -cmd is only supported for the '%s' solver.\n", CmdlineSatSolver.name.c_str());
+			CmdlineSatSolver.command = command;
+			name = CmdlineSatSolver.name;
+		}
+
+		if (!name.empty()) {
+			SatSolver *solver = yosys_satsolver_list;
+			while (solver != nullptr && solver->name != name)
+				solver = solver->next;
+			if (solver == nullptr)
+				log_cmd_error("Unknown SAT solver '%s'.\n", name.c_str());
+			if (solver == &CmdlineSatSolver && CmdlineSatSolver.command.empty())
+				log_cmd_error("No command set for the '%s' SAT solver.\n", name.c_str());
+			yosys_satsolver = solver;
+		}
+
+		for (SatSolver *solver = yosys_satsolver_list; solver != nullptr; solver = solver->next)
+			log("%s %s%s\n", solver == yosys_satsolver ? "*" : " ", solver->name.c_str(),
+					solver == &CmdlineSatSolver && !CmdlineSatSolver.command.empty() ? stringf(" (%s)", CmdlineSatSolver.command.c_str()).c_str() : "");
+	}
+} SatSolverPass;
+
 YOSYS_NAMESPACE_END
@@ -657,6 +657,10 @@ namespace RTLIL
 struct RTLIL::Const
 {
 	int flags;
+	// One byte per bit. A packed value word vector with an optional x/z mask
+	// (and with it a shared storage for memory init images) is a planned
+	// follow-up: it first needs every direct user of this member to go through
+	// accessors, so that the storage can change behind them.
 	std::vector<RTLIL::State> bits;
 
 	Const() : flags(RTLIL::CONST_FLAG_NONE) {}
@@ -1074,6 +1078,10 @@ struct RTLIL::Design
 	dict<RTLIL::IdString, RTLIL::Selection> selection_vars;
 	std::string selected_active_module;
 
+	// parsed input files that later commands on this design reuse (e.g. by
+	// LibertyCache), freed with the design and by 'design -reset'
+	dict<std::string, std::shared_ptr<void>> parsed_files;
+
 	Design();
 	~Design();
 
@@ -1388,3 +1388,356 @@ bool SatGen::importCell(RTLIL::Cell *cell, int timestep)
 	// .. and all sequential cells with asynchronous inputs
 	return false;
 }
+
+static std::vector<int> taint_mux(ezSAT *ez, int s, int taint_s, const std::vector<int> &a, const std::vector<int> &taint_a, const std::vector<int> &b, const std::vector<int> &taint_b)
+{
+	std::vector<int> unequal_ab = ez->vec_not(ez->vec_iff(a, b));
+	std::vector<int> taint_ab = ez->vec_or(unequal_ab, ez->vec_or(taint_a, taint_b));
+	return ez->vec_ite(taint_s, taint_ab, ez->vec_ite(s, taint_b, taint_a));
+}
+
+bool SatGen::importCellTaint(RTLIL::Cell *cell, int timestep)
+{
+	// The taint model is built on top of the two-valued value model.
+	log_assert(!model_undef);
+
+	if (cell->type.in(ID($_AND_), ID($_NAND_), ID($_OR_), ID($_NOR_), ID($_XOR_), ID($_XNOR_), ID($_ANDNOT_), ID($_ORNOT_),
+			ID($and), ID($or), ID($xor), ID($xnor)))
+	{
+		std::vector<int> a = importSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> b = importSigSpec(cell->getPort(ID::B), timestep);
+		std::vector<int> y = importSigSpec(cell->getPort(ID::Y), timestep);
+		extendSignalWidth(a, b, y, cell);
+
+		std::vector<int> taint_a = importTaintSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> taint_b = importTaintSigSpec(cell->getPort(ID::B), timestep);
+		std::vector<int> taint_y = importTaintSigSpec(cell->getPort(ID::Y), timestep);
+		extendSignalWidth(taint_a, taint_b, taint_y, cell);
+
+		// An input that is untainted and holds the controlling value masks the taint of the other input.
+		std::vector<int> yT;
+		if (cell->type.in(ID($and), ID($_AND_), ID($_NAND_))) {
+			std::vector<int> a0 = ez->vec_and(ez->vec_not(a), ez->vec_not(taint_a));
+			std::vector<int> b0 = ez->vec_and(ez->vec_not(b), ez->vec_not(taint_b));
+			yT = ez->vec_and(ez->vec_or(taint_a, taint_b), ez->vec_not(ez->vec_or(a0, b0)));
+		}
+		else if (cell->type.in(ID($or), ID($_OR_), ID($_NOR_))) {
+			std::vector<int> a1 = ez->vec_and(a, ez->vec_not(taint_a));
+			std::vector<int> b1 = ez->vec_and(b, ez->vec_not(taint_b));
+			yT = ez->vec_and(ez->vec_or(taint_a, taint_b), ez->vec_not(ez->vec_or(a1, b1)));
+		}
+		else if (cell->type.in(ID($xor), ID($xnor), ID($_XOR_), ID($_XNOR_))) {
+			yT = ez->vec_or(taint_a, taint_b);
+		}
+		else if (cell->type == ID($_ANDNOT_)) {
+			std::vector<int> a0 = ez->vec_and(ez->vec_not(a), ez->vec_not(taint_a));
+			std::vector<int> b1 = ez->vec_and(b, ez->vec_not(taint_b));
+			yT = ez->vec_and(ez->vec_or(taint_a, taint_b), ez->vec_not(ez->vec_or(a0, b1)));
+		}
+		else if (cell->type == ID($_ORNOT_)) {
+			std::vector<int> a1 = ez->vec_and(a, ez->vec_not(taint_a));
+			std::vector<int> b0 = ez->vec_and(ez->vec_not(b), ez->vec_not(taint_b));
+			yT = ez->vec_and(ez->vec_or(taint_a, taint_b), ez->vec_not(ez->vec_or(a1, b0)));
+		}
+		else
+			log_abort();
+
+		ez->assume(ez->vec_eq(yT, taint_y));
+		return true;
+	}
+
+	if (cell->type.in(ID($add), ID($sub)))
+	{
+		std::vector<int> taint_a = importTaintSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> taint_b = importTaintSigSpec(cell->getPort(ID::B), timestep);
+		std::vector<int> taint_y = importTaintSigSpec(cell->getPort(ID::Y), timestep);
+		extendSignalWidth(taint_a, taint_b, taint_y, cell);
+
+		// Taint only travels towards the more significant bits through the carry chain.
+		int carry = ez->CONST_FALSE;
+		for (size_t i = 0; i < taint_y.size(); i++) {
+			carry = ez->OR(carry, ez->OR(taint_a.at(i), taint_b.at(i)));
+			ez->SET(carry, taint_y.at(i));
+		}
+		return true;
+	}
+
+	if (cell->type.in(ID($_NOT_), ID($not), ID($pos), ID($neg), ID($_BUF_), ID($equiv)))
+	{
+		std::vector<int> taint_a = importTaintSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> taint_y = importTaintSigSpec(cell->getPort(ID::Y), timestep);
+		extendSignalWidthUnary(taint_a, taint_y, cell);
+
+		if (cell->type == ID($neg)) {
+			int carry = ez->CONST_FALSE;
+			for (size_t i = 0; i < taint_y.size(); i++) {
+				carry = ez->OR(carry, taint_a.at(i));
+				ez->SET(carry, taint_y.at(i));
+			}
+		} else
+			ez->assume(ez->vec_eq(taint_a, taint_y));
+		return true;
+	}
+
+	if (cell->type.in(ID($_MUX_), ID($mux), ID($_NMUX_), ID($bwmux)))
+	{
+		std::vector<int> a = importSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> b = importSigSpec(cell->getPort(ID::B), timestep);
+		std::vector<int> s = importSigSpec(cell->getPort(ID::S), timestep);
+		std::vector<int> taint_a = importTaintSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> taint_b = importTaintSigSpec(cell->getPort(ID::B), timestep);
+		std::vector<int> taint_s = importTaintSigSpec(cell->getPort(ID::S), timestep);
+		std::vector<int> taint_y = importTaintSigSpec(cell->getPort(ID::Y), timestep);
+
+		std::vector<int> unequal_ab = ez->vec_not(ez->vec_iff(a, b));
+		std::vector<int> taint_ab = ez->vec_or(unequal_ab, ez->vec_or(taint_a, taint_b));
+		std::vector<int> yT;
+		if (cell->type == ID($bwmux))
+			yT = ez->vec_ite(taint_s, taint_ab, ez->vec_ite(s, taint_b, taint_a));
+		else
+			yT = ez->vec_ite(taint_s.at(0), taint_ab, ez->vec_ite(s.at(0), taint_b, taint_a));
+		ez->assume(ez->vec_eq(yT, taint_y));
+		return true;
+	}
+
+	if (cell->type == ID($pmux))
+	{
+		std::vector<int> s = importSigSpec(cell->getPort(ID::S), timestep);
+		std::vector<int> taint_a = importTaintSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> taint_b = importTaintSigSpec(cell->getPort(ID::B), timestep);
+		std::vector<int> taint_s = importTaintSigSpec(cell->getPort(ID::S), timestep);
+		std::vector<int> taint_y = importTaintSigSpec(cell->getPort(ID::Y), timestep);
+
+		// A tainted select bit conservatively taints the whole output.
+		std::vector<int> taint_tmp = taint_a;
+		for (size_t i = 0; i < s.size(); i++) {
+			std::vector<int> part_of_taint_b(taint_b.begin()+i*taint_a.size(), taint_b.begin()+(i+1)*taint_a.size());
+			taint_tmp = ez->vec_ite(s.at(i), part_of_taint_b, taint_tmp);
+		}
+		int any_taint_s = ez->expression(ezSAT::OpOr, taint_s);
+		taint_tmp = ez->vec_or(taint_tmp, std::vector<int>(taint_a.size(), any_taint_s));
+
+		ez->assume(ez->vec_eq(taint_tmp, taint_y));
+		return true;
+	}
+
+	if (cell->type.in(ID($reduce_and), ID($reduce_or), ID($reduce_xor), ID($reduce_xnor), ID($reduce_bool), ID($logic_not)))
+	{
+		std::vector<int> a = importSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> taint_a = importTaintSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> taint_y = importTaintSigSpec(cell->getPort(ID::Y), timestep);
+		int aT = ez->expression(ezSAT::OpOr, taint_a);
+
+		if (cell->type == ID($reduce_and)) {
+			int a0 = ez->expression(ezSAT::OpOr, ez->vec_and(ez->vec_not(a), ez->vec_not(taint_a)));
+			ez->assume(ez->IFF(ez->AND(ez->NOT(a0), aT), taint_y.at(0)));
+		}
+		else if (cell->type.in(ID($reduce_or), ID($reduce_bool), ID($logic_not))) {
+			int a1 = ez->expression(ezSAT::OpOr, ez->vec_and(a, ez->vec_not(taint_a)));
+			ez->assume(ez->IFF(ez->AND(ez->NOT(a1), aT), taint_y.at(0)));
+		}
+		else if (cell->type.in(ID($reduce_xor), ID($reduce_xnor))) {
+			ez->assume(ez->IFF(aT, taint_y.at(0)));
+		} else
+			log_abort();
+
+		for (size_t i = 1; i < taint_y.size(); i++)
+			ez->SET(ez->CONST_FALSE, taint_y.at(i));
+		return true;
+	}
+
+	if (cell->type.in(ID($logic_and), ID($logic_or)))
+	{
+		std::vector<int> vec_a = importSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> vec_b = importSigSpec(cell->getPort(ID::B), timestep);
+		std::vector<int> taint_a = importTaintSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> taint_b = importTaintSigSpec(cell->getPort(ID::B), timestep);
+		std::vector<int> taint_y = importTaintSigSpec(cell->getPort(ID::Y), timestep);
+
+		int a0 = ez->NOT(ez->OR(ez->expression(ezSAT::OpOr, vec_a), ez->expression(ezSAT::OpOr, taint_a)));
+		int b0 = ez->NOT(ez->OR(ez->expression(ezSAT::OpOr, vec_b), ez->expression(ezSAT::OpOr, taint_b)));
+		int a1 = ez->expression(ezSAT::OpOr, ez->vec_and(vec_a, ez->vec_not(taint_a)));
+		int b1 = ez->expression(ezSAT::OpOr, ez->vec_and(vec_b, ez->vec_not(taint_b)));
+		int aT = ez->expression(ezSAT::OpOr, taint_a);
+		int bT = ez->expression(ezSAT::OpOr, taint_b);
+
+		if (cell->type == ID($logic_and))
+			ez->SET(ez->AND(ez->OR(aT, bT), ez->NOT(a0), ez->NOT(b0)), taint_y.at(0));
+		else
+			ez->SET(ez->AND(ez->OR(aT, bT), ez->NOT(a1), ez->NOT(b1)), taint_y.at(0));
+
+		for (size_t i = 1; i < taint_y.size(); i++)
+			ez->SET(ez->CONST_FALSE, taint_y.at(i));
+		return true;
+	}
+
+	if (cell->type.in(ID($lt), ID($le), ID($eq), ID($ne), ID($eqx), ID($nex), ID($ge), ID($gt)))
+	{
+		std::vector<int> a = importSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> b = importSigSpec(cell->getPort(ID::B), timestep);
+		extendSignalWidth(a, b, cell);
+
+		std::vector<int> taint_a = importTaintSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> taint_b = importTaintSigSpec(cell->getPort(ID::B), timestep);
+		std::vector<int> taint_y = importTaintSigSpec(cell->getPort(ID::Y), timestep);
+		extendSignalWidth(taint_a, taint_b, cell);
+
+		std::vector<int> taint_ab = ez->vec_or(taint_a, taint_b);
+		int yT = ez->expression(ezSAT::OpOr, taint_ab);
+
+		// Equality is decided by any untainted pair of differing bits.
+		if (cell->type.in(ID($eq), ID($ne), ID($eqx), ID($nex))) {
+			std::vector<int> untainted_ne = ez->vec_and(ez->vec_not(ez->vec_iff(a, b)), ez->vec_not(taint_ab));
+			yT = ez->AND(yT, ez->NOT(ez->expression(ezSAT::OpOr, untainted_ne)));
+		}
+
+		ez->SET(yT, taint_y.at(0));
+		for (size_t i = 1; i < taint_y.size(); i++)
+			ez->SET(ez->CONST_FALSE, taint_y.at(i));
+		return true;
+	}
+
+	if (cell->type.in(ID($shl), ID($shr), ID($sshl), ID($sshr), ID($shift), ID($shiftx)))
+	{
+		std::vector<int> b = importSigSpec(cell->getPort(ID::B), timestep);
+		std::vector<int> taint_a = importTaintSigSpec(cell->getPort(ID::A), timestep);
+		std::vector<int> taint_b = importTaintSigSpec(cell->getPort(ID::B), timestep);
+		std::vector<int> taint_y = importTaintSigSpec(cell->getPort(ID::Y), timestep);
+		std::vector<int> taint_a_shifted;
+
+		int extend_bit = ez->CONST_FALSE;
+		if (cell->parameters[ID::A_SIGNED].as_bool())
+			extend_bit = taint_a.back();
+
+		while (taint_y.size() < taint_a.size())
+			taint_y.push_back(ez->literal());
+		while (taint_y.size() > taint_a.size())
+			taint_a.push_back(extend_bit);
+
+		if (cell->type.in(ID($shl), ID($sshl)))
+			taint_a_shifted = ez->vec_shift_left(taint_a, b, false, ez->CONST_FALSE, ez->CONST_FALSE);
+
+		if (cell->type == ID($shr))
+			taint_a_shifted = ez->vec_shift_right(taint_a, b, false, ez->CONST_FALSE, ez->CONST_FALSE);
+
+		if (cell->type == ID($sshr))
+			taint_a_shifted = ez->vec_shift_right(taint_a, b, false, cell->parameters[ID::A_SIGNED].as_bool() ? taint_a.back() : ez->CONST_FALSE, ez->CONST_FALSE);
+
+		if (cell->type.in(ID($shift), ID($shiftx)))
+			taint_a_shifted = ez->vec_shift_right(taint_a, b, cell->parameters[ID::B_SIGNED].as_bool(), ez->CONST_FALSE, ez->CONST_FALSE);
+
+		// A tainted shift amount conservatively taints the whole output.
+		int taint_any_b = ez->expression(ezSAT::OpOr, taint_b);
+		std::vector<int> taint_all_y_bits(taint_y.size(), taint_any_b);
+		ez->assume(ez->vec_eq(ez->vec_or(taint_a_shifted, taint_all_y_bits), taint_y));
+		return true;
+	}
+
+	if (cell->type == ID($slice))
+	{
+		RTLIL::SigSpec a = cell->getPort(ID::A);
+		RTLIL::SigSpec y = cell->getPort(ID::Y);
+		ez->assume(ez->vec_eq(importTaintSigSpec(a.extract(cell->parameters.at(ID::OFFSET).as_int(), y.size()), timestep), importTaintSigSpec(y, timestep)));
+		return true;
+	}
+
+	if (cell->type == ID($concat))
+	{
+		RTLIL::SigSpec a = cell->getPort(ID::A);
+		RTLIL::SigSpec b = cell->getPort(ID::B);
+		RTLIL::SigSpec y = cell->getPort(ID::Y);
+
+		RTLIL::SigSpec ab = a;
+		ab.append(b);
+
+		ez->assume(ez->vec_eq(importTaintSigSpec(ab, timestep), importTaintSigSpec(y, timestep)));
+		return true;
+	}
+
+	if (timestep > 0 && (RTLIL::builtin_ff_cell_types().count(cell->type) || cell->type == ID($anyinit)))
+	{
+		FfData ff(nullptr, cell);
+
+		// Latches and FFs with async inputs are not supported — use clk2fflogic or async2sync first.
+		if (ff.has_aload || ff.has_arst || ff.has_sr)
+			return false;
+
+		// The initial taint of the FFs is decided by the caller.
+		if (timestep == 1)
+			return true;
+
+		std::vector<int> d = importSigSpec(cell->getPort(ID::D), timestep-1);
+		std::vector<int> taint_d = importTaintSigSpec(cell->getPort(ID::D), timestep-1);
+		if (ff.has_srst && ff.has_ce && ff.ce_over_srst) {
+			int srst = importSigSpec(ff.sig_srst, timestep-1).at(0);
+			int taint_srst = importTaintSigSpec(ff.sig_srst, timestep-1).at(0);
+			std::vector<int> rval = importSigSpec(ff.val_srst, timestep-1);
+			std::vector<int> taint_rval = importTaintSigSpec(ff.val_srst, timestep-1);
+			if (ff.pol_srst) {
+				taint_d = taint_mux(ez, srst, taint_srst, d, taint_d, rval, taint_rval);
+				d = ez->vec_ite(srst, rval, d);
+			} else {
+				taint_d = taint_mux(ez, srst, taint_srst, rval, taint_rval, d, taint_d);
+				d = ez->vec_ite(srst, d, rval);
+			}
+		}
+		if (ff.has_ce) {
+			int ce = importSigSpec(ff.sig_ce, timestep-1).at(0);
+			int taint_ce = importTaintSigSpec(ff.sig_ce, timestep-1).at(0);
+			std::vector<int> old_q = importSigSpec(ff.sig_q, timestep-1);
+			std::vector<int> taint_old_q = importTaintSigSpec(ff.sig_q, timestep-1);
+			if (ff.pol_ce) {
+				taint_d = taint_mux(ez, ce, taint_ce, old_q, taint_old_q, d, taint_d);
+				d = ez->vec_ite(ce, d, old_q);
+			} else {
+				taint_d = taint_mux(ez, ce, taint_ce, d, taint_d, old_q, taint_old_q);
+				d = ez->vec_ite(ce, old_q, d);
+			}
+		}
+		if (ff.has_srst && !(ff.has_ce && ff.ce_over_srst)) {
+			int srst = importSigSpec(ff.sig_srst, timestep-1).at(0);
+			int taint_srst = importTaintSigSpec(ff.sig_srst, timestep-1).at(0);
+			std::vector<int> rval = importSigSpec(ff.val_srst, timestep-1);
+			std::vector<int> taint_rval = importTaintSigSpec(ff.val_srst, timestep-1);
+			if (ff.pol_srst)
+				taint_d = taint_mux(ez, srst, taint_srst, d, taint_d, rval, taint_rval);
+			else
+				taint_d = taint_mux(ez, srst, taint_srst, rval, taint_rval, d, taint_d);
+		}
+
+		std::vector<int> taint_q = importTaintSigSpec(cell->getPort(ID::Q), timestep);
+		ez->assume(ez->vec_eq(taint_d, taint_q));
+		return true;
+	}
+
+	if (cell->type.in(ID($anyconst), ID($anyseq), ID($initstate)))
+	{
+		// Unconstrained and solver-controlled values are untainted.
+		for (auto bit : importTaintSigSpec(cell->getPort(ID::Y), timestep))
+			ez->SET(ez->CONST_FALSE, bit);
+		return true;
+	}
+
+	if (cell->type.in(ID($assert), ID($assume), ID($scopeinfo)))
+		return true;
+
+	// Remaining combinational internal cells: any tainted input taints all outputs.
+	if (cell->type.begins_with("$") && !cell->type.begins_with("$mem") && !RTLIL::builtin_ff_cell_types().count(cell->type) &&
+			!cell->type.in(ID($fsm), ID($print), ID($cover), ID($live), ID($fair)) && yosys_celltypes.cell_known(cell->type))
+	{
+		std::vector<int> taint_inputs;
+		for (auto &conn : cell->connections())
+			if (cell->input(conn.first)) {
+				std::vector<int> taint_in = importTaintSigSpec(conn.second, timestep);
+				taint_inputs.insert(taint_inputs.end(), taint_in.begin(), taint_in.end());
+			}
+		int taint_any_input = ez->expression(ezSAT::OpOr, taint_inputs);
+		for (auto &conn : cell->connections())
+			if (cell->output(conn.first))
+				for (auto bit : importTaintSigSpec(conn.second, timestep))
+					ez->SET(taint_any_input, bit);
+		return true;
+	}
+
+	return false;
+}
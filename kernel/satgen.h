@@ -150,6 +150,32 @@ struct SatGen
 		return importSigSpecWorker(bit, pf, true, false).front();
 	}
 
+	std::vector<int> importTaintSigSpec(RTLIL::SigSpec sig, int timestep = -1)
+	{
+		log_assert(timestep != 0);
+		std::string pf = "taint:" + prefix + (timestep == -1 ? "" : stringf("@%d:", timestep));
+		sigmap->apply(sig);
+
+		// Constants never carry taint.
+		std::vector<int> vec;
+		vec.reserve(GetSize(sig));
+
+		for (auto &bit : sig)
+			if (bit.wire == NULL) {
+				vec.push_back(ez->CONST_FALSE);
+			} else {
+				std::string name = pf + (bit.wire->width == 1 ? stringf("%s", log_id(bit.wire)) : stringf("%s [%d]", log_id(bit.wire->name), bit.offset));
+				vec.push_back(ez->frozen_literal(name));
+				imported_signals[pf][bit] = vec.back();
+			}
+		return vec;
+	}
+
+	int importTaintSigBit(RTLIL::SigBit bit, int timestep = -1)
+	{
+		return importTaintSigSpec(bit, timestep).front();
+	}
+
 	bool importedSigBit(RTLIL::SigBit bit, int timestep = -1)
 	{
 		log_assert(timestep != 0);
@@ -288,6 +314,12 @@ struct SatGen
 	}
 
 	bool importCell(RTLIL::Cell *cell, int timestep = -1);
+
+	// Adds the cell-level information flow tracking (CellIFT/GLIFT) constraints of the
+	// cell on top of the value semantics added by importCell(). Returns false if the
+	// cell type is not supported; unknown combinational cells are handled
+	// conservatively by tainting all outputs if any input is tainted.
+	bool importCellTaint(RTLIL::Cell *cell, int timestep = -1);
 };
 
 YOSYS_NAMESPACE_END
@@ -41,6 +41,9 @@
 #  include <unistd.h>
 #  include <dirent.h>
 #  include <sys/stat.h>
+#  if !defined(YOSYS_DISABLE_SPAWN)
+#    include <sys/wait.h>
+#  endif
 #else
 #  include <unistd.h>
 #  include <dirent.h>
@@ -337,6 +340,120 @@ int run_command(const std::string &command, std::function<void(const std::string
 }
 #endif
 
+#if defined(_WIN32) || defined(__wasm) || defined(YOSYS_DISABLE_SPAWN)
+std::vector<std::string> run_worker_processes(int num_workers, std::function<std::string(int)> worker, std::vector<bool> *failed)
+{
+	std::vector<std::string> results;
+	for (int i = 0; i < num_workers; i++)
+		results.push_back(worker(i));
+	if (failed)
+		failed->assign(num_workers, false);
+	return results;
+}
+
+int get_num_cpus()
+{
+	return 1;
+}
+#else
+std::vector<std::string> run_worker_processes(int num_workers, std::function<std::string(int)> worker, std::vector<bool> *failed)
+{
+	std::vector<std::string> results(num_workers);
+
+	if (failed)
+		failed->assign(num_workers, false);
+
+	if (num_workers == 1 && !failed) {
+		results[0] = worker(0);
+		return results;
+	}
+
+	log_flush();
+
+	std::vector<pid_t> pids;
+	std::vector<int> fds;
+
+	for (int i = 0; i < num_workers; i++)
+	{
+		int pipefd[2];
+		if (pipe(pipefd) != 0)
+			log_error("Failed to create pipe for worker process: %s\n", strerror(errno));
+
+		pid_t pid = fork();
+		if (pid < 0)
+			log_error("Failed to fork worker process: %s\n", strerror(errno));
+
+		if (pid == 0)
+		{
+			// The worker's log output would be interleaved with that of the parent.
+			close(pipefd[0]);
+			log_files.clear();
+			log_streams.clear();
+			int status = 0;
+			try {
+				std::string result = worker(i);
+				const char *p = result.data();
+				size_t len = result.size();
+				while (len > 0) {
+					ssize_t n = write(pipefd[1], p, len);
+					if (n < 0) {
+						if (errno == EINTR)
+							continue;
+						status = 1;
+						break;
+					}
+					p += n, len -= n;
+				}
+			} catch (...) {
+				status = 1;
+			}
+			close(pipefd[1]);
+			_exit(status);
+		}
+
+		close(pipefd[1]);
+		pids.push_back(pid);
+		fds.push_back(pipefd[0]);
+	}
+
+	bool any_failed = false;
+	for (int i = 0; i < num_workers; i++)
+	{
+		char buffer[4096];
+		while (1) {
+			ssize_t n = read(fds[i], buffer, sizeof(buffer));
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0)
+				break;
+			results[i].append(buffer, n);
+		}
+		close(fds[i]);
+
+		int status;
+		while (waitpid(pids[i], &status, 0) < 0 && errno == EINTR) { }
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+			any_failed = true;
+			if (failed) {
+				(*failed)[i] = true;
+				results[i].clear();
+			}
+		}
+	}
+
+	if (any_failed && !failed)
+		log_error("Worker process failed.\n");
+
+	return results;
+}
+
+int get_num_cpus()
+{
+	long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	return num_cpus > 0 ? int(num_cpus) : 1;
+}
+#endif
+
 std::string get_base_tmpdir()
 {
 	static std::string tmpdir;
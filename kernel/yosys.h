@@ -339,6 +339,14 @@ bool patmatch(const char *pattern, const char *string);
 #if !defined(YOSYS_DISABLE_SPAWN)
 int run_command(const std::string &command, std::function<void(const std::string&)> process_line = std::function<void(const std::string&)>());
 #endif
+// Runs worker(0) .. worker(num_workers-1) in forked processes that see a
+// copy-on-write snapshot of the design and returns their results in order.
+// Workers must not rely on modifying the design. Runs the workers one after
+// another in this process on platforms without fork(). If `failed` is given,
+// a failing worker (e.g. one that ran into log_error) sets its entry and
+// returns an empty result instead of aborting.
+std::vector<std::string> run_worker_processes(int num_workers, std::function<std::string(int)> worker, std::vector<bool> *failed = nullptr);
+int get_num_cpus();
 std::string get_base_tmpdir();
 std::string make_temp_file(std::string template_str = get_base_tmpdir() + "/yosys_XXXXXX");
 std::string make_temp_dir(std::string template_str = get_base_tmpdir() + "/yosys_XXXXXX");
@@ -0,0 +1,159 @@
+/*
+ *  ezSAT -- A simple and easy to use CNF generator for SAT solvers
+ *
+ *  Copyright (C) 2026  The Yosys contributors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "ezcmdline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _YOSYS_
+#  include "kernel/yosys.h"
+#  define my_error(...) YOSYS_NAMESPACE_PREFIX log_error(__VA_ARGS__)
+#else
+#  define my_error(...) do { fprintf(stderr, "ezCmdlineSAT: " __VA_ARGS__); abort(); } while (0)
+#endif
+
+#ifdef _WIN32
+#  define popen _popen
+#  define pclose _pclose
+#else
+#  include <unistd.h>
+#endif
+
+ezCmdlineSAT::ezCmdlineSAT(const std::string &command) : command(command)
+{
+	// The external solver is restarted for every call, so the full CNF is needed each time.
+	keep_cnf();
+}
+
+ezCmdlineSAT::~ezCmdlineSAT()
+{
+}
+
+bool ezCmdlineSAT::solver(const std::vector<int> &modelExpressions, std::vector<bool> &modelValues, const std::vector<int> &assumptions)
+{
+	preSolverCallback();
+
+	solverTimoutStatus = false;
+
+	std::vector<int> extraClauses, modelIdx;
+
+	for (auto id : assumptions)
+		extraClauses.push_back(bind(id));
+	for (auto id : modelExpressions)
+		modelIdx.push_back(bind(id));
+
+	std::vector<std::vector<int>> cnf;
+	consumeCnf();
+	getFullCnf(cnf);
+
+#if defined(_YOSYS_)
+	std::string cnf_filename = YOSYS_NAMESPACE_PREFIX make_temp_file(YOSYS_NAMESPACE_PREFIX get_base_tmpdir() + "/yosys_ezsat_XXXXXX.cnf");
+	FILE *f = fopen(cnf_filename.c_str(), "w");
+#elif defined(_WIN32)
+	char *tmpname = _tempnam(NULL, "ezsat");
+	std::string cnf_filename = tmpname;
+	free(tmpname);
+	FILE *f = fopen(cnf_filename.c_str(), "w");
+#else
+	char tmpname[] = "/tmp/ezsat_XXXXXX.cnf";
+	int fd = mkstemps(tmpname, 4);
+	std::string cnf_filename = tmpname;
+	FILE *f = fd < 0 ? NULL : fdopen(fd, "w");
+#endif
+	if (f == NULL)
+		my_error("Can't create temporary CNF file `%s'.\n", cnf_filename.c_str());
+
+	fprintf(f, "p cnf %d %d\n", numCnfVariables(), int(cnf.size() + extraClauses.size()));
+	for (auto &clause : cnf) {
+		for (auto idx : clause)
+			fprintf(f, "%d ", idx);
+		fprintf(f, "0\n");
+	}
+	for (auto idx : extraClauses)
+		fprintf(f, "%d 0\n", idx);
+	fclose(f);
+
+	std::string cmd = command + " " + cnf_filename;
+	if (solverTimeout > 0 && command.find("timeout ") != 0)
+		cmd = "timeout " + std::to_string(solverTimeout) + " " + cmd;
+
+	FILE *p = popen(cmd.c_str(), "r");
+	if (p == NULL) {
+		remove(cnf_filename.c_str());
+		my_error("Failed to run `%s'.\n", cmd.c_str());
+	}
+
+	bool status_sat = false, status_unsat = false;
+	std::vector<int> values(numCnfVariables() + 1, 0);
+
+	std::string line;
+	char buffer[4096];
+	while (fgets(buffer, sizeof(buffer), p) != NULL) {
+		line += buffer;
+		if (line.empty() || line.back() != '\n')
+			continue;
+		if (line.compare(0, 2, "s ") == 0) {
+			status_sat = line.compare(0, 15, "s SATISFIABLE\n") == 0;
+			status_unsat = line.compare(0, 17, "s UNSATISFIABLE\n") == 0;
+		} else if (line.compare(0, 2, "v ") == 0) {
+			char *cursor = &line[1];
+			while (1) {
+				char *endptr;
+				long lit = strtol(cursor, &endptr, 10);
+				if (endptr == cursor || lit == 0)
+					break;
+				if (labs(lit) < long(values.size()))
+					values[labs(lit)] = lit > 0 ? 1 : -1;
+				cursor = endptr;
+			}
+		}
+		line.clear();
+	}
+	pclose(p);
+	remove(cnf_filename.c_str());
+
+	if (!status_sat && !status_unsat) {
+		// Interrupted by the timeout or the solver failed.
+		solverTimoutStatus = solverTimeout > 0;
+		if (!solverTimoutStatus)
+			my_error("Solver command `%s' did not report a result.\n", cmd.c_str());
+		return false;
+	}
+
+	if (status_unsat)
+		return false;
+
+	modelValues.clear();
+	modelValues.resize(modelIdx.size());
+
+	for (size_t i = 0; i < modelIdx.size(); i++)
+	{
+		int idx = modelIdx[i];
+		bool refvalue = true;
+
+		if (idx < 0)
+			idx = -idx, refvalue = false;
+
+		modelValues[i] = (values.at(idx) > 0) == refvalue;
+	}
+
+	return true;
+}
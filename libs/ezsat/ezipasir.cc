@@ -0,0 +1,121 @@
+/*
+ *  ezSAT -- A simple and easy to use CNF generator for SAT solvers
+ *
+ *  Copyright (C) 2026  The Yosys contributors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "ezipasir.h"
+#include "ipasir.h"
+
+ezIpasirSAT::ezIpasirSAT() : ipasirSolver(NULL), foundContradiction(false), terminateDeadline(0)
+{
+}
+
+ezIpasirSAT::~ezIpasirSAT()
+{
+	if (ipasirSolver != NULL)
+		ipasir_release(ipasirSolver);
+}
+
+void ezIpasirSAT::clear()
+{
+	if (ipasirSolver != NULL) {
+		ipasir_release(ipasirSolver);
+		ipasirSolver = NULL;
+	}
+	foundContradiction = false;
+	ezSAT::clear();
+}
+
+const char *ezIpasirSAT::signature()
+{
+	return ipasir_signature();
+}
+
+int ezIpasirSAT::terminateCallback(void *state)
+{
+	ezIpasirSAT *that = (ezIpasirSAT*)state;
+	return that->terminateDeadline != 0 && clock() > that->terminateDeadline;
+}
+
+bool ezIpasirSAT::solver(const std::vector<int> &modelExpressions, std::vector<bool> &modelValues, const std::vector<int> &assumptions)
+{
+	preSolverCallback();
+
+	solverTimoutStatus = false;
+
+	if (foundContradiction) {
+		consumeCnf();
+		return false;
+	}
+
+	std::vector<int> assumptionIdx, modelIdx;
+
+	for (auto id : assumptions)
+		assumptionIdx.push_back(bind(id));
+	for (auto id : modelExpressions)
+		modelIdx.push_back(bind(id));
+
+	if (ipasirSolver == NULL) {
+		ipasirSolver = ipasir_init();
+		ipasir_set_terminate(ipasirSolver, this, terminateCallback);
+	}
+
+	// IPASIR solvers accept new clauses over any variable at any time, also
+	// after their own preprocessing, so no variables need to be frozen.
+	std::vector<std::vector<int>> cnf;
+	consumeCnf(cnf);
+
+	for (auto &clause : cnf) {
+		for (auto idx : clause)
+			ipasir_add(ipasirSolver, idx);
+		ipasir_add(ipasirSolver, 0);
+	}
+
+	for (auto idx : assumptionIdx)
+		ipasir_assume(ipasirSolver, idx);
+
+	terminateDeadline = solverTimeout > 0 ? clock() + solverTimeout*CLOCKS_PER_SEC : 0;
+	int result = ipasir_solve(ipasirSolver);
+	terminateDeadline = 0;
+
+	if (result == 0) {
+		solverTimoutStatus = true;
+		return false;
+	}
+
+	if (result == 20) {
+		if (assumptionIdx.empty())
+			foundContradiction = true;
+		return false;
+	}
+
+	modelValues.clear();
+	modelValues.resize(modelIdx.size());
+
+	for (size_t i = 0; i < modelIdx.size(); i++)
+	{
+		int idx = modelIdx[i];
+		bool refvalue = true;
+
+		if (idx < 0)
+			idx = -idx, refvalue = false;
+
+		modelValues[i] = (ipasir_val(ipasirSolver, idx) > 0) == refvalue;
+	}
+
+	return true;
+}
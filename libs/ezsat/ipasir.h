@@ -0,0 +1,46 @@
+/*
+ *  ezSAT -- A simple and easy to use CNF generator for SAT solvers
+ *
+ *  Copyright (C) 2026  The Yosys contributors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#ifndef IPASIR_H
+#define IPASIR_H
+
+// The IPASIR interface for incremental SAT solvers from the SAT Race, which is
+// implemented by CaDiCaL, Glucose, Lingeling and others. Only the declarations
+// are needed here, the solver library is linked at build time.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+const char *ipasir_signature();
+void *ipasir_init();
+void ipasir_release(void *solver);
+void ipasir_add(void *solver, int lit_or_zero);
+void ipasir_assume(void *solver, int lit);
+int ipasir_solve(void *solver);
+int ipasir_val(void *solver, int lit);
+int ipasir_failed(void *solver, int lit);
+void ipasir_set_terminate(void *solver, void *state, int (*terminate)(void *state));
+void ipasir_set_learn(void *solver, void *state, int max_length, void (*learn)(void *state, int *clause));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,274 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2026  The Yosys contributors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "kernel/yosys.h"
+#include "kernel/sigtools.h"
+#include "kernel/celltypes.h"
+#include "kernel/utils.h"
+
+USING_YOSYS_NAMESPACE
+PRIVATE_NAMESPACE_BEGIN
+
+struct CoiWorker
+{
+	RTLIL::Design *design;
+	bool opt_blackbox;
+
+	// Output ports of a module that are read by an instance in the cone of
+	// influence of its parent, and modules that contain sinks themselves
+	dict<RTLIL::Module*, pool<RTLIL::IdString>> needed_ports;
+	pool<RTLIL::Module*> has_sinks;
+
+	struct stats_t {
+		int kept = 0, removed = 0;
+		bool blackboxed = false;
+	};
+	dict<RTLIL::Module*, stats_t> stats;
+
+	CoiWorker(RTLIL::Design *design, bool opt_blackbox) : design(design), opt_blackbox(opt_blackbox) { }
+
+	static bool is_property(RTLIL::Cell *cell)
+	{
+		return cell->type.in(ID($assert), ID($assume), ID($cover), ID($live), ID($fair), ID($check));
+	}
+
+	bool module_has_sinks(RTLIL::Module *module)
+	{
+		for (auto wire : module->selected_wires())
+			if (wire->port_output)
+				return true;
+		for (auto cell : module->cells()) {
+			if (is_property(cell) && design->selected(module, cell))
+				return true;
+			RTLIL::Module *sub = design->module(cell->type);
+			if (sub != nullptr && has_sinks.count(sub))
+				return true;
+		}
+		return false;
+	}
+
+	void run(RTLIL::Module *module)
+	{
+		if (module->has_processes_warn())
+			return;
+
+		SigMap sigmap(module);
+		dict<RTLIL::SigBit, std::pair<RTLIL::Cell*, RTLIL::IdString>> drivers;
+		dict<RTLIL::IdString, std::vector<RTLIL::Cell*>> mem_cells;
+		std::vector<RTLIL::SigBit> bit_queue;
+		std::vector<RTLIL::Cell*> cell_queue;
+		pool<RTLIL::Cell*> kept;
+
+		for (auto cell : module->cells())
+		{
+			RTLIL::Module *sub = design->module(cell->type);
+			bool known = yosys_celltypes.cell_known(cell->type) || sub != nullptr;
+
+			for (auto &conn : cell->connections())
+				if (!known || cell->output(conn.first))
+					for (auto bit : sigmap(conn.second))
+						if (bit.wire)
+							drivers[bit] = std::make_pair(cell, conn.first);
+
+			if (cell->has_memid())
+				mem_cells[cell->parameters.at(ID::MEMID).decode_string()].push_back(cell);
+
+			if ((is_property(cell) && design->selected(module, cell)) || (sub != nullptr && has_sinks.count(sub)))
+				cell_queue.push_back(cell);
+		}
+
+		for (auto wire : module->wires())
+			if (wire->port_output && (design->selected(module, wire) || needed_ports[module].count(wire->name)))
+				for (auto bit : sigmap(wire))
+					bit_queue.push_back(bit);
+
+		while (!bit_queue.empty() || !cell_queue.empty())
+		{
+			if (!cell_queue.empty()) {
+				RTLIL::Cell *cell = cell_queue.back();
+				cell_queue.pop_back();
+				if (kept.count(cell))
+					continue;
+				kept.insert(cell);
+
+				RTLIL::Module *sub = design->module(cell->type);
+				bool known = yosys_celltypes.cell_known(cell->type) || sub != nullptr;
+				for (auto &conn : cell->connections())
+					if (!known || !cell->output(conn.first))
+						for (auto bit : sigmap(conn.second))
+							bit_queue.push_back(bit);
+
+				// The read ports of a memory depend on all its write and
+				// init ports
+				if (cell->has_memid())
+					for (auto other : mem_cells.at(cell->parameters.at(ID::MEMID).decode_string()))
+						cell_queue.push_back(other);
+				continue;
+			}
+
+			RTLIL::SigBit bit = bit_queue.back();
+			bit_queue.pop_back();
+			auto it = drivers.find(bit);
+			if (it == drivers.end())
+				continue;
+			RTLIL::Cell *cell = it->second.first;
+			RTLIL::Module *sub = design->module(cell->type);
+			if (sub != nullptr)
+				needed_ports[sub].insert(it->second.second);
+			drivers.erase(it);
+			cell_queue.push_back(cell);
+		}
+
+		auto &st = stats[module];
+		for (auto cell : module->cells().to_vector()) {
+			if (kept.count(cell)) {
+				st.kept++;
+				continue;
+			}
+			RTLIL::Module *sub = design->module(cell->type);
+			if (opt_blackbox && sub != nullptr) {
+				st.kept++;
+				continue;
+			}
+			module->remove(cell);
+			st.removed++;
+		}
+	}
+
+	void blackbox(RTLIL::Module *module)
+	{
+		auto &st = stats[module];
+		st.removed += GetSize(module->cells());
+		st.blackboxed = true;
+
+		for (auto cell : module->cells().to_vector())
+			module->remove(cell);
+		std::vector<RTLIL::Process*> processes;
+		for (auto &it : module->processes)
+			processes.push_back(it.second);
+		for (auto process : processes)
+			module->remove(process);
+		module->new_connections({});
+
+		pool<RTLIL::Wire*> remove_wires;
+		for (auto wire : module->wires())
+			if (!wire->port_id)
+				remove_wires.insert(wire);
+		module->remove(remove_wires);
+
+		module->set_bool_attribute(ID::blackbox);
+	}
+
+	void run()
+	{
+		RTLIL::Module *top = design->top_module();
+
+		TopoSort<RTLIL::Module*, IdString::compare_ptr_by_name<RTLIL::Module>> topo_modules;
+		for (auto module : design->modules()) {
+			if (module->get_blackbox_attribute())
+				continue;
+			topo_modules.node(module);
+			for (auto cell : module->cells()) {
+				RTLIL::Module *sub = design->module(cell->type);
+				if (sub != nullptr && !sub->get_blackbox_attribute())
+					topo_modules.edge(sub, module);
+			}
+		}
+
+		if (!topo_modules.sort())
+			log_error("Cannot compute the cone of influence of a design containing recursive instantiations.\n");
+
+		// Submodules before their parents, to find the modules containing
+		// sinks, then parents before submodules for the cone itself
+		for (auto module : topo_modules.sorted)
+			if (module_has_sinks(module))
+				has_sinks.insert(module);
+
+		for (auto it = topo_modules.sorted.rbegin(); it != topo_modules.sorted.rend(); ++it) {
+			RTLIL::Module *module = *it;
+			if (opt_blackbox && module != top && top != nullptr && !has_sinks.count(module) && needed_ports[module].empty())
+				blackbox(module);
+			else
+				run(module);
+		}
+
+		log("\n");
+		log("  %-40s %10s %10s\n", "module", "kept", "removed");
+		for (auto module : topo_modules.sorted) {
+			auto &st = stats[module];
+			log("  %-40s %10d %10d%s\n", log_id(module), st.kept, st.removed, st.blackboxed ? " (blackboxed)" : "");
+		}
+	}
+};
+
+struct CoiPass : public Pass {
+	CoiPass() : Pass("coi", "reduce the design to the cone of influence of outputs and asserts") { }
+	void help() override
+	{
+		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
+		log("\n");
+		log("    coi [options] [selection]\n");
+		log("\n");
+		log("This pass removes all cells outside the cone of influence of the selected\n");
+		log("sinks. The sinks are the selected output ports and the selected $assert,\n");
+		log("$assume, $cover, $live, $fair and $check cells. For example:\n");
+		log("\n");
+		log("    coi t:$assert                  # keep what the asserts depend on\n");
+		log("    coi top/o:__ASSERT_*           # keep what the assert probes depend on\n");
+		log("\n");
+		log("The cone is followed through FFs, memories (a read port depends on all write\n");
+		log("and init ports of the memory) and the module hierarchy: an instance is kept\n");
+		log("if one of its outputs is in the cone or if its module contains sinks, and\n");
+		log("then only the output ports read by kept instances are kept in the module.\n");
+		log("Cells of unknown type are assumed to drive and read all their ports.\n");
+		log("\n");
+		log("Wires and ports are not removed. Outputs outside the cone are left undriven,\n");
+		log("run opt_clean afterwards to remove the unused wires.\n");
+		log("\n");
+		log("A report of the number of kept and removed cells per module is printed.\n");
+		log("\n");
+		log("    -blackbox\n");
+		log("        keep submodule instances outside the cone of influence, and replace\n");
+		log("        the modules that are not needed anywhere with blackboxes, instead of\n");
+		log("        removing the instances. This keeps the hierarchy and the interfaces.\n");
+		log("\n");
+	}
+	void execute(std::vector<std::string> args, RTLIL::Design *design) override
+	{
+		bool opt_blackbox = false;
+
+		log_header(design, "Executing COI pass (cone of influence reduction).\n");
+
+		size_t argidx;
+		for (argidx = 1; argidx < args.size(); argidx++)
+		{
+			if (args[argidx] == "-blackbox") {
+				opt_blackbox = true;
+				continue;
+			}
+			break;
+		}
+		extra_args(args, argidx, design);
+
+		CoiWorker worker(design, opt_blackbox);
+		worker.run();
+	}
+} CoiPass;
+
+PRIVATE_NAMESPACE_END
@@ -42,7 +42,8 @@ struct DesignPass : public Pass {
 		log("\n");
 		log("    design -reset\n");
 		log("\n");
-		log("Clear the current design.\n");
+		log("Clear the current design. This also frees the parsed files kept for\n");
+		log("reuse by later commands, e.g. liberty files.\n");
 		log("\n");
 		log("\n");
 		log("    design -save <name>\n");
@@ -367,6 +368,7 @@ struct DesignPass : public Pass {
 			design->selection_stack.clear();
 			design->selection_vars.clear();
 			design->selected_active_module.clear();
+			design->parsed_files.clear();
 
 			design->selection_stack.push_back(RTLIL::Selection());
 		}
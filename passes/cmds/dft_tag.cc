@@ -30,8 +30,20 @@ PRIVATE_NAMESPACE_BEGIN
 struct DftTagOptions {
 	bool tag_public = false;
 	bool overwrite_only = false;
+	bool pack_tags = false;
+	std::vector<IdString> port_tags;
+	pool<std::string> excluded_signals;
+	pool<IdString> conjunctive_cells;
 };
 
+static std::string tag_list(const std::vector<std::string> &tag_names)
+{
+	std::string result;
+	for (auto &name : tag_names)
+		result += (result.empty() ? "" : ",") + name;
+	return result;
+}
+
 struct DftTagWorker {
 	Module *module;
 	DftTagOptions options;
@@ -73,6 +85,9 @@ struct DftTagWorker {
 
 	pool<Cell *> warned_cells;
 
+	// Module input bits carrying tags from tag input ports
+	std::vector<std::pair<IdString, SigBit>> port_tag_sources;
+
 	DftTagWorker(Module *module, DftTagOptions options) :
 		module(module), options(options), modwalker(module->design), sigmap(modwalker.sigmap)
 	{
@@ -81,6 +96,110 @@ struct DftTagWorker {
 		tag_sets(tmp_tag_set);
 	}
 
+	void register_tag(IdString tag)
+	{
+		if (!all_tags.insert(tag).second)
+			return;
+		auto group_sep = tag.str().find(':');
+		IdString tag_group = group_sep != std::string::npos ? tag.str().substr(0, group_sep) : tag;
+		tag_groups[tag_group].insert(tag);
+		group_of_tag[tag] = tag_group;
+	}
+
+	bool port_excluded(Wire *wire)
+	{
+		return options.excluded_signals.count(log_id(wire->name)) != 0;
+	}
+
+	// Creates the tag ports for a port wire, either one per tag (named
+	// <portname>_t<index> like the taint ports of cellift) or with -pack-tags
+	// a single one (named <portname>_t) holding the tags side by side.
+	std::vector<SigSpec> add_tag_ports(Wire *wire)
+	{
+		int num_tags = GetSize(options.port_tags);
+		std::vector<SigSpec> result;
+		std::vector<Wire *> tag_wires;
+
+		if (options.pack_tags) {
+			tag_wires.push_back(module->addWire(module->uniquify(stringf("%s_t", wire->name.c_str())), wire->width * num_tags));
+			for (int i = 0; i < num_tags; i++)
+				result.push_back(SigSpec(tag_wires.back()).extract(i * wire->width, wire->width));
+		} else {
+			for (int i = 0; i < num_tags; i++) {
+				tag_wires.push_back(module->addWire(module->uniquify(stringf("%s_t%d", wire->name.c_str(), i)), wire->width));
+				result.push_back(tag_wires.back());
+			}
+		}
+
+		std::vector<std::string> tag_names;
+		for (auto tag : options.port_tags)
+			tag_names.push_back(tag.str().substr(1));
+
+		for (int i = 0; i < GetSize(tag_wires); i++) {
+			auto tag_wire = tag_wires[i];
+			tag_wire->port_input = wire->port_input;
+			tag_wire->port_output = wire->port_output;
+			tag_wire->set_bool_attribute(ID(cellift));
+			tag_wire->set_string_attribute(ID(dft_tag), options.pack_tags ? tag_list(tag_names) : tag_names[i]);
+		}
+
+		return result;
+	}
+
+	void add_input_tag_ports()
+	{
+		if (options.port_tags.empty())
+			return;
+
+		for (auto tag : options.port_tags)
+			register_tag(tag);
+
+		std::vector<Wire *> inputs;
+		for (auto port : module->ports) {
+			auto wire = module->wire(port);
+			if (wire->port_input && !wire->port_output && module->design->selected(module, wire) && !port_excluded(wire))
+				inputs.push_back(wire);
+		}
+
+		for (auto wire : inputs) {
+			auto tag_ports = add_tag_ports(wire);
+			for (int i = 0; i < GetSize(options.port_tags); i++) {
+				auto tag = options.port_tags[i];
+				for (int j = 0; j < wire->width; j++) {
+					SigBit bit = sigmap(SigBit(wire, j));
+					if (!bit.is_wire() || tag_signals.count(std::make_pair(tag, bit)))
+						continue;
+					tag_signals.emplace(std::make_pair(tag, bit), tag_ports[i][j]);
+					port_tag_sources.emplace_back(tag, bit);
+				}
+			}
+		}
+
+		module->fixup_ports();
+	}
+
+	void add_output_tag_ports()
+	{
+		if (options.port_tags.empty())
+			return;
+
+		std::vector<Wire *> outputs;
+		for (auto port : module->ports) {
+			auto wire = module->wire(port);
+			if (wire->port_output && !wire->port_input && !wire->get_bool_attribute(ID(cellift)) &&
+					module->design->selected(module, wire) && !port_excluded(wire))
+				outputs.push_back(wire);
+		}
+
+		for (auto wire : outputs) {
+			auto tag_ports = add_tag_ports(wire);
+			for (int i = 0; i < GetSize(options.port_tags); i++)
+				module->connect(tag_ports[i], tag_signal(options.port_tags[i], SigSpec(wire)));
+		}
+
+		module->fixup_ports();
+	}
+
 	void resolve_overwrites()
 	{
 		std::vector<Cell *> overwrite_cells;
@@ -247,6 +366,9 @@ struct DftTagWorker {
 
 	void propagate_tags()
 	{
+		for (auto &source : port_tag_sources)
+			add_tags(source.second, singleton(source.first));
+
 		for (auto cell : module->cells()) {
 			if (cell->type == ID($set_tag)) {
 				pending_cells.insert(cell);
@@ -372,12 +494,7 @@ struct DftTagWorker {
 	{
 		if (cell->type == ID($set_tag)) {
 			IdString tag = stringf("\\%s", cell->getParam(ID::TAG).decode_string().c_str());
-			if (all_tags.insert(tag).second) {
-				auto group_sep = tag.str().find(':');
-				IdString tag_group = group_sep != std::string::npos ? tag.str().substr(0, group_sep) : tag;
-				tag_groups[tag_group].insert(tag);
-				group_of_tag[tag] = tag_group;
-			}
+			register_tag(tag);
 
 			auto &sig_y = cell->getPort(ID::Y);
 			auto &sig_a = cell->getPort(ID::A);
@@ -497,6 +614,11 @@ struct DftTagWorker {
 			log_assert(false);
 		}
 
+		if (options.conjunctive_cells.count(cell->type)) {
+			emit_conjunctive(tag, cell);
+			return;
+		}
+
 		if (cell->type.in(ID($not), ID($pos), ID($_NOT_), ID($_BUF_))) {
 			auto &sig_y = cell->getPort(ID::Y);
 			auto sig_a = cell->getPort(ID::A);
@@ -685,6 +807,73 @@ struct DftTagWorker {
 			return;
 		}
 
+		if (cell->type.in(ID($add), ID($sub), ID($neg))) {
+			auto &sig_y = cell->getPort(ID::Y);
+			int width = GetSize(sig_y);
+			auto sig_a = cell->getPort(ID::A);
+			auto sig_b = cell->type == ID($neg) ? SigSpec(Const(0, width)) : cell->getPort(ID::B);
+			sig_a.extend_u0(width, cell->getParam(ID::A_SIGNED).as_bool());
+			sig_b.extend_u0(width, cell->type != ID($neg) && cell->getParam(ID::B_SIGNED).as_bool());
+
+			auto group_sig_a = tag_group_signal(tag, sig_a);
+			auto group_sig_b = tag_group_signal(tag, sig_b);
+
+			auto tag_sig_a = tag_signal(tag, sig_a);
+			auto tag_sig_b = tag_signal(tag, sig_b);
+
+			// As in cellift, compare the results for the least and greatest
+			// values the group-tagged bits can take, which marks the bits
+			// reachable by a carry chain starting at a tagged bit.
+			auto min_a = autoAnd(NEW_ID, sig_a, autoNot(NEW_ID, group_sig_a));
+			auto max_a = autoOr(NEW_ID, sig_a, group_sig_a);
+			auto min_b = autoAnd(NEW_ID, sig_b, autoNot(NEW_ID, group_sig_b));
+			auto max_b = autoOr(NEW_ID, sig_b, group_sig_b);
+
+			SigSpec low, high;
+			if (cell->type == ID($add)) {
+				low = module->Add(NEW_ID, min_a, min_b);
+				high = module->Add(NEW_ID, max_a, max_b);
+			} else if (cell->type == ID($neg)) {
+				low = module->Sub(NEW_ID, Const(0, width), max_a);
+				high = module->Sub(NEW_ID, Const(0, width), min_a);
+			} else {
+				low = module->Sub(NEW_ID, min_a, max_b);
+				high = module->Sub(NEW_ID, max_a, min_b);
+			}
+
+			auto prop = autoOr(NEW_ID, autoXor(NEW_ID, low, high), autoOr(NEW_ID, group_sig_a, group_sig_b));
+			auto tagged = autoReduceOr(NEW_ID, {tag_sig_a, tag_sig_b});
+			auto tag_sig = autoAnd(NEW_ID, prop, SigSpec(tagged[0], width));
+			emit_tag_signal(tag, sig_y, tag_sig);
+			return;
+		}
+
+		if (cell->type.in(ID($shl), ID($shr), ID($sshl), ID($sshr), ID($shift), ID($shiftx))) {
+			auto &sig_y = cell->getPort(ID::Y);
+			int width = GetSize(sig_y);
+
+			auto tag_sig_a = tag_signal(tag, cell->getPort(ID::A));
+			auto tag_sig_b = tag_signal(tag, cell->getPort(ID::B));
+
+			// Shift the tags along with the data, bits shifted in by $shiftx
+			// are constant and therefore untagged. This is exact unless the
+			// shift amount is tagged, in which case every output bit is
+			// tagged (the imprecise shift mode of cellift).
+			SigSpec shifted_tags = Const(0, width);
+			if (!tag_sig_a.is_fully_zero()) {
+				shifted_tags = module->addWire(NEW_ID, width);
+				auto shift = module->addCell(NEW_ID, cell->type == ID($shiftx) ? ID($shift) : cell->type);
+				shift->parameters = cell->parameters;
+				shift->setPort(ID::A, tag_sig_a);
+				shift->setPort(ID::B, cell->getPort(ID::B));
+				shift->setPort(ID::Y, shifted_tags);
+			}
+
+			auto tag_sig = autoOr(NEW_ID, shifted_tags, SigSpec(autoReduceOr(NEW_ID, tag_sig_b)[0], width));
+			emit_tag_signal(tag, sig_y, tag_sig);
+			return;
+		}
+
 		if (RTLIL::builtin_ff_cell_types().count(cell->type) || cell->type == ID($anyinit)) {
 			FfData ff(&initvals, cell);
 			// TODO handle some more variants
@@ -703,7 +892,8 @@ struct DftTagWorker {
 				ff.sig_q = module->addWire(NEW_ID, width);
 				ff.is_anyinit = false;
 				ff.val_init = Const(0, width);
-				ff.emit();
+				// Lets taint_probes create probes for the tag state
+				ff.emit()->set_bool_attribute(ID(taint_ff));
 
 				emit_tag_signal(tag, sig_q, ff.sig_q);
 				return;
@@ -717,6 +907,18 @@ struct DftTagWorker {
 		}
 
 		// Fallback
+		emit_conjunctive(tag, cell);
+
+		// As fallback we propagate all tags from all inputs to all outputs,
+		// which is an over-approximation (unless the cell is a module that
+		// generates tags itself in which case it could be arbitrary).
+		if (warned_cells.insert(cell).second)
+			log_warning("Unhandled cell %s (%s) while emitting tag signals\n", log_id(cell), log_id(cell->type));
+	}
+
+	// Tags every output bit when any input bit is tagged
+	void emit_conjunctive(IdString tag, Cell *cell)
+	{
 		SigSpec tag_input;
 
 		for (auto &conn : cell->connections()) {
@@ -733,12 +935,6 @@ struct DftTagWorker {
 				emit_tag_signal(tag, conn.second, SigSpec(any_tagged, GetSize(conn.second)));
 			}
 		}
-
-		// As fallback we propagate all tags from all inputs to all outputs,
-		// which is an over-approximation (unless the cell is a module that
-		// generates tags itself in which case it could be arbitrary).
-		if (warned_cells.insert(cell).second)
-			log_warning("Unhandled cell %s (%s) while emitting tag signals\n", log_id(cell), log_id(cell->type));
 	}
 
 	void emit_tags()
@@ -765,6 +961,10 @@ struct DftTagWorker {
 					public_wires.push_back(wire);
 
 			for (auto wire : public_wires) {
+				if (options.pack_tags) {
+					emit_packed_tags(wire);
+					continue;
+				}
 				for (auto tag : tag_pool(tags(SigSpec(wire)))) {
 					auto tag_sig = tag_signal(tag, SigSpec(wire));
 					if (tag_sig.is_fully_zero())
@@ -790,6 +990,48 @@ struct DftTagWorker {
 				}
 			}
 		}
+
+		add_output_tag_ports();
+	}
+
+	// Creates a single public wire (named <wirename>:tags) that holds the tag
+	// bits of all tags the wire may carry side by side, in the order listed
+	// by its dft_tag attribute.
+	void emit_packed_tags(Wire *wire)
+	{
+		std::vector<IdString> wire_tags;
+		for (auto tag : tag_pool(tags(SigSpec(wire))))
+			wire_tags.push_back(tag);
+		std::sort(wire_tags.begin(), wire_tags.end(), RTLIL::sort_by_id_str());
+
+		SigSpec packed_sig;
+		std::vector<std::string> tag_names;
+		for (auto tag : wire_tags) {
+			auto tag_sig = tag_signal(tag, SigSpec(wire));
+			if (tag_sig.is_fully_zero())
+				continue;
+			packed_sig.append(tag_sig);
+			tag_names.push_back(tag.str().substr(1));
+		}
+
+		if (packed_sig.empty())
+			return;
+
+		int index = 0;
+		auto name = module->uniquify(stringf("%s:tags", wire->name.c_str()), index);
+		auto hdlname = wire->get_hdlname_attribute();
+
+		if (!hdlname.empty())
+			hdlname.back() += index ? stringf(":tags_%d", index) : ":tags";
+
+		auto tag_wire = module->addWire(name, GetSize(packed_sig));
+
+		tag_wire->set_bool_attribute(ID::keep);
+		tag_wire->set_string_attribute(ID(dft_tag), tag_list(tag_names));
+		if (!hdlname.empty())
+			tag_wire->set_hdlname_attribute(hdlname);
+
+		module->connect(tag_wire, packed_sig);
 	}
 
 	void replace_dft_cells()
@@ -958,21 +1200,61 @@ struct DftTagPass : public Pass {
 		log("\n");
 		log("    dft_tag [options] [selection]\n");
 		log("\n");
-		log("This pass... TODO\n");
+		log("This pass adds logic that tracks which bits of the design carry data flowing\n");
+		log("from tagged sources. Tags are introduced with $set_tag cells (or tag input\n");
+		log("ports, see -tag-ports) and observed with $get_tag cells, which are replaced\n");
+		log("by the corresponding tag signals. $overwrite_tag and $original_tag cells are\n");
+		log("resolved first.\n");
+		log("\n");
+		log("Each tag is tracked by its own set of signals. Tags named <group>:<name>\n");
+		log("belong to the tag group <group>, and the tracking logic for a tag treats all\n");
+		log("bits tagged with any tag of the same group as unknown. Tags are propagated\n");
+		log("precisely through bitwise logic, muxes, comparisons, reductions, $add, $sub,\n");
+		log("$neg and through shifts by untagged amounts, matching the precise cells of\n");
+		log("the cellift pass. Other cells tag all outputs as soon as any input is tagged.\n");
 		log("\n");
 		log("    -overwrite-only\n");
 		log("        Only process $overwrite_tag and $original_tag cells.\n");
+		log("\n");
 		log("    -tag-public\n");
 		log("        For each public wire that may carry tagged data, create a new public\n");
 		log("        wire (named <wirename>:<tagname>) that carries the tag bits. Note\n");
 		log("        that without this, tagging logic will only be emitted as required\n");
 		log("        for uses of $get_tag.\n");
 		log("\n");
+		log("    -pack-tags\n");
+		log("        With -tag-public, create a single wire per public wire (named\n");
+		log("        <wirename>:tags) that holds the tag bits of all tags side by side.\n");
+		log("        With -tag-ports, create a single tag port per port (named\n");
+		log("        <portname>_t). The 'dft_tag' attribute of these wires lists the tags\n");
+		log("        in order, starting with the least significant bits.\n");
+		log("\n");
+		log("    -tag-ports <tag>[,<tag>...]\n");
+		log("        For each input and output port, add a port per tag (named\n");
+		log("        <portname>_t<index>) that carries the tag bits of the port. These are\n");
+		log("        marked like the taint ports added by cellift, so that the\n");
+		log("        port_cellift_probes and gen_toml passes handle them in the same way.\n");
+		log("\n");
+		log("    -exclude-signals <name>[,<name>...]\n");
+		log("        Do not add tag ports for the listed ports, e.g. clock and reset.\n");
+		log("\n");
+		log("    -conjunctive <celltype>[,<celltype>...]\n");
+		log("        Use the cheaper but imprecise rule that tags all outputs when any\n");
+		log("        input is tagged for the listed cell types (with or without leading\n");
+		log("        '$', e.g. 'add,sub,mux').\n");
+		log("\n");
+		log("    -conjunctive-gates\n");
+		log("        Same as '-conjunctive and,or' including the gate-level cells.\n");
+		log("\n");
+		log("The registers holding tag state are marked with the 'taint_ff' attribute, so\n");
+		log("that the taint_probes pass creates probes for them.\n");
+		log("\n");
 	}
 
 	void execute(std::vector<std::string> args, RTLIL::Design *design) override
 	{
 		DftTagOptions options;
+		std::vector<std::string> conjunctive_names;
 
 		log_header(design, "Executing DFT_TAG pass.\n");
 
@@ -986,11 +1268,45 @@ struct DftTagPass : public Pass {
 				options.overwrite_only = true;
 				continue;
 			}
+			if (args[argidx] == "-pack-tags") {
+				options.pack_tags = true;
+				continue;
+			}
+			if (args[argidx] == "-tag-ports" && argidx+1 < args.size()) {
+				for (auto &tag : split_tokens(args[++argidx], ","))
+					options.port_tags.push_back(stringf("\\%s", tag.c_str()));
+				continue;
+			}
+			if (args[argidx] == "-exclude-signals" && argidx+1 < args.size()) {
+				for (auto &name : split_tokens(args[++argidx], ","))
+					options.excluded_signals.insert(name);
+				continue;
+			}
+			if (args[argidx] == "-conjunctive" && argidx+1 < args.size()) {
+				conjunctive_names = split_tokens(args[++argidx], ",");
+				continue;
+			}
+			if (args[argidx] == "-conjunctive-gates") {
+				for (auto type : {ID($and), ID($or), ID($_AND_), ID($_OR_), ID($_NAND_), ID($_NOR_), ID($_ANDNOT_), ID($_ORNOT_)})
+					options.conjunctive_cells.insert(type);
+				continue;
+			}
 			break;
 		}
 
 		extra_args(args, argidx, design);
 
+		CellTypes ct;
+		ct.setup_internals();
+		ct.setup_stdcells();
+
+		for (auto &name : conjunctive_names) {
+			IdString type = name[0] == '$' ? name : "$" + name;
+			if (!ct.cell_known(type) || type.in(ID($set_tag), ID($get_tag), ID($overwrite_tag), ID($original_tag)))
+				log_cmd_error("Unsupported cell type '%s' for -conjunctive.\n", name.c_str());
+			options.conjunctive_cells.insert(type);
+		}
+
 		for (auto module : design->selected_modules()) {
 			DftTagWorker worker(module, options);
 
@@ -1000,6 +1316,9 @@ struct DftTagPass : public Pass {
 			if (options.overwrite_only)
 				continue;
 
+			log_debug("Add tag ports.\n");
+			worker.add_input_tag_ports();
+
 			log_debug("Propagate tagged signals.\n");
 			worker.propagate_tags();
 
@@ -62,6 +62,14 @@ struct ScratchpadPass : public Pass {
 		log("by the name of the pass that uses it, e.g. 'opt.did_something'. If the value\n");
 		log("contains whitespace, it must be enclosed in double quotes.\n");
 		log("\n");
+		log("Variables read by the passes include:\n");
+		log("\n");
+		log("    liberty.cache_dir\n");
+		log("        directory in which read_liberty, dfflibmap and stat store parsed\n");
+		log("        liberty files in a binary format, and from which later runs load\n");
+		log("        them instead of parsing the files again. The entries are keyed by\n");
+		log("        the path, size and modification time of the file.\n");
+		log("\n");
 	}
 
 	void execute(std::vector<std::string> args, RTLIL::Design *design) override
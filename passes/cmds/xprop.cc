@@ -40,6 +40,7 @@ struct XpropOptions
 	bool required = false;
 	bool formal = false;
 	bool debug_asserts = false;
+	bool compact = false;
 };
 
 struct XpropWorker
@@ -54,7 +55,7 @@ struct XpropWorker
 		Module *module;
 
 		void invert() { std::swap(is_0, is_1); }
-		void auto_0() { connect_0(module->Not(NEW_ID, module->Or(NEW_ID, is_1, is_x))); }
+		void auto_0() { if (!is_0.empty()) connect_0(module->Not(NEW_ID, module->Or(NEW_ID, is_1, is_x))); }
 		void auto_1() { connect_1(module->Not(NEW_ID, module->Or(NEW_ID, is_0, is_x))); }
 		void auto_x() { connect_x(module->Not(NEW_ID, module->Or(NEW_ID, is_0, is_1))); }
 
@@ -68,18 +69,22 @@ struct XpropWorker
 		void connect_x_under_0(SigSpec sig) { connect_x(module->And(NEW_ID, sig, module->Not(NEW_ID, is_0))); }
 
 		void connect_as_bool() {
-			int width = GetSize(is_0);
+			int width = GetSize(is_1);
 			if (width <= 1)
 				return;
-			module->connect(is_0.extract(1, width - 1), Const(State::S1, width - 1));
+			if (!is_0.empty()) {
+				module->connect(is_0.extract(1, width - 1), Const(State::S1, width - 1));
+				is_0 = is_0[0];
+			}
 			module->connect(is_1.extract(1, width - 1), Const(State::S0, width - 1));
 			module->connect(is_x.extract(1, width - 1), Const(State::S0, width - 1));
-			is_0 = is_0[0];
 			is_1 = is_1[0];
 			is_x = is_x[0];
 		}
 
-		int size() const { return is_0.size(); }
+		int size() const { return is_1.size(); }
+
+		void connect(const EncodedSig &sig) { connect_1(sig.is_1); connect_x(sig.is_x); }
 	};
 
 	Module *module;
@@ -176,8 +181,7 @@ struct XpropWorker
 		EncodedSig result;
 		SigSpec invert;
 
-		if (driving)
-			result.module = module;
+		result.module = module;
 
 		int new_bits = 0;
 
@@ -186,8 +190,10 @@ struct XpropWorker
 		for (auto bit : sig) {
 			if (!bit.is_wire())
 				continue;
-			else if (!maybe_x(bit) && !driving)
-				invert.append(bit);
+			else if (!maybe_x(bit) && !driving) {
+				if (!options.compact)
+					invert.append(bit);
+			}
 			else if (!encoded_bits.count(bit)) {
 				new_bits += 1;
 				encoded_bits.emplace(bit, {
@@ -201,7 +207,8 @@ struct XpropWorker
 
 		EncodedSig new_sigs;
 		if (new_bits > 0) {
-			new_sigs.is_0 = module->addWire(NEW_ID, new_bits);
+			if (!options.compact)
+				new_sigs.is_0 = module->addWire(NEW_ID, new_bits);
 			new_sigs.is_1 = module->addWire(NEW_ID, new_bits);
 			new_sigs.is_x = module->addWire(NEW_ID, new_bits);
 		}
@@ -216,19 +223,22 @@ struct XpropWorker
 		for (auto bit : sig)
 		{
 			if (!bit.is_wire()) {
-				result.is_0.append(bit == State::S0 ? State::S1 : State::S0);
+				if (!options.compact)
+					result.is_0.append(bit == State::S0 ? State::S1 : State::S0);
 				result.is_1.append(bit == State::S1 ? State::S1 : State::S0);
 				result.is_x.append(bit == State::Sx ? State::S1 : State::S0);
 				continue;
 			} else if (!maybe_x(bit) && !driving) {
-				result.is_0.append(invert[invert_pos++]);
+				if (!options.compact)
+					result.is_0.append(invert[invert_pos++]);
 				result.is_1.append(bit);
 				result.is_x.append(State::S0);
 				continue;
 			}
 			auto &enc = encoded_bits.at(bit);
-			if (enc.is_0 == State::Sm) {
-				enc.is_0 = new_sigs.is_0[new_pos];
+			if (enc.is_1 == State::Sm) {
+				if (!options.compact)
+					enc.is_0 = new_sigs.is_0[new_pos];
 				enc.is_1 = new_sigs.is_1[new_pos];
 				enc.is_x = new_sigs.is_x[new_pos];
 				new_pos++;
@@ -238,7 +248,6 @@ struct XpropWorker
 				enc.driven = true;
 				if (maybe_x(bit)) {
 					driven_orig.append(bit);
-					driven_enc.is_0.append(enc.is_0);
 					driven_enc.is_1.append(enc.is_1);
 					driven_enc.is_x.append(enc.is_x);
 				} else {
@@ -246,7 +255,8 @@ struct XpropWorker
 					driven_never_x.second.append(enc.is_1);
 				}
 			}
-			result.is_0.append(enc.is_0);
+			if (!options.compact)
+				result.is_0.append(enc.is_0);
 			result.is_1.append(enc.is_1);
 			result.is_x.append(enc.is_x);
 		}
@@ -260,20 +270,26 @@ struct XpropWorker
 		}
 
 		if (driving && (options.assert_encoding || options.assume_encoding)) {
-			auto not_0 = module->Not(NEW_ID, result.is_0);
-			auto not_1 = module->Not(NEW_ID, result.is_1);
-			auto not_x = module->Not(NEW_ID, result.is_x);
-			auto valid = module->ReduceAnd(NEW_ID, {
-				module->Eq(NEW_ID, result.is_0, module->And(NEW_ID, not_1, not_x)),
-				module->Eq(NEW_ID, result.is_1, module->And(NEW_ID, not_0, not_x)),
-				module->Eq(NEW_ID, result.is_x, module->And(NEW_ID, not_0, not_1)),
-			});
+			SigSpec valid;
+			if (options.compact) {
+				valid = module->LogicNot(NEW_ID, module->And(NEW_ID, result.is_1, result.is_x));
+			} else {
+				auto not_0 = module->Not(NEW_ID, result.is_0);
+				auto not_1 = module->Not(NEW_ID, result.is_1);
+				auto not_x = module->Not(NEW_ID, result.is_x);
+				valid = module->ReduceAnd(NEW_ID, {
+					module->Eq(NEW_ID, result.is_0, module->And(NEW_ID, not_1, not_x)),
+					module->Eq(NEW_ID, result.is_1, module->And(NEW_ID, not_0, not_x)),
+					module->Eq(NEW_ID, result.is_x, module->And(NEW_ID, not_0, not_1)),
+				});
+			}
 			if (options.assert_encoding)
 				module->addAssert(NEW_ID_SUFFIX("xprop_enc"), valid, State::S1);
 			else
 				module->addAssume(NEW_ID_SUFFIX("xprop_enc"), valid, State::S1);
 			if (options.debug_asserts) {
-				auto bad_bits = module->Bweqx(NEW_ID, {result.is_0, result.is_1, result.is_x}, Const(State::Sx, GetSize(result) * 3));
+				SigSpec rails = {result.is_0, result.is_1, result.is_x};
+				auto bad_bits = module->Bweqx(NEW_ID, rails, Const(State::Sx, GetSize(rails)));
 				module->addAssert(NEW_ID_SUFFIX("xprop_debug"), module->LogicNot(NEW_ID, bad_bits), State::S1);
 			}
 		}
@@ -466,6 +482,47 @@ struct XpropWorker
 		mark_outputs_maybe_x(cell);
 	}
 
+	// With -compact only the is_1 and is_x rails exist, is_0 is implied by
+	// neither being set. These build the rails of a result from the rails of
+	// the operands.
+
+	EncodedSig compact_sig(SigSpec is_1, SigSpec is_x)
+	{
+		EncodedSig result;
+		result.module = module;
+		result.is_1 = is_1;
+		result.is_x = is_x;
+		return result;
+	}
+
+	EncodedSig compact_not(const EncodedSig &a)
+	{
+		return compact_sig(module->Not(NEW_ID, module->Or(NEW_ID, a.is_1, a.is_x)), a.is_x);
+	}
+
+	EncodedSig compact_and(const EncodedSig &a, const EncodedSig &b)
+	{
+		auto y_1 = module->And(NEW_ID, a.is_1, b.is_1);
+		auto y_x = module->Or(NEW_ID,
+				module->And(NEW_ID, a.is_x, module->Or(NEW_ID, b.is_1, b.is_x)),
+				module->And(NEW_ID, b.is_x, a.is_1));
+		return compact_sig(y_1, y_x);
+	}
+
+	EncodedSig compact_or(const EncodedSig &a, const EncodedSig &b)
+	{
+		auto y_1 = module->Or(NEW_ID, a.is_1, b.is_1);
+		auto y_x = module->And(NEW_ID, module->Or(NEW_ID, a.is_x, b.is_x), module->Not(NEW_ID, y_1));
+		return compact_sig(y_1, y_x);
+	}
+
+	EncodedSig compact_bool(const EncodedSig &a)
+	{
+		auto y_1 = module->ReduceOr(NEW_ID, a.is_1);
+		auto y_x = module->And(NEW_ID, module->ReduceOr(NEW_ID, a.is_x), module->Not(NEW_ID, y_1));
+		return compact_sig(y_1, y_x);
+	}
+
 	void process_cells()
 	{
 		for (auto cell : module->selected_cells())
@@ -514,6 +571,12 @@ struct XpropWorker
 			auto enc_a = encoded(sig_a);
 			auto enc_y = encoded(sig_y, true);
 
+			if (options.compact) {
+				enc_y.connect(compact_not(enc_a));
+				module->remove(cell);
+				return;
+			}
+
 			enc_y.connect_x(enc_a.is_x);
 			enc_y.connect_0(enc_a.is_1);
 			enc_y.connect_1(enc_a.is_0);
@@ -535,6 +598,18 @@ struct XpropWorker
 			auto enc_b = encoded(sig_b);
 			auto enc_y = encoded(sig_y, true);
 
+			if (options.compact) {
+				if (cell->type.in(ID($_ANDNOT_), ID($_ORNOT_)))
+					enc_b = compact_not(enc_b);
+				bool is_or = cell->type.in(ID($or), ID($_OR_), ID($_NOR_), ID($_ORNOT_));
+				auto enc_res = is_or ? compact_or(enc_a, enc_b) : compact_and(enc_a, enc_b);
+				if (cell->type.in(ID($_NAND_), ID($_NOR_)))
+					enc_res = compact_not(enc_res);
+				enc_y.connect(enc_res);
+				module->remove(cell);
+				return;
+			}
+
 			if (cell->type.in(ID($or), ID($_OR_), ID($_NOR_), ID($_ORNOT_)))
 				enc_a.invert(), enc_b.invert(), enc_y.invert();
 			if (cell->type.in(ID($_NAND_), ID($_NOR_)))
@@ -558,6 +633,20 @@ struct XpropWorker
 
 			enc_y.connect_as_bool();
 
+			if (options.compact) {
+				if (cell->type == ID($reduce_and)) {
+					auto y_1 = module->ReduceAnd(NEW_ID, enc_a.is_1);
+					auto not_0 = module->ReduceAnd(NEW_ID, module->Or(NEW_ID, enc_a.is_1, enc_a.is_x));
+					enc_y.connect_1(y_1);
+					enc_y.connect_x(module->And(NEW_ID, not_0, module->Not(NEW_ID, y_1)));
+				} else {
+					auto enc_res = compact_bool(enc_a);
+					enc_y.connect(cell->type == ID($logic_not) ? compact_not(enc_res) : enc_res);
+				}
+				module->remove(cell);
+				return;
+			}
+
 			if (cell->type.in(ID($reduce_or), ID($reduce_bool)))
 				enc_a.invert(), enc_y.invert();
 			if (cell->type == ID($logic_not))
@@ -579,6 +668,16 @@ struct XpropWorker
 			auto enc_y = encoded(sig_y, true);
 
 			enc_y.connect_as_bool();
+
+			if (options.compact) {
+				auto y_x = module->ReduceOr(NEW_ID, enc_a.is_x);
+				auto y_d = cell->type == ID($reduce_xnor) ? module->ReduceXnor(NEW_ID, enc_a.is_1) : module->ReduceXor(NEW_ID, enc_a.is_1);
+				enc_y.connect_x(y_x);
+				enc_y.connect_1_under_x(y_d);
+				module->remove(cell);
+				return;
+			}
+
 			if (cell->type == ID($reduce_xnor))
 				enc_y.invert();
 
@@ -602,6 +701,14 @@ struct XpropWorker
 
 			enc_y.connect_as_bool();
 
+			if (options.compact) {
+				auto bool_a = compact_bool(enc_a);
+				auto bool_b = compact_bool(enc_b);
+				enc_y.connect(cell->type == ID($logic_or) ? compact_or(bool_a, bool_b) : compact_and(bool_a, bool_b));
+				module->remove(cell);
+				return;
+			}
+
 			auto a_is_1 = module->ReduceOr(NEW_ID, enc_a.is_1);
 			auto a_is_0 = module->ReduceAnd(NEW_ID, enc_a.is_0);
 			auto b_is_1 = module->ReduceOr(NEW_ID, enc_b.is_1);
@@ -630,6 +737,14 @@ struct XpropWorker
 			auto enc_b = encoded(sig_b);
 			auto enc_y = encoded(sig_y, true);
 
+			if (options.compact) {
+				bool is_xnor = cell->type.in(ID($xnor), ID($_XNOR_));
+				enc_y.connect_x(module->Or(NEW_ID, enc_a.is_x, enc_b.is_x));
+				enc_y.connect_1_under_x(is_xnor ? module->Xnor(NEW_ID, enc_a.is_1, enc_b.is_1) : module->Xor(NEW_ID, enc_a.is_1, enc_b.is_1));
+				module->remove(cell);
+				return;
+			}
+
 			if (cell->type.in(ID($xnor), ID($_XNOR_)))
 				enc_y.invert();
 
@@ -653,6 +768,20 @@ struct XpropWorker
 			auto enc_y = encoded(sig_y, true);
 			enc_y.connect_as_bool();
 
+			if (options.compact) {
+				auto xpos = module->Or(NEW_ID, enc_a.is_x, enc_b.is_x);
+				auto delta = module->And(NEW_ID, module->Xor(NEW_ID, enc_a.is_1, enc_b.is_1), module->Not(NEW_ID, xpos));
+				auto differ = module->ReduceOr(NEW_ID, delta);
+				auto any_x = module->ReduceOr(NEW_ID, xpos);
+				if (cell->type == ID($ne))
+					enc_y.connect_1(differ);
+				else
+					enc_y.connect_1(module->Not(NEW_ID, module->Or(NEW_ID, differ, any_x)));
+				enc_y.connect_x(module->And(NEW_ID, any_x, module->Not(NEW_ID, differ)));
+				module->remove(cell);
+				return;
+			}
+
 			if (cell->type == ID($ne))
 				enc_y.invert();
 
@@ -677,7 +806,7 @@ struct XpropWorker
 			auto enc_a = encoded(sig_a);
 			auto enc_b = encoded(sig_b);
 
-			auto delta_0 = module->Xnor(NEW_ID, enc_a.is_0, enc_b.is_0);
+			auto delta_0 = options.compact ? module->Xnor(NEW_ID, enc_a.is_x, enc_b.is_x) : module->Xnor(NEW_ID, enc_a.is_0, enc_b.is_0);
 			auto delta_1 = module->Xnor(NEW_ID, enc_a.is_1, enc_b.is_1);
 
 			auto eq = module->ReduceAnd(NEW_ID, {delta_0, delta_1});
@@ -699,7 +828,7 @@ struct XpropWorker
 			auto enc_a = encoded(sig_a);
 			auto enc_b = encoded(sig_b);
 
-			auto delta_0 = module->Xnor(NEW_ID, enc_a.is_0, enc_b.is_0);
+			auto delta_0 = options.compact ? module->Xnor(NEW_ID, enc_a.is_x, enc_b.is_x) : module->Xnor(NEW_ID, enc_a.is_0, enc_b.is_0);
 			auto delta_1 = module->Xnor(NEW_ID, enc_a.is_1, enc_b.is_1);
 			module->addAnd(NEW_ID, delta_0, delta_1, sig_y);
 			module->remove(cell);
@@ -720,6 +849,23 @@ struct XpropWorker
 			auto enc_s = encoded(sig_s);
 			auto enc_y = encoded(sig_y, true);
 
+			if (options.compact) {
+				auto sel_1 = module->Bwmux(NEW_ID, enc_a.is_1, enc_b.is_1, enc_s.is_1);
+				auto sel_x = module->Bwmux(NEW_ID, enc_a.is_x, enc_b.is_x, enc_s.is_1);
+				if (!maybe_x(sig_s)) {
+					enc_y.connect_1(sel_1);
+					enc_y.connect_x(sel_x);
+				} else {
+					// An x select gives a defined result only where both inputs agree
+					auto both_1 = module->And(NEW_ID, enc_a.is_1, enc_b.is_1);
+					auto mixed = module->Or(NEW_ID, module->Or(NEW_ID, enc_a.is_x, enc_b.is_x), module->Xor(NEW_ID, enc_a.is_1, enc_b.is_1));
+					enc_y.connect_1(module->Bwmux(NEW_ID, sel_1, both_1, enc_s.is_x));
+					enc_y.connect_x(module->Bwmux(NEW_ID, sel_x, mixed, enc_s.is_x));
+				}
+				module->remove(cell);
+				return;
+			}
+
 			enc_y.connect_1(module->And(NEW_ID,
 					module->Or(NEW_ID, enc_a.is_1, enc_s.is_1),
 					module->Or(NEW_ID, enc_b.is_1, enc_s.is_0)));
@@ -753,12 +899,14 @@ struct XpropWorker
 
 			for (int i = 0; i < GetSize(enc_s); i++) {
 				auto sel_bit = enc_s.is_1[i];
-				selected.is_0 = module->Mux(NEW_ID, selected.is_0, enc_b.is_0.extract(i * width, width), sel_bit);
+				if (!options.compact)
+					selected.is_0 = module->Mux(NEW_ID, selected.is_0, enc_b.is_0.extract(i * width, width), sel_bit);
 				selected.is_1 = module->Mux(NEW_ID, selected.is_1, enc_b.is_1.extract(i * width, width), sel_bit);
 				selected.is_x = module->Mux(NEW_ID, selected.is_x, enc_b.is_x.extract(i * width, width), sel_bit);
 			}
 
-			enc_y.connect_0(module->Mux(NEW_ID, selected.is_0, Const(State::S0, width), all_x));
+			if (!options.compact)
+				enc_y.connect_0(module->Mux(NEW_ID, selected.is_0, Const(State::S0, width), all_x));
 			enc_y.connect_1(module->Mux(NEW_ID, selected.is_1, Const(State::S0, width), all_x));
 			enc_y.connect_x(module->Mux(NEW_ID, selected.is_x, Const(State::S1, width), all_x));
 
@@ -778,6 +926,38 @@ struct XpropWorker
 			auto all_x = module->ReduceOr(NEW_ID, enc_b.is_x)[0];
 			auto not_all_x = module->Not(NEW_ID, all_x)[0];
 
+			if (options.compact) {
+				SigSpec y_1 = module->addWire(NEW_ID, GetSize(sig_y));
+				SigSpec y_x = module->addWire(NEW_ID, GetSize(sig_y));
+
+				auto shift_1 = module->addCell(NEW_ID, cell->type == ID($shiftx) ? ID($shift) : cell->type);
+				shift_1->parameters = cell->parameters;
+				shift_1->setPort(ID::A, enc_a.is_1);
+				shift_1->setPort(ID::B, enc_b.is_1);
+				shift_1->setPort(ID::Y, y_1);
+
+				// Bits shifted in by $shiftx are x, so shift the complement of
+				// the x rail and invert the result.
+				auto shift_x = module->addCell(NEW_ID, cell->type == ID($shiftx) ? ID($shift) : cell->type);
+				shift_x->parameters = cell->parameters;
+				shift_x->setPort(ID::B, enc_b.is_1);
+				if (cell->type == ID($shiftx)) {
+					SigSpec y_not_x = module->addWire(NEW_ID, GetSize(sig_y));
+					shift_x->setPort(ID::A, module->Not(NEW_ID, enc_a.is_x));
+					shift_x->setPort(ID::Y, y_not_x);
+					module->addNot(NEW_ID, y_not_x, y_x);
+				} else {
+					shift_x->setPort(ID::A, enc_a.is_x);
+					shift_x->setPort(ID::Y, y_x);
+				}
+
+				enc_y.connect_1(module->And(NEW_ID, y_1, SigSpec(not_all_x, GetSize(sig_y))));
+				enc_y.connect_x(module->Or(NEW_ID, y_x, SigSpec(all_x, GetSize(sig_y))));
+
+				module->remove(cell);
+				return;
+			}
+
 			SigSpec y_not_0 = module->addWire(NEW_ID, GetSize(sig_y));
 			SigSpec y_1 = module->addWire(NEW_ID, GetSize(sig_y));
 			SigSpec y_x = module->addWire(NEW_ID, GetSize(sig_y));
@@ -837,7 +1017,9 @@ struct XpropWorker
 			auto enc_d = encoded(sig_d);
 			auto enc_q = encoded(sig_q, true);
 
-			auto data_q = module->addWire(NEW_ID, GetSize(sig_q));
+			// The is_1 rail is already 0 for x bits, so in compact mode the
+			// value register can drive it without gating.
+			SigSpec data_q = options.compact ? enc_q.is_1 : module->addWire(NEW_ID, GetSize(sig_q));
 
 			module->addFf(NEW_ID, enc_d.is_1, data_q);
 			module->addFf(NEW_ID, enc_d.is_x, enc_q.is_x);
@@ -845,8 +1027,10 @@ struct XpropWorker
 			initvals.set_init(data_q, init_q_is_1);
 			initvals.set_init(enc_q.is_x, init_q_is_x);
 
-			enc_q.connect_1_under_x(data_q);
-			enc_q.auto_0();
+			if (!options.compact) {
+				enc_q.connect_1_under_x(data_q);
+				enc_q.auto_0();
+			}
 
 			module->remove(cell);
 			return;
@@ -880,7 +1064,7 @@ struct XpropWorker
 					auto enc_d = encoded(ff.sig_d);
 					auto enc_q = encoded(ff.sig_q, true);
 
-					auto data_q = module->addWire(NEW_ID, GetSize(ff.sig_q));
+					SigSpec data_q = options.compact ? enc_q.is_1 : module->addWire(NEW_ID, GetSize(ff.sig_q));
 
 					ff.sig_d = enc_d.is_1;
 					ff.sig_q = data_q;
@@ -895,9 +1079,10 @@ struct XpropWorker
 					ff.val_init = init_q_is_x;
 					ff.emit();
 
-
-					enc_q.connect_1_under_x(data_q);
-					enc_q.auto_0();
+					if (!options.compact) {
+						enc_q.connect_1_under_x(data_q);
+						enc_q.auto_0();
+					}
 
 					return;
 				}
@@ -1085,13 +1270,15 @@ struct XpropWorker
 				if (it == encoded_bits.end() || it->second.driven)
 					continue;
 				orig.append(bit);
-				enc.is_0.append(it->second.is_0);
+				if (!options.compact)
+					enc.is_0.append(it->second.is_0);
 				enc.is_1.append(it->second.is_1);
 				enc.is_x.append(it->second.is_x);
 				it->second.driven = true;
 			}
 
-			module->addBweqx(NEW_ID, orig, Const(State::S0, GetSize(orig)), enc.is_0);
+			if (!options.compact)
+				module->addBweqx(NEW_ID, orig, Const(State::S0, GetSize(orig)), enc.is_0);
 			module->addBweqx(NEW_ID, orig, Const(State::S1, GetSize(orig)), enc.is_1);
 			module->addBweqx(NEW_ID, orig, Const(State::Sx, GetSize(orig)), enc.is_x);
 		}
@@ -1147,6 +1334,13 @@ struct XpropPass : public Pass {
 		log("        Produce a runtime error if any encoded cell uses a signal that is\n");
 		log("		 neither known to be non-x nor driven by another encoded cell.\n");
 		log("\n");
+		log("    -compact\n");
+		log("        Use a two-rail encoding that only carries the defined value and the\n");
+		log("        x-mask of each signal instead of separate 0, 1 and x rails. The value\n");
+		log("        rail is 0 for x bits. This produces noticeably fewer cells, in\n");
+		log("        particular for signals that are known to be non-x, muxes with a non-x\n");
+		log("        select and FFs.\n");
+		log("\n");
 		log("    -debug-asserts\n");
 		log("        Add assertions checking that the encoding used by this pass never\n");
 		log("        produces x values within the encoded signals.\n");
@@ -1198,6 +1392,10 @@ struct XpropPass : public Pass {
 				options.required = true;
 				continue;
 			}
+			if (args[argidx] == "-compact") {
+				options.compact = true;
+				continue;
+			}
 			if (args[argidx] == "-debug-asserts") { // TODO documented
 				options.debug_asserts = true;
 				options.assert_encoding = true;
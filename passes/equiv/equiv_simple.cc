@@ -19,6 +19,7 @@
 
 #include "kernel/yosys.h"
 #include "kernel/satgen.h"
+#include "kernel/bitsim.h"
 
 USING_YOSYS_NAMESPACE
 PRIVATE_NAMESPACE_BEGIN
@@ -298,15 +299,39 @@ struct EquivSimplePass : public Pass {
 		log("    -nogroup\n");
 		log("        disabling grouping of $equiv cells by output wire\n");
 		log("\n");
+		log("    -batch <N>\n");
+		log("        share one incremental SAT solver instance between consecutive groups of\n");
+		log("        $equiv cells until it holds at least N cells. Each cell is proven under\n");
+		log("        its own activation literal and the cones imported for earlier cells\n");
+		log("        are reused. (default = 1, one solver per group)\n");
+		log("\n");
 		log("    -seq <N>\n");
 		log("        the max. number of time steps to be considered (default = 1)\n");
 		log("\n");
+		log("    -sim <N>\n");
+		log("        before calling the SAT solver, simulate the module with N*64 random\n");
+		log("        patterns and skip all $equiv cells for which a pattern yields different\n");
+		log("        values on A and B. With -seq > 0 this is only done for cells whose\n");
+		log("        input cone does not reach FF or other non-combinational cell outputs,\n");
+		log("        as the simulation treats those as free inputs. The remaining groups\n");
+		log("        are then proven in the order of their logic depth. A cell is only\n");
+		log("        skipped for a pattern in which A and B are both defined, so this is\n");
+		log("        sound with and without -undef. N = 0 disables the simulation.\n");
+		log("        (default = 4)\n");
+		log("\n");
+		log("    -j <N>\n");
+		log("        distribute the groups of $equiv cells over N worker processes, each\n");
+		log("        with its own SAT solver working on a snapshot of the module. The\n");
+		log("        proven cells are merged back afterwards and the log output of the\n");
+		log("        workers is shown in the order of the groups. N = 0 uses one worker\n");
+		log("        per CPU. (default = 1)\n");
+		log("\n");
 	}
 	void execute(std::vector<std::string> args, Design *design) override
 	{
 		bool verbose = false, short_cones = false, model_undef = false, nogroup = false;
 		int success_counter = 0;
-		int max_seq = 1;
+		int max_seq = 1, batch_size = 1, jobs = 1, sim_rounds = 4;
 
 		log_header(design, "Executing EQUIV_SIMPLE pass.\n");
 
@@ -332,6 +357,20 @@ struct EquivSimplePass : public Pass {
 				max_seq = atoi(args[++argidx].c_str());
 				continue;
 			}
+			if (args[argidx] == "-sim" && argidx+1 < args.size()) {
+				sim_rounds = atoi(args[++argidx].c_str());
+				continue;
+			}
+			if (args[argidx] == "-j" && argidx+1 < args.size()) {
+				jobs = atoi(args[++argidx].c_str());
+				if (jobs <= 0)
+					jobs = get_num_cpus();
+				continue;
+			}
+			if (args[argidx] == "-batch" && argidx+1 < args.size()) {
+				batch_size = atoi(args[++argidx].c_str());
+				continue;
+			}
 			break;
 		}
 		extra_args(args, argidx, design);
@@ -373,16 +412,205 @@ struct EquivSimplePass : public Pass {
 			}
 
 			unproven_equiv_cells.sort();
+
+			if (sim_rounds > 0)
+			{
+				BitSim sim(module);
+				pool<Cell*> refuted;
+
+				// A difference is only a counterexample if the values of the
+				// free bits are unconstrained. The outputs of FFs and other
+				// cells that the simulation does not evaluate are constrained
+				// by the SAT steps back in time, so with -seq > 0 the cells
+				// depending on them are left to the SAT solver.
+				pool<SigBit> state_bits;
+				if (max_seq > 0)
+				{
+					dict<SigBit, vector<Cell*>> bit2consumers;
+					vector<SigBit> queue;
+					for (auto cell : module->cells()) {
+						bool known = ct.cell_known(cell->type);
+						for (auto &conn : cell->connections()) {
+							if (known && ct.cell_input(cell->type, conn.first))
+								for (auto bit : sigmap(conn.second))
+									bit2consumers[bit].push_back(cell);
+							if (!known && cell->output(conn.first))
+								for (auto bit : sigmap(conn.second))
+									if (bit.wire != nullptr && state_bits.insert(bit).second)
+										queue.push_back(bit);
+						}
+					}
+					for (int qi = 0; qi < GetSize(queue); qi++) {
+						auto it = bit2consumers.find(queue[qi]);
+						if (it == bit2consumers.end())
+							continue;
+						for (auto cell : it->second)
+							for (auto &conn : cell->connections())
+								if (ct.cell_output(cell->type, conn.first))
+									for (auto bit : sigmap(conn.second))
+										if (bit.wire != nullptr && state_bits.insert(bit).second)
+											queue.push_back(bit);
+					}
+				}
+
+				for (int round = 0; round < sim_rounds; round++) {
+					sim.randomize();
+					sim.eval();
+					for (auto &it : unproven_equiv_cells)
+						for (auto &it2 : it.second) {
+							SigBit bit_a = sigmap(it2.second->getPort(ID::A).as_bit());
+							SigBit bit_b = sigmap(it2.second->getPort(ID::B).as_bit());
+							if (state_bits.count(bit_a) || state_bits.count(bit_b))
+								continue;
+							if (sim.differ(bit_a, bit_b))
+								refuted.insert(it2.second);
+						}
+				}
+
+				dict<SigBit, int> group_depth;
+				pool<SigBit> empty_groups;
+				for (auto &it : unproven_equiv_cells) {
+					pool<SigBit> refuted_bits;
+					for (auto &it2 : it.second) {
+						Cell *cell = it2.second;
+						if (refuted.count(cell)) {
+							if (verbose)
+								log("  Simulation refuted $equiv for %s.\n", log_signal(cell->getPort(ID::Y)));
+							refuted_bits.insert(it2.first);
+							continue;
+						}
+						int depth = max(sim.level(cell->getPort(ID::A).as_bit()), sim.level(cell->getPort(ID::B).as_bit()));
+						group_depth[it.first] = max(group_depth[it.first], depth);
+					}
+					for (auto bit : refuted_bits)
+						it.second.erase(bit);
+					if (it.second.empty())
+						empty_groups.insert(it.first);
+				}
+				for (auto bit : empty_groups)
+					unproven_equiv_cells.erase(bit);
+
+				log("Simulation with %d patterns refuted %d of %d $equiv cells, skipping their SAT queries.\n",
+						64 * sim_rounds, GetSize(refuted), unproven_cells_counter);
+
+				if (unproven_equiv_cells.empty())
+					continue;
+
+				// Prove shallow groups first.
+				unproven_equiv_cells.sort([&](const SigBit &a, const SigBit &b) {
+					int depth_a = group_depth.at(a), depth_b = group_depth.at(b);
+					return depth_a != depth_b ? depth_a < depth_b : a < b;
+				});
+			}
+
+			vector<vector<Cell*>> batches(1);
+			int group_counter = 0;
 			for (auto it : unproven_equiv_cells)
 			{
 				it.second.sort();
 
-				vector<Cell*> cells;
 				for (auto it2 : it.second)
-					cells.push_back(it2.second);
+					batches.back().push_back(it2.second);
+
+				group_counter++;
+				if (GetSize(batches.back()) >= batch_size && group_counter < GetSize(unproven_equiv_cells))
+					batches.emplace_back();
+			}
+
+			int num_workers = std::min(jobs, GetSize(batches));
+			if (num_workers <= 1) {
+				for (auto &cells : batches) {
+					EquivSimpleWorker worker(cells, sigmap, bit2driver, max_seq, short_cones, verbose, model_undef);
+					success_counter += worker.run();
+				}
+				continue;
+			}
+
+			// Distribute the batches over the workers, largest batches first.
+			vector<int> batch_order(GetSize(batches));
+			for (int i = 0; i < GetSize(batches); i++)
+				batch_order[i] = i;
+			std::stable_sort(batch_order.begin(), batch_order.end(), [&](int a, int b) { return GetSize(batches[a]) > GetSize(batches[b]); });
+
+			vector<vector<int>> worker_batches(num_workers);
+			vector<int> worker_load(num_workers);
+			for (int i : batch_order) {
+				int w = std::min_element(worker_load.begin(), worker_load.end()) - worker_load.begin();
+				worker_batches[w].push_back(i);
+				worker_load[w] += GetSize(batches[i]);
+			}
+
+			log("Distributing %d groups over %d worker processes.\n", GetSize(batches), num_workers);
+
+			// Each worker sends "<batch> <log size> <proven cell indices>\n"
+			// followed by the captured log output for each of its batches.
+			vector<string> results = run_worker_processes(num_workers, [&](int w) {
+				string result;
+				for (int i : worker_batches[w]) {
+					std::stringstream log_buffer;
+					std::vector<FILE*> saved_log_files;
+					std::vector<std::ostream*> saved_log_streams;
+					saved_log_files.swap(log_files);
+					saved_log_streams.swap(log_streams);
+					log_streams.push_back(&log_buffer);
+					auto restore = [&]() {
+						log_files.swap(saved_log_files);
+						log_streams.swap(saved_log_streams);
+					};
+					try {
+						EquivSimpleWorker worker(batches[i], sigmap, bit2driver, max_seq, short_cones, verbose, model_undef);
+						worker.run();
+					} catch (...) {
+						restore();
+						throw;
+					}
+					restore();
+					string proven;
+					for (int j = 0; j < GetSize(batches[i]); j++)
+						if (batches[i][j]->getPort(ID::A) == batches[i][j]->getPort(ID::B))
+							proven += stringf(" %d", j);
+					result += stringf("%d %zu%s\n", i, log_buffer.str().size(), proven.c_str()) + log_buffer.str();
+				}
+				return result;
+			});
+
+			// Workers that ran in this process have already updated the cells.
+			vector<string> batch_logs(GetSize(batches));
+			vector<int> worker_counter(num_workers);
+			for (int w = 0; w < num_workers; w++) {
+				std::istringstream f(results[w]);
+				int i;
+				size_t log_size;
+				while (f >> i >> log_size) {
+					string proven;
+					if (i < 0 || i >= GetSize(batches) || !std::getline(f, proven))
+						log_error("Unexpected result from worker %d.\n", w);
+					for (auto &tok : split_tokens(proven)) {
+						int j = atoi(tok.c_str());
+						if (j < 0 || j >= GetSize(batches[i]))
+							log_error("Unexpected result from worker %d.\n", w);
+						Cell *cell = batches[i][j];
+						cell->setPort(ID::B, cell->getPort(ID::A));
+						worker_counter[w]++;
+					}
+					batch_logs[i].resize(log_size);
+					if (log_size > 0 && !f.read(&batch_logs[i][0], log_size))
+						log_error("Unexpected result from worker %d.\n", w);
+				}
+			}
+
+			// Replay the log output of the workers in the order of the groups,
+			// line by line so that logger -expect and -W see each message.
+			for (auto &text : batch_logs) {
+				std::istringstream f(text);
+				string line;
+				while (std::getline(f, line))
+					log("%s\n", line.c_str());
+			}
 
-				EquivSimpleWorker worker(cells, sigmap, bit2driver, max_seq, short_cones, verbose, model_undef);
-				success_counter += worker.run();
+			for (int w = 0; w < num_workers; w++) {
+				log("  Worker %d proved %d of %d $equiv cells.\n", w, worker_counter[w], worker_load[w]);
+				success_counter += worker_counter[w];
 			}
 		}
 
@@ -20,6 +20,7 @@
 
 #include "kernel/yosys.h"
 #include "frontends/verific/verific.h"
+#include "backends/rtlil/rtlil_backend.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <set>
@@ -318,6 +319,188 @@ struct IFExpander
 	}
 };
 
+// The specializations of parametric modules derived by this pass, indexed by
+// the module and the parameter values. Cells with the same parameters reuse
+// an earlier result, and with -j the pending specializations of an iteration
+// are derived up front in worker processes.
+struct DeriveIndex
+{
+	dict<std::string, RTLIL::IdString> derived;
+	int num_requests = 0, num_derived = 0, num_parallel = 0;
+
+	static std::string key(RTLIL::IdString modname, const dict<RTLIL::IdString, RTLIL::Const> &parameters)
+	{
+		std::vector<std::string> params;
+		for (auto &it : parameters)
+			params.push_back(stringf("%s=%d:%s", it.first.c_str(), it.second.flags, it.second.as_string().c_str()));
+		std::sort(params.begin(), params.end());
+
+		std::string key = modname.str();
+		for (auto &param : params)
+			key += "\n" + param;
+		return key;
+	}
+
+	RTLIL::IdString lookup(RTLIL::Design *design, const std::string &key)
+	{
+		auto it = derived.find(key);
+		if (it != derived.end() && design->module(it->second) != nullptr)
+			return it->second;
+		return RTLIL::IdString();
+	}
+
+	// Derive `mod' for the parameters of a cell without interface connections.
+	// Abstract modules are derived like get_module() does, other modules like
+	// expand_module() does.
+	RTLIL::IdString derive(RTLIL::Design *design, RTLIL::Module *mod, const dict<RTLIL::IdString, RTLIL::Const> &parameters, bool abstract)
+	{
+		num_requests++;
+		std::string k = key(mod->name, parameters);
+		RTLIL::IdString name = lookup(design, k);
+		if (!name.empty())
+			return name;
+
+		if (abstract) {
+			name = mod->derive(design, parameters);
+		} else {
+			dict<RTLIL::IdString, RTLIL::Module*> interfaces;
+			dict<RTLIL::IdString, RTLIL::IdString> modports;
+			name = mod->derive(design, parameters, interfaces, modports);
+		}
+		derived[k] = name;
+		num_derived++;
+		return name;
+	}
+
+	static bool has_interfaces(RTLIL::Module *module)
+	{
+		if (module->get_bool_attribute(ID::is_interface))
+			return true;
+		for (auto wire : module->wires())
+			if (wire->get_bool_attribute(ID::is_interface))
+				return true;
+		return false;
+	}
+
+	// A derived module that is transferred from a worker process loses its
+	// AST. This is only possible if it will never have to be elaborated again:
+	// for interfaces, for instances of modules that weren't available yet, or
+	// for hierarchical defparams that reach through an instantiated user module.
+	static bool self_contained(RTLIL::Design *design, RTLIL::Module *module)
+	{
+		if (has_interfaces(module))
+			return false;
+		for (auto cell : module->cells()) {
+			if (cell->has_attribute(ID::reprocess_after) || cell->get_bool_attribute(ID::is_interface))
+				return false;
+			RTLIL::Module *mod = design->module(cell->type);
+			if (mod != nullptr && !mod->get_blackbox_attribute())
+				return false;
+		}
+		return true;
+	}
+
+	void prefetch(RTLIL::Design *design, const std::set<RTLIL::Module*, IdString::compare_ptr_by_name<Module>> &used_modules, int num_jobs)
+	{
+		struct pending_t {
+			std::string key;
+			RTLIL::Module *mod;
+			bool abstract;
+			dict<RTLIL::IdString, RTLIL::Const> parameters;
+		};
+		std::vector<pending_t> pending;
+		pool<std::string> seen;
+
+		// cells connected to interfaces are left to expand_module()
+		for (auto module : used_modules) {
+			if (has_interfaces(module))
+				continue;
+			for (auto cell : module->cells()) {
+				if (cell->parameters.empty() || cell->type.begins_with("$array:"))
+					continue;
+				bool abstract = false;
+				RTLIL::Module *mod = design->module(cell->type);
+				if (mod == nullptr) {
+					mod = design->module("$abstract" + cell->type.str());
+					abstract = true;
+				}
+				if (mod == nullptr || (!abstract && (mod->get_blackbox_attribute() || has_interfaces(mod))))
+					continue;
+				std::string k = key(mod->name, cell->parameters);
+				if (!lookup(design, k).empty() || !seen.insert(k).second)
+					continue;
+				pending.push_back({k, mod, abstract, cell->parameters});
+			}
+		}
+
+		if (GetSize(pending) < 2)
+			return;
+
+		int num_workers = std::min(num_jobs, GetSize(pending));
+		log("Deriving %d module specialization(s) in %d worker process(es).\n", GetSize(pending), num_workers);
+
+		// The result of a worker is its final autoidx followed by
+		// "<index> <name size> <rtlil size>\n<name><rtlil>" for each derived
+		// module. The RTLIL is empty when the module isn't self-contained and
+		// has to be derived again in this process.
+		std::vector<bool> failed;
+		std::vector<std::string> results = run_worker_processes(num_workers, [&](int w) {
+			std::string result;
+			for (int i = w; i < GetSize(pending); i += num_workers) {
+				auto &p = pending[i];
+				dict<RTLIL::IdString, RTLIL::Module*> interfaces;
+				dict<RTLIL::IdString, RTLIL::IdString> modports;
+				RTLIL::IdString name = p.abstract ? p.mod->derive(design, p.parameters) :
+						p.mod->derive(design, p.parameters, interfaces, modports);
+				RTLIL::Module *derived_mod = design->module(name);
+				std::stringstream rtlil;
+				if (derived_mod != nullptr && self_contained(design, derived_mod))
+					RTLIL_BACKEND::dump_module(rtlil, "", derived_mod, design, false);
+				result += stringf("%d %d %d\n", i, GetSize(name.str()), GetSize(rtlil.str()));
+				result += name.str() + rtlil.str();
+			}
+			return stringf("%d\n", autoidx) + result;
+		}, &failed);
+
+		for (int w = 0; w < num_workers; w++)
+		{
+			if (failed[w])
+				continue;
+
+			const std::string &result = results[w];
+			size_t pos = result.find('\n');
+			if (pos == std::string::npos)
+				log_error("Unexpected result from hierarchy worker process.\n");
+			// names created by the workers must not be created again here
+			autoidx = std::max(autoidx, atoi(result.c_str()));
+			pos++;
+
+			while (pos < result.size()) {
+				int index, name_size, rtlil_size;
+				size_t eol = result.find('\n', pos);
+				if (eol == std::string::npos || sscanf(result.c_str() + pos, "%d %d %d", &index, &name_size, &rtlil_size) != 3)
+					log_error("Unexpected result from hierarchy worker process.\n");
+				RTLIL::IdString name = result.substr(eol + 1, name_size);
+				std::string rtlil = result.substr(eol + 1 + name_size, rtlil_size);
+				pos = eol + 1 + name_size + rtlil_size;
+
+				if (rtlil.empty())
+					continue;
+				if (design->module(name) == nullptr) {
+					std::istringstream f(rtlil);
+					{
+						LogMakeDebugHdl debug_hdl(true);
+						Frontend::frontend_call(design, &f, "<hierarchy worker>", "read_rtlil");
+					}
+					log("Derived module %s in a worker process.\n", log_id(name));
+					num_parallel++;
+				}
+				derived[pending.at(index).key] = name;
+			}
+		}
+	}
+};
+
 // Get a module needed by a cell, either by deriving an abstract module or by
 // loading one from a directory in libdirs.
 //
@@ -329,12 +512,13 @@ RTLIL::Module *get_module(RTLIL::Design                  &design,
                           RTLIL::Cell                    &cell,
                           RTLIL::Module                  &parent,
                           bool                            check,
-                          const std::vector<std::string> &libdirs)
+                          const std::vector<std::string> &libdirs,
+                          DeriveIndex                    &index)
 {
 	std::string cell_type = cell.type.str();
 	RTLIL::Module *abs_mod = design.module("$abstract" + cell_type);
 	if (abs_mod) {
-		cell.type = abs_mod->derive(&design, cell.parameters);
+		cell.type = index.derive(&design, abs_mod, cell.parameters, true);
 		cell.parameters.clear();
 		RTLIL::Module *mod = design.module(cell.type);
 		log_assert(mod);
@@ -440,7 +624,7 @@ void check_cell_connections(const RTLIL::Module &module, RTLIL::Cell &cell, RTLI
 }
 
 bool expand_module(RTLIL::Design *design, RTLIL::Module *module, bool flag_check, bool flag_simcheck, bool flag_smtcheck,
-		   std::vector<std::string> &libdirs)
+		   std::vector<std::string> &libdirs, DeriveIndex &index)
 {
 	bool did_something = false;
 	std::map<RTLIL::Cell*, std::pair<int, int>> array_cells;
@@ -478,7 +662,7 @@ bool expand_module(RTLIL::Design *design, RTLIL::Module *module, bool flag_check
 		RTLIL::Module *mod = design->module(cell->type);
 		if (!mod)
 		{
-			mod = get_module(*design, *cell, *module, flag_check || flag_simcheck || flag_smtcheck, libdirs);
+			mod = get_module(*design, *cell, *module, flag_check || flag_simcheck || flag_smtcheck, libdirs, index);
 
 			// If we still don't have a module, treat the cell as a black box and skip
 			// it. Otherwise, we either loaded or derived something so should set the
@@ -527,10 +711,13 @@ bool expand_module(RTLIL::Design *design, RTLIL::Module *module, bool flag_check
 			continue;
 		}
 
-		cell->type = mod->derive(design,
-					 cell->parameters,
-					 if_expander.interfaces_to_add_to_submodule,
-					 if_expander.modports_used_in_submodule);
+		if (if_expander.interfaces_to_add_to_submodule.empty() && if_expander.modports_used_in_submodule.empty())
+			cell->type = index.derive(design, mod, cell->parameters, false);
+		else
+			cell->type = mod->derive(design,
+						 cell->parameters,
+						 if_expander.interfaces_to_add_to_submodule,
+						 if_expander.modports_used_in_submodule);
 		cell->parameters.clear();
 		did_something = true;
 
@@ -800,6 +987,14 @@ struct HierarchyPass : public Pass {
 		log("       This option can be specified multiple times to override multiple\n");
 		log("       parameters. String values must be passed in double quotes (\").\n");
 		log("\n");
+		log("    -j <N>\n");
+		log("        derive the new specializations of parametric modules that are found\n");
+		log("        in an iteration in up to N parallel worker processes (0 for the number\n");
+		log("        of CPUs). Interfaces and modules that may have to be elaborated again\n");
+		log("        are still derived one by one in this process. The derived modules are\n");
+		log("        the same, but the names of internal wires and cells may differ. The\n");
+		log("        log output of the workers is not shown. (default = 1)\n");
+		log("\n");
 		log("In -generate mode this pass generates blackbox modules for the given cell\n");
 		log("types (wildcards supported). For this the design is searched for cells that\n");
 		log("match the given types and then the given port declarations are used to\n");
@@ -836,6 +1031,7 @@ struct HierarchyPass : public Pass {
 		bool nodefaults = false;
 		bool nokeep_prints = false;
 		bool nokeep_asserts = false;
+		int num_jobs = 1;
 		std::vector<std::string> generate_cells;
 		std::vector<generate_port_decl_t> generate_ports;
 		std::map<std::string, std::string> parameters;
@@ -922,6 +1118,12 @@ struct HierarchyPass : public Pass {
 				libdirs.push_back(args[++argidx]);
 				continue;
 			}
+			if (args[argidx] == "-j" && argidx+1 < args.size()) {
+				num_jobs = atoi(args[++argidx].c_str());
+				if (num_jobs <= 0)
+					num_jobs = get_num_cpus();
+				continue;
+			}
 			if (args[argidx] == "-top") {
 				if (++argidx >= args.size())
 					log_cmd_error("Option -top requires an additional argument!\n");
@@ -1066,10 +1268,14 @@ struct HierarchyPass : public Pass {
 					mod->attributes.erase(ID::initial_top);
 		}
 
+		DeriveIndex derive_index;
+		int iterations = 0;
+
 		bool did_something = true;
 		while (did_something)
 		{
 			did_something = false;
+			iterations++;
 
 			std::set<RTLIL::Module*, IdString::compare_ptr_by_name<Module>> used_modules;
 			if (top_mod != NULL) {
@@ -1080,8 +1286,11 @@ struct HierarchyPass : public Pass {
 					used_modules.insert(mod);
 			}
 
+			if (num_jobs > 1)
+				derive_index.prefetch(design, used_modules, num_jobs);
+
 			for (auto module : used_modules) {
-				if (expand_module(design, module, flag_check, flag_simcheck, flag_smtcheck, libdirs))
+				if (expand_module(design, module, flag_check, flag_simcheck, flag_smtcheck, libdirs, derive_index))
 					did_something = true;
 			}
 
@@ -1108,6 +1317,10 @@ struct HierarchyPass : public Pass {
 			}
 		}
 
+		if (derive_index.num_requests > 0)
+			log("Resolved %d parametric cell(s) to %d module specialization(s) in %d iteration(s), %d derived in worker processes.\n",
+					derive_index.num_requests, GetSize(derive_index.derived), iterations, derive_index.num_parallel);
+
 
 		if (top_mod != NULL) {
 			log_header(design, "Analyzing design hierarchy..\n");
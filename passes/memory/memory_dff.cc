@@ -607,8 +607,10 @@ struct MemoryDffWorker
 	void run()
 	{
 		std::vector<Mem> memories = Mem::get_selected_memories(module);
+		// The SAT model is shared by all memories of the module, the cones
+		// of signals used by several of them are imported only once.
+		QuickConeSat qcsat(modwalker);
 		for (auto &mem : memories) {
-			QuickConeSat qcsat(modwalker);
 			for (int i = 0; i < GetSize(mem.rd_ports); i++) {
 				if (!mem.rd_ports[i].clk_enable)
 					handle_rd_port(mem, qcsat, i);
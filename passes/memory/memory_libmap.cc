@@ -135,8 +135,10 @@ struct MapWorker {
 	SigMap sigmap;
 	SigMap sigmap_xmux;
 	FfInitVals initvals;
+	// Shared by the SAT queries of all memories in the module.
+	QuickConeSat qcsat;
 
-	MapWorker(Module *module) : module(module), modwalker(module->design, module), sigmap(module), sigmap_xmux(module), initvals(&sigmap, module) {
+	MapWorker(Module *module) : module(module), modwalker(module->design, module), sigmap(module), sigmap_xmux(module), initvals(&sigmap, module), qcsat(modwalker) {
 		for (auto cell : module->cells())
 		{
 			if (cell->type == ID($mux))
@@ -168,9 +170,34 @@ struct Swizzle {
 	std::vector<std::vector<SwizzleBit>> bits;
 };
 
+// The outcome of the configuration search for one memory.  It is reused for
+// the other memories with the same signature (see MemMapping::signature), as
+// long as the SAT queries made by the search give the same answers for them.
+struct MemMappingResult {
+	// (query kind, write port, read port) -> answer, see MemMapping::sat_query.
+	dict<std::tuple<int, int, int>, bool> queries;
+	// The port clocks of the memory the search ran on, to translate the
+	// shared clock assignments to another memory.
+	std::vector<SigBit> clks;
+	MemConfigs geom_cfgs;
+	MemConfigs cfgs;
+	std::string rejected_cfg_debug_msgs;
+};
+
+typedef dict<std::string, std::vector<MemMappingResult>> MemMappingCache;
+
+std::vector<SigBit> port_clocks(const Mem &mem) {
+	std::vector<SigBit> res;
+	for (auto &port: mem.wr_ports)
+		res.push_back(port.clk);
+	for (auto &port: mem.rd_ports)
+		res.push_back(port.clk);
+	return res;
+}
+
 struct MemMapping {
 	MapWorker &worker;
-	QuickConeSat qcsat;
+	QuickConeSat &qcsat;
 	Mem &mem;
 	const Library &lib;
 	const PassOptions &opts;
@@ -184,8 +211,11 @@ struct MemMapping {
 	dict<std::pair<int, int>, bool> wr_excludes_rd_cache;
 	dict<std::pair<int, int>, bool> wr_excludes_srst_cache;
 	std::string rejected_cfg_debug_msgs;
+	std::string cache_key;
+	// True if a new search was made, rather than reusing a cached result.
+	bool searched = false;
 
-	MemMapping(MapWorker &worker, Mem &mem, const Library &lib, const PassOptions &opts) : worker(worker), qcsat(worker.modwalker), mem(mem), lib(lib), opts(opts) {
+	MemMapping(MapWorker &worker, Mem &mem, const Library &lib, const PassOptions &opts, MemMappingCache &cache) : worker(worker), qcsat(worker.qcsat), mem(mem), lib(lib), opts(opts) {
 		determine_style();
 		logic_ok = determine_logic_ok();
 		if (GetSize(mem.wr_ports) == 0)
@@ -216,6 +246,18 @@ struct MemMapping {
 			}
 			cfgs.push_back(cfg);
 		}
+		cache_key = signature();
+		auto it = cache.find(cache_key);
+		if (it != cache.end())
+			for (auto &res: it->second)
+				if (reuse_result(res))
+					return;
+		// Only keep the answers of the queries made by the search itself.
+		wr_implies_rd_cache.clear();
+		wr_excludes_rd_cache.clear();
+		wr_excludes_srst_cache.clear();
+		size_t rejected_start = rejected_cfg_debug_msgs.size();
+		searched = true;
 		assign_wr_ports();
 		assign_rd_ports();
 		handle_trans();
@@ -226,9 +268,21 @@ struct MemMapping {
 		score_emu_ports();
 		// Now it is just a matter of picking geometry.
 		handle_geom();
+		MemMappingResult res;
+		res.geom_cfgs = cfgs;
 		dump_configs(0);
 		prune_post_geom();
 		dump_configs(1);
+		for (auto &it: wr_implies_rd_cache)
+			res.queries[std::make_tuple(0, it.first.first, it.first.second)] = it.second;
+		for (auto &it: wr_excludes_rd_cache)
+			res.queries[std::make_tuple(1, it.first.first, it.first.second)] = it.second;
+		for (auto &it: wr_excludes_srst_cache)
+			res.queries[std::make_tuple(2, it.first.first, it.first.second)] = it.second;
+		res.clks = port_clocks(mem);
+		res.cfgs = cfgs;
+		res.rejected_cfg_debug_msgs = rejected_cfg_debug_msgs.substr(rejected_start);
+		cache[cache_key].push_back(std::move(res));
 	}
 
 	bool addr_compatible(int wpidx, int rpidx) {
@@ -295,6 +349,21 @@ struct MemMapping {
 		return res;
 	}
 
+	bool sat_query(int kind, int wpidx, int rpidx) {
+		switch (kind) {
+			case 0:
+				return get_wr_implies_rd(wpidx, rpidx);
+			case 1:
+				return get_wr_excludes_rd(wpidx, rpidx);
+			case 2:
+				return get_wr_excludes_srst(wpidx, rpidx);
+			default:
+				abort();
+		}
+	}
+
+	std::string signature();
+	bool reuse_result(const MemMappingResult &res);
 	void dump_configs(int stage);
 	void dump_config(MemConfig &cfg);
 	void determine_style();
@@ -367,6 +436,82 @@ struct MemMapping {
 	}
 };
 
+// Builds the key for the configuration search cache.  It covers everything
+// the search looks at, except for the SAT queries: the memory geometry, the
+// port properties and the candidate RAMs.  The port signals are described by
+// numbering their wire bits in order of first use, so that only the sharing
+// of signals between the ports matters.
+std::string MemMapping::signature() {
+	dict<SigBit, int> index, xmux_index;
+	std::string res = stringf("%d %d %d %d %d %d %zu:%s", mem.width, mem.size, mem.start_offset, logic_ok, int(kind), mem.emulate_read_first_ok(), style.size(), style.c_str());
+	auto add_sig = [&](dict<SigBit, int> &idx, const SigSpec &sig) {
+		res += " [";
+		for (auto bit: sig) {
+			if (bit.wire)
+				res += stringf(" %d", idx.emplace(bit, GetSize(idx)).first->second);
+			else
+				res += stringf(" c%d", int(bit.data));
+		}
+		res += "]";
+	};
+	auto add_mask = [&](const std::vector<bool> &mask) {
+		res += " ";
+		for (bool x: mask)
+			res += x ? '1' : '0';
+	};
+	res += " rams";
+	for (auto &cfg: cfgs)
+		res += stringf(" %d", int(cfg.def - lib.rams.data()));
+	for (auto &port: mem.wr_ports) {
+		res += stringf(" W %d %d %d %d", port.clk_enable, port.clk_polarity, port.wide_log2, GetSize(port.data));
+		add_mask(port.priority_mask);
+		add_sig(index, port.clk);
+		add_sig(index, port.en);
+		add_sig(index, port.addr);
+		add_sig(xmux_index, worker.sigmap_xmux(port.addr));
+	}
+	for (auto &port: mem.rd_ports) {
+		res += stringf(" R %d %d %d %d %d", port.clk_enable, port.clk_polarity, port.ce_over_srst, port.wide_log2, GetSize(port.data));
+		add_mask(port.transparency_mask);
+		add_mask(port.collision_x_mask);
+		add_sig(index, port.clk);
+		add_sig(index, port.en);
+		add_sig(index, port.arst);
+		add_sig(index, port.srst);
+		add_sig(index, port.addr);
+		add_sig(xmux_index, worker.sigmap_xmux(port.addr));
+		res += stringf(" %s %s %s", port.init_value.as_string().c_str(), port.arst_value.as_string().c_str(), port.srst_value.as_string().c_str());
+	}
+	return res;
+}
+
+// Takes over a cached search result if all its SAT queries have the same
+// answer for this memory.
+bool MemMapping::reuse_result(const MemMappingResult &res) {
+	for (auto &it: res.queries)
+		if (sat_query(std::get<0>(it.first), std::get<1>(it.first), std::get<2>(it.first)) != it.second)
+			return false;
+	std::vector<SigBit> clks = port_clocks(mem);
+	dict<SigBit, SigBit> clk_map;
+	for (int i = 0; i < GetSize(clks); i++)
+		clk_map[res.clks[i]] = clks[i];
+	auto translate = [&](const MemConfigs &src) {
+		MemConfigs dst = src;
+		for (auto &cfg: dst)
+			for (auto &ccfg: cfg.shared_clocks)
+				if (ccfg.used)
+					ccfg.clk = clk_map.at(ccfg.clk);
+		return dst;
+	};
+	log_debug("memory %s.%s: reusing cached mapping search result\n", log_id(mem.module->name), log_id(mem.memid));
+	rejected_cfg_debug_msgs += res.rejected_cfg_debug_msgs;
+	cfgs = translate(res.geom_cfgs);
+	dump_configs(0);
+	cfgs = translate(res.cfgs);
+	dump_configs(1);
+	return true;
+}
+
 void MemMapping::dump_configs(int stage) {
 	const char *stage_name;
 	switch (stage) {
@@ -2148,6 +2293,146 @@ void MemMapping::emit(const MemConfig &cfg) {
 	mem.remove();
 }
 
+// Serialization of search results for the worker processes.  The clocks are
+// written as indices into MemMappingResult::clks, which the reader fills in
+// from the same memory.
+std::string dump_mapping_result(const MemMappingResult &res, const Library &lib) {
+	std::string f = stringf("%d %d %d %zu\n", GetSize(res.queries), GetSize(res.geom_cfgs), GetSize(res.cfgs), res.rejected_cfg_debug_msgs.size());
+	for (auto &it: res.queries)
+		f += stringf("%d %d %d %d\n", std::get<0>(it.first), std::get<1>(it.first), std::get<2>(it.first), it.second);
+	for (auto cfgs: {&res.geom_cfgs, &res.cfgs})
+		for (auto &cfg: *cfgs) {
+			f += stringf("%d %d %d %d %d %d %d %d %d %d %d %a", int(cfg.def - lib.rams.data()), cfg.emu_read_first, cfg.base_width_log2, cfg.unit_width_log2,
+					cfg.hard_wide_mask, cfg.emu_wide_mask, cfg.repl_d, cfg.repl_port, cfg.score_emu, cfg.score_mux, cfg.score_demux, cfg.cost);
+			f += stringf(" %d", GetSize(cfg.swizzle));
+			for (int x: cfg.swizzle)
+				f += stringf(" %d", x);
+			f += stringf(" %d", GetSize(cfg.wr_ports));
+			for (auto &pcfg: cfg.wr_ports) {
+				f += stringf(" %d %d %d %d %d", pcfg.rd_port, pcfg.port_group, pcfg.port_variant, pcfg.force_uniform, GetSize(pcfg.emu_prio));
+				for (int x: pcfg.emu_prio)
+					f += stringf(" %d", x);
+			}
+			f += stringf(" %d", GetSize(cfg.rd_ports));
+			for (auto &pcfg: cfg.rd_ports) {
+				f += stringf(" %d %d %d %d %d %d %d %d %d %d %d", pcfg.wr_port, pcfg.port_group, pcfg.port_variant, pcfg.emu_sync, pcfg.emu_en, pcfg.emu_arst,
+						pcfg.emu_srst, pcfg.emu_init, pcfg.emu_srst_en_prio, pcfg.rd_en_to_clk_en, GetSize(pcfg.emu_trans));
+				for (int x: pcfg.emu_trans)
+					f += stringf(" %d", x);
+			}
+			f += stringf(" %d", GetSize(cfg.shared_clocks));
+			for (int i = 0; i < GetSize(cfg.shared_clocks); i++) {
+				auto &ccfg = cfg.shared_clocks[i];
+				if (!ccfg.used) {
+					f += " -1";
+					continue;
+				}
+				int clk_idx = std::find(res.clks.begin(), res.clks.end(), ccfg.clk) - res.clks.begin();
+				f += stringf(" %d %d", clk_idx, cfg.def->shared_clocks[i].anyedge ? ccfg.polarity : ccfg.invert);
+			}
+			f += "\n";
+		}
+	f += res.rejected_cfg_debug_msgs;
+	return f;
+}
+
+bool parse_mapping_result(std::istream &f, MemMappingResult &res, const Library &lib) {
+	int num_queries, num_geom_cfgs, num_cfgs;
+	size_t rejected_size;
+	if (!(f >> num_queries >> num_geom_cfgs >> num_cfgs >> rejected_size))
+		return false;
+	for (int i = 0; i < num_queries; i++) {
+		int kind, wpidx, rpidx, answer;
+		if (!(f >> kind >> wpidx >> rpidx >> answer))
+			return false;
+		res.queries[std::make_tuple(kind, wpidx, rpidx)] = answer;
+	}
+	auto read_vector = [&](std::vector<int> &vec) {
+		int num;
+		if (!(f >> num) || num < 0)
+			return false;
+		vec.resize(num);
+		for (auto &x: vec)
+			if (!(f >> x))
+				return false;
+		return true;
+	};
+	for (int i = 0; i < num_geom_cfgs + num_cfgs; i++) {
+		MemConfig cfg;
+		int def_idx, emu_read_first, num_ports;
+		std::string cost;
+		if (!(f >> def_idx >> emu_read_first >> cfg.base_width_log2 >> cfg.unit_width_log2 >> cfg.hard_wide_mask >> cfg.emu_wide_mask >>
+				cfg.repl_d >> cfg.repl_port >> cfg.score_emu >> cfg.score_mux >> cfg.score_demux >> cost))
+			return false;
+		if (def_idx < 0 || def_idx >= GetSize(lib.rams))
+			return false;
+		cfg.def = &lib.rams[def_idx];
+		cfg.emu_read_first = emu_read_first;
+		cfg.cost = strtod(cost.c_str(), nullptr);
+		if (!read_vector(cfg.swizzle) || !(f >> num_ports))
+			return false;
+		auto valid_variant = [&](int pgi, int pvi) {
+			return pgi >= 0 && pgi < GetSize(cfg.def->port_groups) && pvi >= 0 && pvi < GetSize(cfg.def->port_groups[pgi].variants);
+		};
+		for (int j = 0; j < num_ports; j++) {
+			WrPortConfig pcfg;
+			int force_uniform;
+			if (!(f >> pcfg.rd_port >> pcfg.port_group >> pcfg.port_variant >> force_uniform) || !read_vector(pcfg.emu_prio))
+				return false;
+			if (!valid_variant(pcfg.port_group, pcfg.port_variant))
+				return false;
+			pcfg.def = &cfg.def->port_groups[pcfg.port_group].variants[pcfg.port_variant];
+			pcfg.force_uniform = force_uniform;
+			cfg.wr_ports.push_back(pcfg);
+		}
+		if (!(f >> num_ports))
+			return false;
+		for (int j = 0; j < num_ports; j++) {
+			RdPortConfig pcfg;
+			int flags[7];
+			if (!(f >> pcfg.wr_port >> pcfg.port_group >> pcfg.port_variant))
+				return false;
+			for (auto &x: flags)
+				if (!(f >> x))
+					return false;
+			if (!read_vector(pcfg.emu_trans) || !valid_variant(pcfg.port_group, pcfg.port_variant))
+				return false;
+			pcfg.def = &cfg.def->port_groups[pcfg.port_group].variants[pcfg.port_variant];
+			pcfg.emu_sync = flags[0];
+			pcfg.emu_en = flags[1];
+			pcfg.emu_arst = flags[2];
+			pcfg.emu_srst = flags[3];
+			pcfg.emu_init = flags[4];
+			pcfg.emu_srst_en_prio = flags[5];
+			pcfg.rd_en_to_clk_en = flags[6];
+			cfg.rd_ports.push_back(pcfg);
+		}
+		int num_clocks;
+		if (!(f >> num_clocks) || num_clocks != GetSize(cfg.def->shared_clocks))
+			return false;
+		for (int j = 0; j < num_clocks; j++) {
+			SharedClockConfig ccfg;
+			int clk_idx, value;
+			ccfg.used = false;
+			if (!(f >> clk_idx))
+				return false;
+			if (clk_idx != -1) {
+				if (clk_idx < 0 || clk_idx >= GetSize(res.clks) || !(f >> value))
+					return false;
+				ccfg.used = true;
+				ccfg.clk = res.clks[clk_idx];
+				ccfg.polarity = ccfg.invert = value;
+			}
+			cfg.shared_clocks.push_back(ccfg);
+		}
+		(i < num_geom_cfgs ? res.geom_cfgs : res.cfgs).push_back(cfg);
+	}
+	if (f.get() != '\n')
+		return false;
+	res.rejected_cfg_debug_msgs.resize(rejected_size);
+	return rejected_size == 0 || bool(f.read(&res.rejected_cfg_debug_msgs[0], rejected_size));
+}
+
 struct MemoryLibMapPass : public Pass {
 	MemoryLibMapPass() : Pass("memory_libmap", "map memories to cells") { }
 	void help() override
@@ -2179,6 +2464,15 @@ struct MemoryLibMapPass : public Pass {
 		log("    Disables automatic mapping of given kind of RAMs.  Manual mapping\n");
 		log("    (using ram_style or other attributes) is still supported.\n");
 		log("\n");
+		log("  -j <N>\n");
+		log("    Runs the search for mapping candidates of the memories in each module\n");
+		log("    in N worker processes. N = 0 uses one worker per CPU. The log output of\n");
+		log("    the workers is not shown. (default = 1)\n");
+		log("\n");
+		log("The search results are cached and reused for memories of the same shape\n");
+		log("(width, depth, port configuration and sharing of signals between the ports)\n");
+		log("if the SAT queries about their enable and reset signals give the same answers.\n");
+		log("\n");
 	}
 	void execute(std::vector<std::string> args, RTLIL::Design *design) override
 	{
@@ -2190,6 +2484,7 @@ struct MemoryLibMapPass : public Pass {
 		opts.no_auto_huge = false;
 		opts.logic_cost_ram = 1.0;
 		opts.logic_cost_rom = 1.0/16.0;
+		int num_jobs = 1;
 		log_header(design, "Executing MEMORY_LIBMAP pass (mapping memories to cells).\n");
 
 		size_t argidx;
@@ -2222,18 +2517,57 @@ struct MemoryLibMapPass : public Pass {
 				opts.logic_cost_ram = strtod(args[++argidx].c_str(), nullptr);
 				continue;
 			}
+			if (args[argidx] == "-j" && argidx+1 < args.size()) {
+				num_jobs = atoi(args[++argidx].c_str());
+				if (num_jobs <= 0)
+					num_jobs = get_num_cpus();
+				continue;
+			}
 			break;
 		}
 		extra_args(args, argidx, design);
 
 		Library lib = parse_library(lib_files, defines);
+		MemMappingCache cache;
 
 		for (auto module : design->selected_modules()) {
 			MapWorker worker(module);
 			auto mems = Mem::get_selected_memories(module);
+			int num_workers = std::min(num_jobs, GetSize(mems));
+			if (num_workers > 1)
+			{
+				// The workers only fill the cache, the memories are then
+				// mapped here in the usual order.  Each result is sent as
+				// "<memory index> <key size>\n<key>" and the dumped result.
+				log("Searching mapping candidates for %d memories in module %s in %d worker process(es).\n", GetSize(mems), log_id(module), num_workers);
+				std::vector<std::string> results = run_worker_processes(num_workers, [&](int w) {
+					std::string result;
+					for (int i = w; i < GetSize(mems); i += num_workers) {
+						MemMapping map(worker, mems[i], lib, opts, cache);
+						if (map.searched)
+							result += stringf("%d %zu\n", i, map.cache_key.size()) + map.cache_key + dump_mapping_result(cache.at(map.cache_key).back(), lib);
+					}
+					return result;
+				});
+				for (auto &result : results) {
+					std::istringstream f(result);
+					int idx;
+					size_t key_size;
+					while (f >> idx >> key_size) {
+						std::string key(key_size, ' ');
+						MemMappingResult res;
+						if (idx < 0 || idx >= GetSize(mems) || f.get() != '\n' || !f.read(&key[0], key_size))
+							log_error("Unexpected result from memory_libmap worker process.\n");
+						res.clks = port_clocks(mems[idx]);
+						if (!parse_mapping_result(f, res, lib))
+							log_error("Unexpected result from memory_libmap worker process.\n");
+						cache[key].push_back(std::move(res));
+					}
+				}
+			}
 			for (auto &mem : mems)
 			{
-				MemMapping map(worker, mem, lib, opts);
+				MemMapping map(worker, mem, lib, opts, cache);
 				int idx = -1;
 				int best = map.logic_cost;
 				if (!map.logic_ok) {
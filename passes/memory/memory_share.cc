@@ -36,6 +36,7 @@ struct MemoryShareWorker
 	FfInitVals initvals;
 	bool flag_widen;
 	bool flag_sat;
+	int num_jobs;
 
 	// --------------------------------------------------
 	// Consolidate read ports that read the same address
@@ -293,10 +294,15 @@ struct MemoryShareWorker
 	// Consolidate write ports using sat-based resource sharing
 	// --------------------------------------------------------
 
-	void consolidate_wr_using_sat(Mem &mem)
+	// Finds the write ports that can be merged according to the SAT solver,
+	// without modifying the module.  The model in qcsat is shared between
+	// all memories of the module.  Returns the (port, merged port) pairs in
+	// the order they need to be merged in.
+	std::vector<std::pair<int, int>> plan_wr_merges_using_sat(Mem &mem, QuickConeSat &qcsat)
 	{
+		std::vector<std::pair<int, int>> merges;
 		if (GetSize(mem.wr_ports) <= 1)
-			return;
+			return merges;
 
 		// Get a list of ports that have any chance of being mergeable.
 
@@ -313,7 +319,7 @@ struct MemoryShareWorker
 		}
 
 		if (eligible_ports.size() <= 1)
-			return;
+			return merges;
 
 		log("Consolidating write ports of memory %s.%s using sat-based resource sharing:\n", log_id(module), log_id(mem.memid));
 
@@ -361,7 +367,6 @@ struct MemoryShareWorker
 			groups.push_back(group);
 		}
 
-		bool changed = false;
 		for (auto &group : groups) {
 			auto &some_port = mem.wr_ports[group[0]];
 			string ports;
@@ -378,8 +383,6 @@ struct MemoryShareWorker
 
 			// Okay, time to actually run the SAT solver.
 
-			QuickConeSat qcsat(modwalker);
-
 			// create SAT representation of common input cone of all considered EN signals
 
 			dict<int, int> port_to_sat_variable;
@@ -389,21 +392,20 @@ struct MemoryShareWorker
 
 			qcsat.prepare();
 
-			log("  Common input cone for all EN signals: %d cells.\n", GetSize(qcsat.imported_cells));
+			log("  Input cone of all EN signals in the module so far: %d cells.\n", GetSize(qcsat.imported_cells));
 
 			log("  Size of unconstrained SAT problem: %d variables, %d clauses\n", qcsat.ez->numCnfVariables(), qcsat.ez->numCnfClauses());
 
 			// now try merging the ports.
 
+			pool<int> removed;
 			for (int ii = 0; ii < GetSize(group); ii++) {
 				int idx1 = group[ii];
-				auto &port1 = mem.wr_ports[idx1];
-				if (port1.removed)
+				if (removed.count(idx1))
 					continue;
 				for (int jj = ii + 1; jj < GetSize(group); jj++) {
 					int idx2 = group[jj];
-					auto &port2 = mem.wr_ports[idx2];
-					if (port2.removed)
+					if (removed.count(idx2))
 						continue;
 
 					if (qcsat.ez->solve(port_to_sat_variable.at(idx1), port_to_sat_variable.at(idx2))) {
@@ -412,63 +414,74 @@ struct MemoryShareWorker
 					}
 
 					log("  Merging port %d into port %d.\n", idx2, idx1);
-					mem.prepare_wr_merge(idx1, idx2, &initvals);
 					port_to_sat_variable.at(idx1) = qcsat.ez->OR(port_to_sat_variable.at(idx1), port_to_sat_variable.at(idx2));
+					merges.push_back(std::make_pair(idx1, idx2));
+					removed.insert(idx2);
+				}
+			}
+		}
 
-					RTLIL::SigSpec last_addr = port1.addr;
-					RTLIL::SigSpec last_data = port1.data;
-					std::vector<RTLIL::SigBit> last_en = modwalker.sigmap(port1.en);
-
-					RTLIL::SigSpec this_addr = port2.addr;
-					RTLIL::SigSpec this_data = port2.data;
-					std::vector<RTLIL::SigBit> this_en = modwalker.sigmap(port2.en);
-
-					RTLIL::SigBit this_en_active = module->ReduceOr(NEW_ID, this_en);
-
-					if (GetSize(last_addr) < GetSize(this_addr))
-						last_addr.extend_u0(GetSize(this_addr));
-					else
-						this_addr.extend_u0(GetSize(last_addr));
-
-					SigSpec new_addr = module->Mux(NEW_ID, last_addr.extract_end(port1.wide_log2), this_addr.extract_end(port1.wide_log2), this_en_active);
-
-					port1.addr = SigSpec({new_addr, port1.addr.extract(0, port1.wide_log2)});
-					port1.data = module->Mux(NEW_ID, last_data, this_data, this_en_active);
-
-					std::map<std::pair<RTLIL::SigBit, RTLIL::SigBit>, int> groups_en;
-					RTLIL::SigSpec grouped_last_en, grouped_this_en, en;
-					RTLIL::Wire *grouped_en = module->addWire(NEW_ID, 0);
-
-					for (int j = 0; j < int(this_en.size()); j++) {
-						std::pair<RTLIL::SigBit, RTLIL::SigBit> key(last_en[j], this_en[j]);
-						if (!groups_en.count(key)) {
-							grouped_last_en.append(last_en[j]);
-							grouped_this_en.append(this_en[j]);
-							groups_en[key] = grouped_en->width;
-							grouped_en->width++;
-						}
-						en.append(RTLIL::SigSpec(grouped_en, groups_en[key]));
-					}
-
-					module->addMux(NEW_ID, grouped_last_en, grouped_this_en, this_en_active, grouped_en);
-					port1.en = en;
+		return merges;
+	}
 
-					port2.removed = true;
-					changed = true;
+	void merge_wr_ports(Mem &mem, const std::vector<std::pair<int, int>> &merges)
+	{
+		for (auto &it : merges) {
+			int idx1 = it.first, idx2 = it.second;
+			auto &port1 = mem.wr_ports[idx1];
+			auto &port2 = mem.wr_ports[idx2];
+			mem.prepare_wr_merge(idx1, idx2, &initvals);
+
+			RTLIL::SigSpec last_addr = port1.addr;
+			RTLIL::SigSpec last_data = port1.data;
+			std::vector<RTLIL::SigBit> last_en = modwalker.sigmap(port1.en);
+
+			RTLIL::SigSpec this_addr = port2.addr;
+			RTLIL::SigSpec this_data = port2.data;
+			std::vector<RTLIL::SigBit> this_en = modwalker.sigmap(port2.en);
+
+			RTLIL::SigBit this_en_active = module->ReduceOr(NEW_ID, this_en);
+
+			if (GetSize(last_addr) < GetSize(this_addr))
+				last_addr.extend_u0(GetSize(this_addr));
+			else
+				this_addr.extend_u0(GetSize(last_addr));
+
+			SigSpec new_addr = module->Mux(NEW_ID, last_addr.extract_end(port1.wide_log2), this_addr.extract_end(port1.wide_log2), this_en_active);
+
+			port1.addr = SigSpec({new_addr, port1.addr.extract(0, port1.wide_log2)});
+			port1.data = module->Mux(NEW_ID, last_data, this_data, this_en_active);
+
+			std::map<std::pair<RTLIL::SigBit, RTLIL::SigBit>, int> groups_en;
+			RTLIL::SigSpec grouped_last_en, grouped_this_en, en;
+			RTLIL::Wire *grouped_en = module->addWire(NEW_ID, 0);
+
+			for (int j = 0; j < int(this_en.size()); j++) {
+				std::pair<RTLIL::SigBit, RTLIL::SigBit> key(last_en[j], this_en[j]);
+				if (!groups_en.count(key)) {
+					grouped_last_en.append(last_en[j]);
+					grouped_this_en.append(this_en[j]);
+					groups_en[key] = grouped_en->width;
+					grouped_en->width++;
 				}
+				en.append(RTLIL::SigSpec(grouped_en, groups_en[key]));
 			}
+
+			module->addMux(NEW_ID, grouped_last_en, grouped_this_en, this_en_active, grouped_en);
+			port1.en = en;
+
+			port2.removed = true;
 		}
 
-		if (changed)
+		if (!merges.empty())
 			mem.emit();
 	}
 
-
 	// -------------
 	// Setup and run
 	// -------------
 
-	MemoryShareWorker(RTLIL::Design *design, bool flag_widen, bool flag_sat) : design(design), modwalker(design), flag_widen(flag_widen), flag_sat(flag_sat) {}
+	MemoryShareWorker(RTLIL::Design *design, bool flag_widen, bool flag_sat, int num_jobs) : design(design), modwalker(design), flag_widen(flag_widen), flag_sat(flag_sat), num_jobs(num_jobs) {}
 
 	void operator()(RTLIL::Module* module)
 	{
@@ -503,8 +516,60 @@ struct MemoryShareWorker
 
 		modwalker.setup(module);
 
-		for (auto &mem : memories)
-			consolidate_wr_using_sat(mem);
+		std::vector<int> work;
+		for (int i = 0; i < GetSize(memories); i++)
+			if (GetSize(memories[i].wr_ports) > 1)
+				work.push_back(i);
+
+		int num_workers = std::min(num_jobs, GetSize(work));
+		if (num_workers <= 1) {
+			// One SAT model for the whole module, so that the input cones
+			// shared between memories are only imported once.
+			QuickConeSat qcsat(modwalker);
+			for (int i : work)
+				merge_wr_ports(memories[i], plan_wr_merges_using_sat(memories[i], qcsat));
+			return;
+		}
+
+		log("Checking write ports of %d memories in module %s in %d worker process(es).\n", GetSize(work), log_id(module), num_workers);
+
+		// The planning step does not modify the module, each worker only
+		// reports the "<memory> <port> <merged port>" triples it found.
+		std::vector<bool> failed;
+		std::vector<std::string> results = run_worker_processes(num_workers, [&](int w) {
+			QuickConeSat qcsat(modwalker);
+			std::string result;
+			for (int i = w; i < GetSize(work); i += num_workers)
+				for (auto &it : plan_wr_merges_using_sat(memories[work[i]], qcsat))
+					result += stringf("%d %d %d\n", work[i], it.first, it.second);
+			return result;
+		}, &failed);
+
+		dict<int, std::vector<std::pair<int, int>>> merges;
+		for (int w = 0; w < num_workers; w++)
+		{
+			if (failed[w]) {
+				QuickConeSat qcsat(modwalker);
+				for (int i = w; i < GetSize(work); i += num_workers)
+					merges[work[i]] = plan_wr_merges_using_sat(memories[work[i]], qcsat);
+				continue;
+			}
+			for (auto &line : split_tokens(results[w], "\n")) {
+				int i, idx1, idx2;
+				if (sscanf(line.c_str(), "%d %d %d", &i, &idx1, &idx2) != 3 || i < 0 || i >= GetSize(memories) ||
+						idx1 < 0 || idx1 >= GetSize(memories[i].wr_ports) || idx2 < 0 || idx2 >= GetSize(memories[i].wr_ports))
+					log_error("Unexpected result from memory_share worker process: %s\n", line.c_str());
+				merges[i].push_back(std::make_pair(idx1, idx2));
+			}
+		}
+
+		for (int i : work) {
+			if (!merges.count(i))
+				continue;
+			for (auto &it : merges.at(i))
+				log("Merging write port %d into write port %d of memory %s.%s.\n", it.second, it.first, log_id(module), log_id(memories[i].memid));
+			merge_wr_ports(memories[i], merges.at(i));
+		}
 	}
 };
 
@@ -514,7 +579,7 @@ struct MemorySharePass : public Pass {
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
 		log("\n");
-		log("    memory_share [-nosat] [-nowiden] [selection]\n");
+		log("    memory_share [-nosat] [-nowiden] [-j N] [selection]\n");
 		log("\n");
 		log("This pass merges share-able memory ports into single memory ports.\n");
 		log("\n");
@@ -531,6 +596,12 @@ struct MemorySharePass : public Pass {
 		log("    solver is used to determine this), then the ports are merged into a single\n");
 		log("    write port.  This transformation can be disabled with the \"-nosat\" option.\n");
 		log("\n");
+		log("The SAT queries of all memories in a module share one model of the module's\n");
+		log("logic. With \"-j N\" the memories of a module are checked in N worker\n");
+		log("processes instead, each with its own model, and the merges they find are\n");
+		log("performed afterwards. N = 0 uses one worker per CPU. The log output of the\n");
+		log("workers is not shown. (default = 1)\n");
+		log("\n");
 		log("Note that in addition to the algorithms implemented in this pass, the $memrd\n");
 		log("and $memwr cells are also subject to generic resource sharing passes (and other\n");
 		log("optimizations) such as \"share\" and \"opt_merge\".\n");
@@ -539,6 +610,7 @@ struct MemorySharePass : public Pass {
 	void execute(std::vector<std::string> args, RTLIL::Design *design) override {
 		bool flag_widen = true;
 		bool flag_sat = true;
+		int num_jobs = 1;
 		log_header(design, "Executing MEMORY_SHARE pass (consolidating $memrd/$memwr cells).\n");
 		size_t argidx;
 		for (argidx = 1; argidx < args.size(); argidx++)
@@ -553,10 +625,17 @@ struct MemorySharePass : public Pass {
 				flag_widen = false;
 				continue;
 			}
+			if (args[argidx] == "-j" && argidx+1 < args.size())
+			{
+				num_jobs = atoi(args[++argidx].c_str());
+				if (num_jobs <= 0)
+					num_jobs = get_num_cpus();
+				continue;
+			}
 			break;
 		}
 		extra_args(args, argidx, design);
-		MemoryShareWorker msw(design, flag_widen, flag_sat);
+		MemoryShareWorker msw(design, flag_widen, flag_sat, num_jobs);
 
 		for (auto module : design->selected_modules())
 			msw(module);
@@ -18,13 +18,210 @@
  */
 
 #include "kernel/register.h"
+#include "kernel/sigtools.h"
 #include "kernel/log.h"
+#include "backends/rtlil/rtlil_backend.h"
 #include <stdlib.h>
 #include <stdio.h>
 
+YOSYS_NAMESPACE_BEGIN
+extern int proc_clean_module(RTLIL::Module *mod, bool quiet);
+extern int proc_rmdead_module(RTLIL::Module *mod);
+extern void proc_prune_module(RTLIL::Module *mod, const SigMap &sigmap, int &removed_count, int &promoted_count);
+extern void proc_init_module(RTLIL::Module *mod, SigMap &sigmap);
+extern void proc_arst_module(RTLIL::Module *mod, SigMap &assign_map, const std::string &global_arst, bool global_arst_neg);
+extern int proc_rom_module(RTLIL::Module *mod);
+extern void proc_mux_module(RTLIL::Module *mod, bool ifxmode);
+extern void proc_dlatch_module(RTLIL::Module *mod, SigMap &&sigmap);
+extern void proc_dff_module(RTLIL::Module *mod);
+extern void proc_memwr_module(RTLIL::Module *mod);
+YOSYS_NAMESPACE_END
+
 USING_YOSYS_NAMESPACE
 PRIVATE_NAMESPACE_BEGIN
 
+struct FusedProcWorker
+{
+	std::string global_arst;
+	bool global_arst_neg = false;
+	bool ifxmode = false;
+	bool nomux = false;
+	bool norom = false;
+
+	int clean_count = 0, dead_count = 0, removed_count = 0, promoted_count = 0, rom_count = 0;
+
+	// Run all proc_* stages on one module. The stages are module-local, so
+	// this gives the same result as running each pass over the whole design.
+	// A single SigMap is built for the module and extended with the
+	// connections created by the earlier stages instead of being rebuilt by
+	// every stage.
+	void run(RTLIL::Module *mod)
+	{
+		bool boxed = mod->get_blackbox_attribute();
+
+		clean_count += proc_clean_module(mod, false);
+		if (!ifxmode)
+			dead_count += proc_rmdead_module(mod);
+
+		SigMap sigmap(mod);
+		int num_connections = GetSize(mod->connections());
+		auto update_sigmap = [&]() {
+			auto &connections = mod->connections();
+			for (int i = num_connections; i < GetSize(connections); i++)
+				sigmap.add(connections[i].first, connections[i].second);
+			num_connections = GetSize(connections);
+		};
+
+		proc_prune_module(mod, sigmap, removed_count, promoted_count);
+		update_sigmap();
+		proc_init_module(mod, sigmap);
+		proc_arst_module(mod, sigmap, global_arst, global_arst_neg);
+		if (!norom)
+			rom_count += proc_rom_module(mod);
+		if (!nomux)
+			proc_mux_module(mod, ifxmode);
+		if (!boxed) {
+			update_sigmap();
+			proc_dlatch_module(mod, std::move(sigmap));
+		}
+		proc_dff_module(mod);
+		if (!boxed)
+			proc_memwr_module(mod);
+		clean_count += proc_clean_module(mod, false);
+	}
+
+	static bool has_processes(RTLIL::Module *mod)
+	{
+		for (auto &proc_it : mod->processes)
+			if (mod->design->selected(mod, proc_it.second))
+				return true;
+		return false;
+	}
+
+	static void replace_module(RTLIL::Module *mod, RTLIL::Module *src)
+	{
+		for (auto cell : mod->cells().to_vector())
+			mod->remove(cell);
+		std::vector<RTLIL::Process*> procs;
+		for (auto &proc_it : mod->processes)
+			procs.push_back(proc_it.second);
+		for (auto proc : procs)
+			mod->remove(proc);
+		for (auto &it : mod->memories)
+			delete it.second;
+		mod->memories.clear();
+		mod->new_connections(std::vector<RTLIL::SigSig>());
+		pool<RTLIL::Wire*> wires;
+		for (auto wire : mod->wires())
+			wires.insert(wire);
+		mod->remove(wires);
+		src->cloneInto(mod);
+	}
+
+	void run_design(RTLIL::Design *design, int num_jobs)
+	{
+		std::vector<RTLIL::Module*> work;
+		for (auto mod : design->modules())
+			if (design->selected(mod) && has_processes(mod))
+				work.push_back(mod);
+
+		if (num_jobs > 1 && GetSize(work) > 1)
+			run_parallel(design, work, num_jobs);
+		else
+			for (auto mod : work)
+				run(mod);
+
+		log("Converted processes in %d module%s.\n", GetSize(work), GetSize(work) == 1 ? "" : "s");
+		log("Cleaned up %d empty switch%s and removed %d dead case%s.\n", clean_count, clean_count == 1 ? "" : "es",
+				dead_count, dead_count == 1 ? "" : "s");
+		log("Removed %d redundant assignment%s and promoted %d assignment%s to connection%s.\n",
+				removed_count, removed_count == 1 ? "" : "s", promoted_count, promoted_count == 1 ? "" : "s",
+				promoted_count == 1 ? "" : "s");
+		if (!norom)
+			log("Converted %d switch%s to ROMs.\n", rom_count, rom_count == 1 ? "" : "es");
+	}
+
+	void run_parallel(RTLIL::Design *design, std::vector<RTLIL::Module*> &work, int num_jobs)
+	{
+		// biggest modules first, so that they don't end up in the same worker
+		auto size = [](RTLIL::Module *mod) {
+			int n = 0;
+			for (auto &proc_it : mod->processes)
+				n += GetSize(proc_it.second->syncs) + GetSize(proc_it.second->root_case.switches) + GetSize(proc_it.second->root_case.actions);
+			return n;
+		};
+		std::stable_sort(work.begin(), work.end(), [&](RTLIL::Module *a, RTLIL::Module *b) { return size(a) > size(b); });
+
+		int num_workers = std::min(num_jobs, GetSize(work));
+		log("Converting processes in %d modules in %d worker process(es).\n", GetSize(work), num_workers);
+
+		// The result of a worker is its final autoidx and the counters,
+		// followed by "<index> <rtlil size>\n<rtlil>" for each module.
+		std::vector<bool> failed;
+		std::vector<std::string> results = run_worker_processes(num_workers, [&](int w) {
+			int counts[5] = {clean_count, dead_count, removed_count, promoted_count, rom_count};
+			std::string result;
+			for (int i = w; i < GetSize(work); i += num_workers) {
+				run(work[i]);
+				std::stringstream rtlil;
+				RTLIL_BACKEND::dump_module(rtlil, "", work[i], design, false);
+				result += stringf("%d %d\n", i, GetSize(rtlil.str()));
+				result += rtlil.str();
+			}
+			return stringf("%d %d %d %d %d %d\n", autoidx, clean_count - counts[0], dead_count - counts[1],
+					removed_count - counts[2], promoted_count - counts[3], rom_count - counts[4]) + result;
+		}, &failed);
+
+		std::vector<bool> done(GetSize(work));
+		for (int w = 0; w < num_workers; w++)
+		{
+			if (failed[w])
+				continue;
+
+			const std::string &result = results[w];
+			int worker_autoidx, counts[5];
+			size_t pos = result.find('\n');
+			if (pos == std::string::npos || sscanf(result.c_str(), "%d %d %d %d %d %d", &worker_autoidx,
+					&counts[0], &counts[1], &counts[2], &counts[3], &counts[4]) != 6)
+				log_error("Unexpected result from proc worker process.\n");
+			// names created by the workers must not be created again here
+			autoidx = std::max(autoidx, worker_autoidx);
+			clean_count += counts[0], dead_count += counts[1], removed_count += counts[2];
+			promoted_count += counts[3], rom_count += counts[4];
+			pos++;
+
+			RTLIL::Design scratch;
+			while (pos < result.size()) {
+				int index, rtlil_size;
+				size_t eol = result.find('\n', pos);
+				if (eol == std::string::npos || sscanf(result.c_str() + pos, "%d %d", &index, &rtlil_size) != 2 ||
+						index < 0 || index >= GetSize(work))
+					log_error("Unexpected result from proc worker process.\n");
+				std::istringstream f(result.substr(eol + 1, rtlil_size));
+				pos = eol + 1 + rtlil_size;
+
+				RTLIL::Module *mod = work[index];
+				{
+					LogMakeDebugHdl debug_hdl(true);
+					Frontend::frontend_call(&scratch, &f, "<proc worker>", "read_rtlil");
+				}
+				RTLIL::Module *src = scratch.module(mod->name);
+				if (src == nullptr)
+					log_error("Unexpected result from proc worker process.\n");
+				replace_module(mod, src);
+				scratch.remove(src);
+				done[index] = true;
+			}
+		}
+
+		// a failed worker (e.g. a latch in an always_comb process) is
+		// repeated here, so that its messages end up in the log
+		for (int i = 0; i < GetSize(work); i++)
+			if (!done[i])
+				run(work[i]);
+	}
+};
+
 struct ProcPass : public Pass {
 	ProcPass() : Pass("proc", "translate processes to netlists") { }
 	void help() override
@@ -69,6 +266,18 @@ struct ProcPass : public Pass {
 		log("    -noopt\n");
 		log("        Will omit the opt_expr pass.\n");
 		log("\n");
+		log("    -fused\n");
+		log("        Run all proc_* stages on one module before moving on to the next one,\n");
+		log("        sharing the signal map between the stages and skipping stages that\n");
+		log("        have nothing to do. The result is the same, but the log only contains\n");
+		log("        summary counts instead of the output of each pass.\n");
+		log("\n");
+		log("    -j <N>\n");
+		log("        Implies -fused. Convert the processes of different modules in up to N\n");
+		log("        parallel worker processes (0 for the number of CPUs). The names of\n");
+		log("        internal wires and cells may differ. The log output of the workers\n");
+		log("        is not shown. (default = 1)\n");
+		log("\n");
 	}
 	void execute(std::vector<std::string> args, RTLIL::Design *design) override
 	{
@@ -77,6 +286,8 @@ struct ProcPass : public Pass {
 		bool nomux = false;
 		bool noopt = false;
 		bool norom = false;
+		bool fused = false;
+		int num_jobs = 1;
 
 		log_header(design, "Executing PROC pass (convert processes to netlists).\n");
 		log_push();
@@ -104,10 +315,43 @@ struct ProcPass : public Pass {
 				norom = true;
 				continue;
 			}
+			if (args[argidx] == "-fused") {
+				fused = true;
+				continue;
+			}
+			if (args[argidx] == "-j" && argidx+1 < args.size()) {
+				num_jobs = atoi(args[++argidx].c_str());
+				if (num_jobs <= 0)
+					num_jobs = get_num_cpus();
+				fused = true;
+				continue;
+			}
 			break;
 		}
 		extra_args(args, argidx, design);
 
+		if (fused)
+		{
+			FusedProcWorker worker;
+			worker.ifxmode = ifxmode;
+			worker.nomux = nomux;
+			worker.norom = norom;
+			if (!global_arst.empty()) {
+				if (global_arst[0] == '!') {
+					worker.global_arst_neg = true;
+					global_arst = global_arst.substr(1);
+				}
+				worker.global_arst = RTLIL::escape_id(global_arst);
+			}
+			worker.run_design(design, num_jobs);
+
+			if (!noopt)
+				Pass::call(design, "opt_expr -keepdc");
+
+			log_pop();
+			return;
+		}
+
 		Pass::call(design, "proc_clean");
 		if (!ifxmode)
 			Pass::call(design, "proc_rmdead");
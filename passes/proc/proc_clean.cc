@@ -175,6 +175,33 @@ void proc_clean(RTLIL::Module *mod, RTLIL::Process *proc, int &total_count, bool
 	total_count += count;
 }
 
+PRIVATE_NAMESPACE_END
+YOSYS_NAMESPACE_BEGIN
+
+int proc_clean_module(RTLIL::Module *mod, bool quiet)
+{
+	int total_count = 0;
+	std::vector<RTLIL::Process *> delme;
+	for (auto &proc_it : mod->processes) {
+		if (!mod->design->selected(mod, proc_it.second))
+			continue;
+		proc_clean(mod, proc_it.second, total_count, quiet);
+		if (proc_it.second->syncs.size() == 0 && proc_it.second->root_case.switches.size() == 0 &&
+				proc_it.second->root_case.actions.size() == 0) {
+			if (!quiet)
+				log("Removing empty process `%s.%s'.\n", log_id(mod), proc_it.second->name.c_str());
+			delme.push_back(proc_it.second);
+		}
+	}
+	for (auto proc : delme) {
+		mod->remove(proc);
+	}
+	return total_count;
+}
+
+YOSYS_NAMESPACE_END
+PRIVATE_NAMESPACE_BEGIN
+
 struct ProcCleanPass : public Pass {
 	ProcCleanPass() : Pass("proc_clean", "remove empty parts of processes") { }
 	void help() override
@@ -208,25 +235,9 @@ struct ProcCleanPass : public Pass {
 		}
 		extra_args(args, argidx, design);
 
-		for (auto mod : design->modules()) {
-			std::vector<RTLIL::Process *> delme;
-			if (!design->selected(mod))
-				continue;
-			for (auto &proc_it : mod->processes) {
-				if (!design->selected(mod, proc_it.second))
-					continue;
-				proc_clean(mod, proc_it.second, total_count, quiet);
-				if (proc_it.second->syncs.size() == 0 && proc_it.second->root_case.switches.size() == 0 &&
-						proc_it.second->root_case.actions.size() == 0) {
-					if (!quiet)
-						log("Removing empty process `%s.%s'.\n", log_id(mod), proc_it.second->name.c_str());
-					delme.push_back(proc_it.second);
-				}
-			}
-			for (auto proc : delme) {
-				mod->remove(proc);
-			}
-		}
+		for (auto mod : design->modules())
+			if (design->selected(mod))
+				total_count += proc_clean_module(mod, quiet);
 
 		if (!quiet)
 			log("Cleaned up %d empty switch%s.\n", total_count, total_count == 1 ? "" : "es");
@@ -347,6 +347,29 @@ void proc_dff(RTLIL::Module *mod, RTLIL::Process *proc, ConstEval &ce)
 	}
 }
 
+PRIVATE_NAMESPACE_END
+YOSYS_NAMESPACE_BEGIN
+
+void proc_dff_module(RTLIL::Module *mod)
+{
+	// processes without sync rules can't create registers, don't bother
+	// building the ConstEval index for them
+	bool found = false;
+	for (auto &proc_it : mod->processes)
+		if (mod->design->selected(mod, proc_it.second) && !proc_it.second->syncs.empty())
+			found = true;
+	if (!found)
+		return;
+
+	ConstEval ce(mod);
+	for (auto &proc_it : mod->processes)
+		if (mod->design->selected(mod, proc_it.second))
+			proc_dff(mod, proc_it.second, ce);
+}
+
+YOSYS_NAMESPACE_END
+PRIVATE_NAMESPACE_BEGIN
+
 struct ProcDffPass : public Pass {
 	ProcDffPass() : Pass("proc_dff", "extract flip-flops from processes") { }
 	void help() override
@@ -366,12 +389,8 @@ struct ProcDffPass : public Pass {
 		extra_args(args, 1, design);
 
 		for (auto mod : design->modules())
-			if (design->selected(mod)) {
-				ConstEval ce(mod);
-				for (auto &proc_it : mod->processes)
-					if (design->selected(mod, proc_it.second))
-						proc_dff(mod, proc_it.second, ce);
-			}
+			if (design->selected(mod))
+				proc_dff_module(mod);
 	}
 } ProcDffPass;
 
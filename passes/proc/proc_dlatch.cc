@@ -40,7 +40,7 @@ struct proc_dlatch_db_t
 	dict<SigBit, pair<Cell*, int>> mux_drivers;
 	dict<SigBit, int> sigusers;
 
-	proc_dlatch_db_t(Module *module) : module(module), sigmap(module)
+	proc_dlatch_db_t(Module *module, SigMap &&map) : module(module), sigmap(std::move(map))
 	{
 		initvals.set(&sigmap, module);
 
@@ -446,6 +446,32 @@ void proc_dlatch(proc_dlatch_db_t &db, RTLIL::Process *proc)
 	}
 }
 
+PRIVATE_NAMESPACE_END
+YOSYS_NAMESPACE_BEGIN
+
+void proc_dlatch_module(RTLIL::Module *mod, SigMap &&sigmap)
+{
+	// only processes with an "always" sync rule can infer latches
+	bool found = false;
+	for (auto &proc_it : mod->processes)
+		if (mod->design->selected(mod, proc_it.second))
+			for (auto sr : proc_it.second->syncs)
+				if (sr->type == RTLIL::SyncType::STa)
+					found = true;
+	if (!found)
+		return;
+
+	proc_dlatch_db_t db(mod, std::move(sigmap));
+	for (auto &proc_it : mod->processes)
+		if (mod->design->selected(mod, proc_it.second))
+			proc_dlatch(db, proc_it.second);
+	if (!db.generated_dlatches.empty())
+		db.fixup_muxes();
+}
+
+YOSYS_NAMESPACE_END
+PRIVATE_NAMESPACE_BEGIN
+
 struct ProcDlatchPass : public Pass {
 	ProcDlatchPass() : Pass("proc_dlatch", "extract latches from processes") { }
 	void help() override
@@ -464,13 +490,8 @@ struct ProcDlatchPass : public Pass {
 
 		extra_args(args, 1, design);
 
-		for (auto module : design->selected_modules()) {
-			proc_dlatch_db_t db(module);
-			for (auto &proc_it : module->processes)
-				if (design->selected(module, proc_it.second))
-					proc_dlatch(db, proc_it.second);
-			db.fixup_muxes();
-		}
+		for (auto module : design->selected_modules())
+			proc_dlatch_module(module, SigMap(module));
 	}
 } ProcDlatchPass;
 
@@ -72,6 +72,19 @@ void proc_init(RTLIL::Module *mod, SigMap &sigmap, RTLIL::Process *proc)
 		}
 }
 
+PRIVATE_NAMESPACE_END
+YOSYS_NAMESPACE_BEGIN
+
+void proc_init_module(RTLIL::Module *mod, SigMap &sigmap)
+{
+	for (auto &proc_it : mod->processes)
+		if (mod->design->selected(mod, proc_it.second))
+			proc_init(mod, sigmap, proc_it.second);
+}
+
+YOSYS_NAMESPACE_END
+PRIVATE_NAMESPACE_BEGIN
+
 struct ProcInitPass : public Pass {
 	ProcInitPass() : Pass("proc_init", "convert initial block to init attributes") { }
 	void help() override
@@ -94,9 +107,7 @@ struct ProcInitPass : public Pass {
 		for (auto mod : design->modules())
 			if (design->selected(mod)) {
 				SigMap sigmap(mod);
-				for (auto &proc_it : mod->processes)
-					if (design->selected(mod, proc_it.second))
-						proc_init(mod, sigmap, proc_it.second);
+				proc_init_module(mod, sigmap);
 			}
 	}
 } ProcInitPass;
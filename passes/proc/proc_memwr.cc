@@ -82,6 +82,29 @@ void proc_memwr(RTLIL::Module *mod, RTLIL::Process *proc, dict<IdString, int> &n
 	}
 }
 
+PRIVATE_NAMESPACE_END
+YOSYS_NAMESPACE_BEGIN
+
+void proc_memwr_module(RTLIL::Module *mod)
+{
+	dict<IdString, int> next_port_id;
+	for (auto cell : mod->cells()) {
+		if (cell->type.in(ID($memwr), ID($memwr_v2))) {
+			bool is_compat = cell->type == ID($memwr);
+			IdString memid = cell->parameters.at(ID::MEMID).decode_string();
+			int port_id = cell->parameters.at(is_compat ? ID::PRIORITY : ID::PORTID).as_int();
+			if (port_id >= next_port_id[memid])
+				next_port_id[memid] = port_id + 1;
+		}
+	}
+	for (auto &proc_it : mod->processes)
+		if (mod->design->selected(mod, proc_it.second))
+			proc_memwr(mod, proc_it.second, next_port_id);
+}
+
+YOSYS_NAMESPACE_END
+PRIVATE_NAMESPACE_BEGIN
+
 struct ProcMemWrPass : public Pass {
 	ProcMemWrPass() : Pass("proc_memwr", "extract memory writes from processes") { }
 	void help() override
@@ -99,21 +122,8 @@ struct ProcMemWrPass : public Pass {
 
 		extra_args(args, 1, design);
 
-		for (auto module : design->selected_modules()) {
-			dict<IdString, int> next_port_id;
-			for (auto cell : module->cells()) {
-				if (cell->type.in(ID($memwr), ID($memwr_v2))) {
-					bool is_compat = cell->type == ID($memwr);
-					IdString memid = cell->parameters.at(ID::MEMID).decode_string();
-					int port_id = cell->parameters.at(is_compat ? ID::PRIORITY : ID::PORTID).as_int();
-					if (port_id >= next_port_id[memid])
-						next_port_id[memid] = port_id + 1;
-				}
-			}
-			for (auto &proc_it : module->processes)
-				if (design->selected(module, proc_it.second))
-					proc_memwr(module, proc_it.second, next_port_id);
-		}
+		for (auto module : design->selected_modules())
+			proc_memwr_module(module);
 	}
 } ProcMemWrPass;
 
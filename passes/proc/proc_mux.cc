@@ -436,6 +436,19 @@ void proc_mux(RTLIL::Module *mod, RTLIL::Process *proc, bool ifxmode)
 	}
 }
 
+PRIVATE_NAMESPACE_END
+YOSYS_NAMESPACE_BEGIN
+
+void proc_mux_module(RTLIL::Module *mod, bool ifxmode)
+{
+	for (auto &proc_it : mod->processes)
+		if (mod->design->selected(mod, proc_it.second))
+			proc_mux(mod, proc_it.second, ifxmode);
+}
+
+YOSYS_NAMESPACE_END
+PRIVATE_NAMESPACE_BEGIN
+
 struct ProcMuxPass : public Pass {
 	ProcMuxPass() : Pass("proc_mux", "convert decision trees to multiplexers") { }
 	void help() override
@@ -470,9 +483,7 @@ struct ProcMuxPass : public Pass {
 
 		for (auto mod : design->modules())
 			if (design->selected(mod))
-				for (auto &proc_it : mod->processes)
-					if (design->selected(mod, proc_it.second))
-						proc_mux(mod, proc_it.second, ifxmode);
+				proc_mux_module(mod, ifxmode);
 	}
 } ProcMuxPass;
 
@@ -29,11 +29,11 @@ PRIVATE_NAMESPACE_BEGIN
 struct PruneWorker
 {
 	RTLIL::Module *module;
-	SigMap sigmap;
+	const SigMap &sigmap;
 
 	int removed_count = 0, promoted_count = 0;
 
-	PruneWorker(RTLIL::Module *mod) : module(mod), sigmap(mod) {}
+	PruneWorker(RTLIL::Module *mod, const SigMap &sigmap) : module(mod), sigmap(sigmap) {}
 
 	pool<RTLIL::SigBit> do_switch(RTLIL::SwitchRule *sw, pool<RTLIL::SigBit> assigned, pool<RTLIL::SigBit> &affected)
 	{
@@ -108,6 +108,24 @@ struct PruneWorker
 	}
 };
 
+PRIVATE_NAMESPACE_END
+YOSYS_NAMESPACE_BEGIN
+
+void proc_prune_module(RTLIL::Module *mod, const SigMap &sigmap, int &removed_count, int &promoted_count)
+{
+	PruneWorker worker(mod, sigmap);
+	for (auto &proc_it : mod->processes) {
+		if (!mod->design->selected(mod, proc_it.second))
+			continue;
+		worker.do_process(proc_it.second);
+	}
+	removed_count += worker.removed_count;
+	promoted_count += worker.promoted_count;
+}
+
+YOSYS_NAMESPACE_END
+PRIVATE_NAMESPACE_BEGIN
+
 struct ProcPrunePass : public Pass {
 	ProcPrunePass() : Pass("proc_prune", "remove redundant assignments") { }
 	void help() override
@@ -130,14 +148,8 @@ struct ProcPrunePass : public Pass {
 		for (auto mod : design->modules()) {
 			if (!design->selected(mod))
 				continue;
-			PruneWorker worker(mod);
-			for (auto &proc_it : mod->processes) {
-				if (!design->selected(mod, proc_it.second))
-					continue;
-				worker.do_process(proc_it.second);
-			}
-			total_removed_count += worker.removed_count;
-			total_promoted_count += worker.promoted_count;
+			SigMap sigmap(mod);
+			proc_prune_module(mod, sigmap, total_removed_count, total_promoted_count);
 		}
 
 		log("Removed %d redundant assignment%s.\n",
@@ -129,6 +129,32 @@ void proc_rmdead(RTLIL::SwitchRule *sw, int &counter, int &full_case_counter)
 		proc_rmdead_impl<BitPatternPool>(sw, counter, full_case_counter);
 }
 
+PRIVATE_NAMESPACE_END
+YOSYS_NAMESPACE_BEGIN
+
+int proc_rmdead_module(RTLIL::Module *mod)
+{
+	int total_counter = 0;
+	for (auto &proc_it : mod->processes) {
+		if (!mod->design->selected(mod, proc_it.second))
+			continue;
+		int counter = 0, full_case_counter = 0;
+		for (auto switch_it : proc_it.second->root_case.switches)
+			proc_rmdead(switch_it, counter, full_case_counter);
+		if (counter > 0)
+			log("Removed %d dead cases from process %s in module %s.\n", counter,
+					log_id(proc_it.first), log_id(mod));
+		if (full_case_counter > 0)
+			log("Marked %d switch rules as full_case in process %s in module %s.\n",
+					full_case_counter, log_id(proc_it.first), log_id(mod));
+		total_counter += counter;
+	}
+	return total_counter;
+}
+
+YOSYS_NAMESPACE_END
+PRIVATE_NAMESPACE_BEGIN
+
 struct ProcRmdeadPass : public Pass {
 	ProcRmdeadPass() : Pass("proc_rmdead", "eliminate dead trees in decision trees") { }
 	void help() override
@@ -147,24 +173,9 @@ struct ProcRmdeadPass : public Pass {
 		extra_args(args, 1, design);
 
 		int total_counter = 0;
-		for (auto mod : design->modules()) {
-			if (!design->selected(mod))
-				continue;
-			for (auto &proc_it : mod->processes) {
-				if (!design->selected(mod, proc_it.second))
-					continue;
-				int counter = 0, full_case_counter = 0;
-				for (auto switch_it : proc_it.second->root_case.switches)
-					proc_rmdead(switch_it, counter, full_case_counter);
-				if (counter > 0)
-					log("Removed %d dead cases from process %s in module %s.\n", counter,
-							log_id(proc_it.first), log_id(mod));
-				if (full_case_counter > 0)
-					log("Marked %d switch rules as full_case in process %s in module %s.\n",
-							full_case_counter, log_id(proc_it.first), log_id(mod));
-				total_counter += counter;
-			}
-		}
+		for (auto mod : design->modules())
+			if (design->selected(mod))
+				total_counter += proc_rmdead_module(mod);
 
 		log("Removed a total of %d dead cases.\n", total_counter);
 	}
@@ -30,11 +30,10 @@ PRIVATE_NAMESPACE_BEGIN
 struct RomWorker
 {
 	RTLIL::Module *module;
-	SigMap sigmap;
 
 	int count = 0;
 
-	RomWorker(RTLIL::Module *mod) : module(mod), sigmap(mod) {}
+	RomWorker(RTLIL::Module *mod) : module(mod) {}
 
 	void do_switch(RTLIL::SwitchRule *sw)
 	{
@@ -219,6 +218,23 @@ struct RomWorker
 	}
 };
 
+PRIVATE_NAMESPACE_END
+YOSYS_NAMESPACE_BEGIN
+
+int proc_rom_module(RTLIL::Module *mod)
+{
+	RomWorker worker(mod);
+	for (auto &proc_it : mod->processes) {
+		if (!mod->design->selected(mod, proc_it.second))
+			continue;
+		worker.do_process(proc_it.second);
+	}
+	return worker.count;
+}
+
+YOSYS_NAMESPACE_END
+PRIVATE_NAMESPACE_BEGIN
+
 struct ProcRomPass : public Pass {
 	ProcRomPass() : Pass("proc_rom", "convert switches to ROMs") { }
 	void help() override
@@ -240,13 +256,7 @@ struct ProcRomPass : public Pass {
 		for (auto mod : design->modules()) {
 			if (!design->selected(mod))
 				continue;
-			RomWorker worker(mod);
-			for (auto &proc_it : mod->processes) {
-				if (!design->selected(mod, proc_it.second))
-					continue;
-				worker.do_process(proc_it.second);
-			}
-			total_count += worker.count;
+			total_count += proc_rom_module(mod);
 		}
 
 		log("Converted %d switch%s.\n",
@@ -87,6 +87,8 @@ static void gen_toml(RTLIL::Design *design, std::string filename, std::vector<st
             toml_file << "name = \"" << RTLIL::id2cstr(wire->name) << "\"\n";
             toml_file << "width = " << wire->width << "\n";
             toml_file << "index = " << cellift_in_idx << "\n";
+            if(wire->has_attribute(ID(dft_tag))) // tag ports added by dft_tag -tag-ports
+                toml_file << "tag = \"" << wire->get_string_attribute(ID(dft_tag)) << "\"\n";
             toml_file << "\n";
             cellift_in_idx += wire->width;
         }
@@ -97,6 +99,8 @@ static void gen_toml(RTLIL::Design *design, std::string filename, std::vector<st
             toml_file << "name = \"" << RTLIL::id2cstr(wire->name) << "\"\n";
             toml_file << "width = " << wire->width << "\n";
             toml_file << "index = " << cellift_out_idx << "\n";
+            if(wire->has_attribute(ID(dft_tag))) // tag ports added by dft_tag -tag-ports
+                toml_file << "tag = \"" << wire->get_string_attribute(ID(dft_tag)) << "\"\n";
             toml_file << "\n";
             cellift_out_idx += wire->width;
         }
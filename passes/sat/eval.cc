@@ -23,6 +23,7 @@
 #include "kernel/register.h"
 #include "kernel/celltypes.h"
 #include "kernel/consteval.h"
+#include "kernel/bitsim.h"
 #include "kernel/sigtools.h"
 #include "kernel/satgen.h"
 #include "kernel/log.h"
@@ -450,6 +451,7 @@ struct EvalPass : public Pass {
 			log_cmd_error("Can't perform EVAL on an empty selection!\n");
 
 		ConstEval ce(module);
+		RTLIL::SigSpec set_signals, set_values;
 
 		for (auto &it : sets) {
 			RTLIL::SigSpec lhs, rhs;
@@ -463,6 +465,8 @@ struct EvalPass : public Pass {
 				log_cmd_error("Set expression with different lhs and rhs sizes: %s (%s, %d bits) vs. %s (%s, %d bits)\n",
 						it.first.c_str(), log_signal(lhs), lhs.size(), it.second.c_str(), log_signal(rhs), rhs.size());
 			ce.set(lhs, rhs.as_const());
+			set_signals.append(lhs);
+			set_values.append(rhs);
 		}
 
 		if (shows.size() == 0) {
@@ -522,23 +526,65 @@ struct EvalPass : public Pass {
 			tab.push_back(tab_line);
 			tab_line.clear();
 
+			// The rows are evaluated 64 at a time with ConstEvalBatch when all
+			// inputs of the cone are set to defined values and no driven signal
+			// is overridden. Rows it can't fully evaluate go through ConstEval.
+			ConstEvalBatch batch(module, signal);
+			bool use_batch = set_values.is_fully_def();
+			pool<RTLIL::SigBit> assigned, inputs;
+			for (auto bit : batch.sim.sigmap(set_signals))
+				assigned.insert(bit);
+			for (auto bit : batch.sim.sigmap(tabsigs))
+				assigned.insert(bit);
+			for (auto bit : batch.inputs) {
+				inputs.insert(bit);
+				if (!assigned.count(bit))
+					use_batch = false;
+			}
+			for (auto bit : assigned)
+				if (bit.wire != nullptr && batch.sim.bit_index.count(bit) && !inputs.count(bit))
+					use_batch = false;
+			if (use_batch)
+				batch.set(set_signals, set_values.as_const());
+
+			std::vector<RTLIL::Const> batch_rows, batch_results;
+			uint64_t batch_defined = 0;
+			int batch_pos = 0;
+
 			RTLIL::Const tabvals(0, tabsigs.size());
 			do
 			{
-				ce.push();
-				ce.set(tabsigs, tabvals);
-				value = signal;
+				if (use_batch && batch_pos == GetSize(batch_rows)) {
+					batch_rows.clear();
+					RTLIL::Const row = tabvals;
+					do {
+						batch_rows.push_back(row);
+						row = RTLIL::const_add(row, RTLIL::Const(1), false, false, row.bits.size());
+					} while (GetSize(batch_rows) < 64 && row.as_bool());
+					batch.set(tabsigs, batch_rows);
+					batch_defined = batch.eval_batch(signal, batch_results);
+					batch_pos = 0;
+				}
 
-				RTLIL::SigSpec this_undef;
-				while (!ce.eval(value, this_undef)) {
-					if (!set_undef) {
-						log("Failed to evaluate signal %s at %s = %s: Missing value for %s.\n", log_signal(signal),
-								log_signal(tabsigs), log_signal(tabvals), log_signal(this_undef));
-						return;
+				if (use_batch && (batch_defined >> batch_pos++ & 1)) {
+					value = batch_results[batch_pos-1];
+				} else {
+					ce.push();
+					ce.set(tabsigs, tabvals);
+					value = signal;
+
+					RTLIL::SigSpec this_undef;
+					while (!ce.eval(value, this_undef)) {
+						if (!set_undef) {
+							log("Failed to evaluate signal %s at %s = %s: Missing value for %s.\n", log_signal(signal),
+									log_signal(tabsigs), log_signal(tabvals), log_signal(this_undef));
+							return;
+						}
+						ce.set(this_undef, RTLIL::Const(RTLIL::State::Sx, this_undef.size()));
+						undef.append(this_undef);
+						this_undef = RTLIL::SigSpec();
 					}
-					ce.set(this_undef, RTLIL::Const(RTLIL::State::Sx, this_undef.size()));
-					undef.append(this_undef);
-					this_undef = RTLIL::SigSpec();
+					ce.pop();
 				}
 
 				int pos = 0;
@@ -555,7 +601,6 @@ struct EvalPass : public Pass {
 
 				tab.push_back(tab_line);
 				tab_line.clear();
-				ce.pop();
 
 				tabvals = RTLIL::const_add(tabvals, RTLIL::Const(1), false, false, tabvals.bits.size());
 			}
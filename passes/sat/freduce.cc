@@ -23,6 +23,7 @@
 #include "kernel/sigtools.h"
 #include "kernel/log.h"
 #include "kernel/satgen.h"
+#include "kernel/bitsim.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -33,8 +34,9 @@ USING_YOSYS_NAMESPACE
 PRIVATE_NAMESPACE_BEGIN
 
 bool inv_mode;
-int verbose_level, reduce_counter, reduce_stop_at;
+int verbose_level, reduce_counter, reduce_stop_at, sim_rounds, sim_splits;
 typedef std::map<RTLIL::SigBit, std::pair<RTLIL::Cell*, std::set<RTLIL::SigBit>>> drivers_t;
+typedef dict<RTLIL::SigBit, std::vector<BitSim::lane_t>> sim_sigs_t;
 std::string dump_prefix;
 
 struct equiv_bit_t
@@ -230,6 +232,7 @@ struct PerformReduction
 	SigMap &sigmap;
 	drivers_t &drivers;
 	std::set<std::pair<RTLIL::SigBit, RTLIL::SigBit>> &inv_pairs;
+	const sim_sigs_t &sim_sigs;
 	pool<SigBit> recursion_guard;
 
 	ezSatPtr ez;
@@ -279,8 +282,8 @@ struct PerformReduction
 		return sigdepth.at(out);
 	}
 
-	PerformReduction(SigMap &sigmap, drivers_t &drivers, std::set<std::pair<RTLIL::SigBit, RTLIL::SigBit>> &inv_pairs, std::vector<RTLIL::SigBit> &bits, int cone_size) :
-			sigmap(sigmap), drivers(drivers), inv_pairs(inv_pairs), satgen(ez.get(), &sigmap), out_bits(bits), cone_size(cone_size)
+	PerformReduction(SigMap &sigmap, drivers_t &drivers, std::set<std::pair<RTLIL::SigBit, RTLIL::SigBit>> &inv_pairs, const sim_sigs_t &sim_sigs, std::vector<RTLIL::SigBit> &bits, int cone_size) :
+			sigmap(sigmap), drivers(drivers), inv_pairs(inv_pairs), sim_sigs(sim_sigs), satgen(ez.get(), &sigmap), out_bits(bits), cone_size(cone_size)
 	{
 		satgen.model_undef = true;
 
@@ -488,6 +491,52 @@ struct PerformReduction
 		}
 	}
 
+	// Each simulation pattern that has defined values of both polarities in a
+	// bucket is a model that would otherwise be found by a SAT call. Lanes with
+	// undefined values in a bucket are not used for that bucket, so the
+	// resulting buckets are disjoint.
+	std::vector<std::vector<int>> sim_shatter(const std::vector<int> &bucket)
+	{
+		std::vector<std::vector<int>> buckets = {bucket}, next_buckets;
+
+		for (int word = 0; word < sim_rounds; word++)
+		for (int lane = 0; lane < 64; lane++)
+		{
+			next_buckets.clear();
+			for (auto &b : buckets)
+			{
+				std::vector<int> buckets_a, buckets_b;
+				bool found_undef = false;
+
+				for (int idx : b) {
+					const BitSim::lane_t &l = sim_sigs.at(out_bits[idx]).at(word);
+					if ((l.undef >> lane) & 1) {
+						found_undef = true;
+						break;
+					}
+					if ((((l.val >> lane) & 1) != 0) != out_inverted.at(idx))
+						buckets_a.push_back(idx);
+					else
+						buckets_b.push_back(idx);
+				}
+
+				if (found_undef || buckets_a.empty() || buckets_b.empty()) {
+					next_buckets.push_back(b);
+					continue;
+				}
+
+				sim_splits++;
+				if (GetSize(buckets_a) > 1)
+					next_buckets.push_back(buckets_a);
+				if (GetSize(buckets_b) > 1)
+					next_buckets.push_back(buckets_b);
+			}
+			buckets.swap(next_buckets);
+		}
+
+		return buckets;
+	}
+
 	void analyze(std::vector<std::vector<equiv_bit_t>> &results, int perc)
 	{
 		std::vector<int> bucket;
@@ -496,7 +545,14 @@ struct PerformReduction
 
 		std::vector<std::set<int>> results_buf;
 		std::map<int, int> results_map;
-		analyze(results_buf, results_map, bucket, stringf("[%2d%%] %d ", perc, cone_size), "");
+		if (sim_rounds > 0) {
+			std::vector<std::vector<int>> sim_buckets = sim_shatter(bucket);
+			if (verbose_level >= 1)
+				log("    Simulation shattered bucket with %d signals into %d buckets.\n", GetSize(bucket), GetSize(sim_buckets));
+			for (auto &b : sim_buckets)
+				analyze(results_buf, results_map, b, stringf("[%2d%%] %d ", perc, cone_size), "");
+		} else
+			analyze(results_buf, results_map, bucket, stringf("[%2d%%] %d ", perc, cone_size), "");
 
 		for (auto &r : results_buf)
 		{
@@ -666,10 +722,44 @@ struct FreduceWorker
 		}
 		log("  Sorted %d signal bits into %d buckets.\n", bits_count, int(buckets.size()));
 
+		sim_sigs_t sim_sigs;
+		std::vector<std::pair<int, decltype(buckets)::iterator>> bucket_order;
+
+		if (sim_rounds > 0)
+		{
+			BitSim sim(module);
+			for (int round = 0; round < sim_rounds; round++) {
+				sim.randomize();
+				sim.eval();
+				for (auto &bucket : buckets)
+					if (bucket.second.size() > 1)
+						for (auto &bit : bucket.second)
+							sim_sigs[bit].push_back(sim.get(bit));
+			}
+
+			// Work on the buckets in the order of their logic depth.
+			for (auto it = buckets.begin(); it != buckets.end(); it++) {
+				int depth = 0;
+				for (auto &bit : it->second)
+					depth = max(depth, sim.level(bit));
+				bucket_order.push_back({depth, it});
+			}
+			std::stable_sort(bucket_order.begin(), bucket_order.end(), [](const decltype(bucket_order)::value_type &a, const decltype(bucket_order)::value_type &b) {
+				return a.first < b.first;
+			});
+		}
+		else
+		{
+			for (auto it = buckets.begin(); it != buckets.end(); it++)
+				bucket_order.push_back({0, it});
+		}
+
 		int bucket_count = 0;
 		std::vector<std::vector<equiv_bit_t>> equiv;
-		for (auto &bucket : buckets)
+		sim_splits = 0;
+		for (auto &it : bucket_order)
 		{
+			auto &bucket = *it.second;
 			bucket_count++;
 
 			if (bucket.second.size() == 1)
@@ -677,16 +767,19 @@ struct FreduceWorker
 
 			if (bucket.first.size() == 0) {
 				log("  Finding const values for bucket %s%c\n", log_signal(bucket.second), verbose_level ? ':' : '.');
-				PerformReduction worker(sigmap, drivers, inv_pairs, bucket.second, bucket.first.size());
+				PerformReduction worker(sigmap, drivers, inv_pairs, sim_sigs, bucket.second, bucket.first.size());
 				for (size_t idx = 0; idx < bucket.second.size(); idx++)
 					worker.analyze_const(equiv, idx);
 			} else {
 				log("  Trying to shatter bucket %s%c\n", log_signal(bucket.second), verbose_level ? ':' : '.');
-				PerformReduction worker(sigmap, drivers, inv_pairs, bucket.second, bucket.first.size());
+				PerformReduction worker(sigmap, drivers, inv_pairs, sim_sigs, bucket.second, bucket.first.size());
 				worker.analyze(equiv, 100 * bucket_count / (buckets.size() + 1));
 			}
 		}
 
+		if (sim_rounds > 0)
+			log("  Simulation with %d patterns split buckets %d times, avoiding as many SAT calls.\n", 64 * sim_rounds, sim_splits);
+
 		std::map<RTLIL::SigBit, int> bitusage;
 		CountBitUsage bitusage_worker(sigmap, bitusage);
 		module->rewrite_sigspecs(bitusage_worker);
@@ -781,6 +874,11 @@ struct FreducePass : public Pass {
 		log("        stop after <n> reduction operations. this is mostly used for\n");
 		log("        debugging the freduce command itself.\n");
 		log("\n");
+		log("    -sim <N>\n");
+		log("        before calling the SAT solver, shatter the buckets of candidate signals\n");
+		log("        using N*64 random simulation patterns, and work on the buckets in the\n");
+		log("        order of their logic depth. N = 0 disables the simulation. (default = 4)\n");
+		log("\n");
 		log("    -dump <prefix>\n");
 		log("        dump the design to <prefix>_<module>_<num>.il after each reduction\n");
 		log("        operation. this is mostly used for debugging the freduce command.\n");
@@ -798,6 +896,7 @@ struct FreducePass : public Pass {
 		reduce_stop_at = 0;
 		verbose_level = 0;
 		inv_mode = false;
+		sim_rounds = 4;
 		dump_prefix = std::string();
 
 		log_header(design, "Executing FREDUCE pass (perform functional reduction).\n");
@@ -820,6 +919,10 @@ struct FreducePass : public Pass {
 				reduce_stop_at = atoi(args[++argidx].c_str());
 				continue;
 			}
+			if (args[argidx] == "-sim" && argidx+1 < args.size()) {
+				sim_rounds = atoi(args[++argidx].c_str());
+				continue;
+			}
 			if (args[argidx] == "-dump" && argidx+1 < args.size()) {
 				dump_prefix = args[++argidx];
 				continue;
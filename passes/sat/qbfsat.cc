@@ -19,6 +19,8 @@
 
 #include "kernel/yosys.h"
 #include "kernel/consteval.h"
+#include "kernel/sigtools.h"
+#include "kernel/satgen.h"
 #include "qbfsat.h"
 
 USING_YOSYS_NAMESPACE
@@ -379,6 +381,200 @@ QbfSolutionType qbf_solve(RTLIL::Module *mod, const QbfSolveOptions &opt) {
 	return ret;
 }
 
+struct QbfWindow {
+	pool<RTLIL::IdString> sinks, holes;
+};
+
+// Split the problem into windows of asserts (or, with -assume-outputs, 1-bit
+// outputs) that do not share any hole in their input cones. The holes of
+// different windows can be chosen independently of each other.
+std::vector<QbfWindow> find_qbf_windows(RTLIL::Module *module, const QbfSolveOptions &opt) {
+	SigMap sigmap(module);
+	dict<RTLIL::SigBit, RTLIL::Cell*> drivers;
+	std::vector<std::pair<RTLIL::IdString, RTLIL::SigSpec>> sinks;
+
+	for (auto cell : module->cells()) {
+		for (auto &conn : cell->connections())
+			if (cell->output(conn.first))
+				for (auto bit : sigmap(conn.second))
+					drivers[bit] = cell;
+		if (cell->type == ID($assert))
+			sinks.emplace_back(cell->name, RTLIL::SigSpec({cell->getPort(ID::A), cell->getPort(ID::EN)}));
+	}
+	if (opt.assume_outputs)
+		for (auto wire : module->wires())
+			if (wire->port_output && wire->width == 1)
+				sinks.emplace_back(wire->name, RTLIL::SigSpec(wire));
+
+	mfp<int> partition;
+	dict<RTLIL::Cell*, int> hole_sink;
+	std::vector<pool<RTLIL::Cell*>> sink_holes(GetSize(sinks));
+
+	for (int i = 0; i < GetSize(sinks); i++) {
+		partition(i);
+		pool<RTLIL::Cell*> visited;
+		std::vector<RTLIL::SigBit> queue = sigmap(sinks[i].second).to_sigbit_vector();
+		while (!queue.empty()) {
+			auto it = drivers.find(queue.back());
+			queue.pop_back();
+			if (it == drivers.end() || visited.count(it->second))
+				continue;
+			RTLIL::Cell *cell = it->second;
+			visited.insert(cell);
+			if (cell->type == ID($anyconst)) {
+				sink_holes[i].insert(cell);
+				if (hole_sink.count(cell))
+					partition.merge(i, hole_sink.at(cell));
+				else
+					hole_sink[cell] = i;
+				continue;
+			}
+			for (auto &conn : cell->connections())
+				if (!cell->output(conn.first))
+					for (auto bit : sigmap(conn.second))
+						queue.push_back(bit);
+		}
+	}
+
+	dict<int, int> window_index;
+	std::vector<QbfWindow> windows;
+	for (int i = 0; i < GetSize(sinks); i++) {
+		int root = partition.lookup(i);
+		if (!window_index.count(root)) {
+			window_index[root] = GetSize(windows);
+			windows.emplace_back();
+		}
+		auto &window = windows[window_index.at(root)];
+		window.sinks.insert(sinks[i].first);
+		for (auto cell : sink_holes[i])
+			window.holes.insert(cell->name);
+	}
+	return windows;
+}
+
+// Reduce the module to a single window: remove the asserts (and outputs) of
+// the other windows, and tie the holes of the other windows to zero, which
+// only changes the cost by a constant.
+void restrict_to_window(RTLIL::Module *module, const QbfWindow &window) {
+	for (auto cell : module->cells().to_vector()) {
+		if (cell->type == ID($assert) && !window.sinks.count(cell->name))
+			module->remove(cell);
+		else if (cell->type == ID($anyconst) && !window.holes.count(cell->name)) {
+			RTLIL::SigSpec y = cell->getPort(ID::Y);
+			module->remove(cell);
+			module->connect(y, RTLIL::Const(0, GetSize(y)));
+		}
+	}
+	for (auto wire : module->wires())
+		if (wire->port_output && wire->width == 1 && !window.sinks.count(wire->name))
+			wire->port_output = false;
+	module->fixup_ports();
+	Pass::call_on_module(module->design, module, "opt_clean");
+}
+
+// Check a window without holes with a plain SAT proof: its asserts (and
+// outputs) must hold for all inputs. Cells that cannot be imported (including
+// $allconst) drive free variables, so the check never passes spuriously.
+bool check_window_without_holes(RTLIL::Module *module, const QbfWindow &window, const QbfSolveOptions &opt) {
+	SigMap sigmap(module);
+	ezSatPtr ez;
+	SatGen satgen(ez.get(), &sigmap);
+	std::vector<int> goals;
+
+	for (auto cell : module->cells()) {
+		if (cell->type == ID($assert)) {
+			if (!window.sinks.count(cell->name))
+				continue;
+			int a = satgen.importSigSpec(cell->getPort(ID::A)).at(0);
+			int en = satgen.importSigSpec(cell->getPort(ID::EN)).at(0);
+			goals.push_back(ez->OR(ez->NOT(en), a));
+		} else if (cell->type != ID($assume))
+			satgen.importCell(cell);
+	}
+	for (auto wire : module->wires())
+		if (wire->port_output && wire->width == 1 && window.sinks.count(wire->name)) {
+			int bit = satgen.importSigSpec(wire).at(0);
+			goals.push_back(opt.assume_neg ? ez->NOT(bit) : bit);
+		}
+
+	return !ez->solve(ez->NOT(ez->expression(ezSAT::OpAnd, goals)));
+}
+
+QbfSolutionType qbf_solve_windows(RTLIL::Module *mod, const QbfSolveOptions &opt) {
+	RTLIL::Design *design = mod->design;
+	std::string module_name = mod->name.str();
+	std::vector<QbfWindow> windows, all_windows = find_qbf_windows(mod, opt);
+
+	for (auto &window : all_windows)
+		if (!window.holes.empty())
+			windows.push_back(window);
+	if (windows.empty())
+		log_cmd_error("Did not find any existentially-quantified variables in the cone of an assert. Use 'sat' instead.\n");
+
+	int failed_windows = 0;
+	for (auto &window : all_windows)
+		if (window.holes.empty() && !check_window_without_holes(mod, window, opt))
+			failed_windows++;
+	if (GetSize(windows) < GetSize(all_windows))
+		log("Checked %d window(s) without holes with a SAT proof, %d failed.\n", GetSize(all_windows) - GetSize(windows), failed_windows);
+
+	int num_workers = std::min(opt.jobs, GetSize(windows));
+	log("Solving %d independent window(s) with %d worker process(es).\n", GetSize(windows), num_workers);
+
+	// Each result is a status line ("sat", "unsat" or "unknown") followed by
+	// one "<value> <location>" line per hole.
+	std::vector<std::string> results = run_worker_processes(num_workers, [&](int w) {
+		std::string result;
+		for (int i = w; i < GetSize(windows); i += num_workers) {
+			Pass::call(design, "design -push-copy");
+			RTLIL::Module *module = design->module(module_name);
+			restrict_to_window(module, windows[i]);
+			QbfSolutionType ret = qbf_solve(module, opt);
+			Pass::call(design, "design -pop");
+
+			result += ret.unknown ? "unknown\n" : ret.sat ? "sat\n" : "unsat\n";
+			for (auto &it : ret.hole_to_value) {
+				std::vector<std::string> locs(it.first.begin(), it.first.end());
+				std::sort(locs.begin(), locs.end());
+				std::string loc = locs.front();
+				for (int j = 1; j < GetSize(locs); j++)
+					loc += "|" + locs[j];
+				result += it.second + " " + loc + "\n";
+			}
+		}
+		return result;
+	});
+
+	QbfSolutionType ret;
+	ret.sat = true;
+	ret.unknown = false;
+	for (auto &result : results) {
+		for (auto &line : split_tokens(result, "\n")) {
+			if (line == "sat")
+				continue;
+			if (line == "unsat") {
+				ret.sat = false;
+				continue;
+			}
+			if (line == "unknown") {
+				ret.unknown = true;
+				continue;
+			}
+			size_t pos = line.find(' ');
+			if (pos == std::string::npos)
+				log_error("Unexpected result from worker process: %s\n", line.c_str());
+			auto locs = split_tokens(line.substr(pos + 1), "|");
+			ret.hole_to_value[pool<std::string>(locs.begin(), locs.end())] = line.substr(0, pos);
+		}
+	}
+	if (failed_windows > 0)
+		ret.sat = false;
+	// A single unsatisfiable window makes the whole problem unsatisfiable
+	if (!ret.sat)
+		ret.unknown = false;
+	return ret;
+}
+
 QbfSolveOptions parse_args(const std::vector<std::string> &args) {
 	QbfSolveOptions opt;
 	for (opt.argidx = 1; opt.argidx < args.size(); opt.argidx++) {
@@ -406,6 +602,18 @@ QbfSolveOptions parse_args(const std::vector<std::string> &args) {
 			opt.nobisection = true;
 			continue;
 		}
+		else if (args[opt.argidx] == "-windows") {
+			opt.windows = true;
+			continue;
+		}
+		else if (args[opt.argidx] == "-j") {
+			if (args.size() <= opt.argidx + 1)
+				log_cmd_error("number of jobs not specified.\n");
+			opt.jobs = atoi(args[++opt.argidx].c_str());
+			if (opt.jobs <= 0)
+				opt.jobs = get_num_cpus();
+			continue;
+		}
 		else if (args[opt.argidx] == "-solver") {
 			if (args.size() <= opt.argidx + 1)
 				log_cmd_error("solver not specified.\n");
@@ -543,6 +751,20 @@ struct QbfSatPass : public Pass {
 		log("        \"(minimize)\" or \"(maximize)\" command in the SMT-LIBv2 output and\n");
 		log("        hope that the solver supports optimizing quantified bitvector problems.\n");
 		log("\n");
+		log("    -windows\n");
+		log("        Split the problem into windows of $assert cells (and, with\n");
+		log("        -assume-outputs, single-bit outputs) whose input cones do not share\n");
+		log("        any \"$anyconst\" cell, e.g. the output cones of a model created with\n");
+		log("        `glift -create-instrumented-model`, and solve a separate QBF-SAT\n");
+		log("        problem for each window. The other windows' holes are tied to zero and\n");
+		log("        their asserts are removed. The solutions are merged, and the problem is\n");
+		log("        satisfiable if every window is. Windows without holes are checked\n");
+		log("        with a plain SAT proof instead.\n");
+		log("\n");
+		log("    -j <N>\n");
+		log("        With -windows, solve up to N windows in parallel worker processes.\n");
+		log("        Use 0 for the number of CPUs. (default: 1)\n");
+		log("\n");
 		log("    -solver <solver>\n");
 		log("        Use a particular solver. Choose one of: \"z3\", \"yices\", \"cvc4\"\n");
 		log("        and \"cvc5\". (default: yices)\n");
@@ -602,7 +824,7 @@ struct QbfSatPass : public Pass {
 			//Save the design to restore after modiyfing the current module.
 			std::string module_name = module->name.str();
 
-			QbfSolutionType ret = qbf_solve(module, opt);
+			QbfSolutionType ret = opt.windows ? qbf_solve_windows(module, opt) : qbf_solve(module, opt);
 			module = design->module(module_name);
 			if (ret.unknown) {
 				if (opt.sat || opt.unsat)
@@ -28,11 +28,11 @@ YOSYS_NAMESPACE_BEGIN
 struct QbfSolveOptions {
 	bool specialize = false, specialize_from_file = false, write_solution = false, nocleanup = false;
 	bool dump_final_smt2 = false, assume_outputs = false, assume_neg = false, nooptimize = false;
-	bool nobisection = false, sat = false, unsat = false, show_smtbmc = false;
+	bool nobisection = false, sat = false, unsat = false, show_smtbmc = false, windows = false;
 	enum Solver{Z3, Yices, CVC4, CVC5} solver = Yices;
 	enum OptimizationLevel{O0, O1, O2} oflag = O0;
 	dict<std::string, std::string> solver_options;
-	int timeout = 0;
+	int timeout = 0, jobs = 1;
 	std::string specialize_soln_file = "";
 	std::string write_soln_soln_file = "";
 	std::string dump_final_smt2_file = "";
@@ -1043,6 +1043,12 @@ struct SatPass : public Pass {
 		log("    -prove-skip <N>\n");
 		log("        Do not enforce the prove-condition for the first <N> time steps.\n");
 		log("\n");
+		log("    -incremental\n");
+		log("        Check the prove-condition after each time step of a -seq proof, reusing the\n");
+		log("        solver instance (and everything it learned) for the deeper time steps.\n");
+		log("        Proven time steps are kept as lemmas and the proof stops at the first\n");
+		log("        failing time step, yielding the shortest counter example.\n");
+		log("\n");
 		log("    -maxsteps <N>\n");
 		log("        Set a maximum length for the induction.\n");
 		log("\n");
@@ -1086,6 +1092,7 @@ struct SatPass : public Pass {
 		bool ignore_unknown_cells = false, falsify = false, tempinduct_def = false, set_init_def = false;
 		bool tempinduct_baseonly = false, tempinduct_inductonly = false, set_assumes = false;
 		int tempinduct_skip = 0, stepsize = 1;
+		bool incremental = false;
 		std::string vcd_file_name, json_file_name, cnf_file_name;
 
 		log_header(design, "Executing SAT pass (solving SAT problems in the circuit).\n");
@@ -1227,6 +1234,10 @@ struct SatPass : public Pass {
 				prove_skip = atoi(args[++argidx].c_str());
 				continue;
 			}
+			if (args[argidx] == "-incremental") {
+				incremental = true;
+				continue;
+			}
 			if (args[argidx] == "-seq" && argidx+1 < args.size()) {
 				seq_len = atoi(args[++argidx].c_str());
 				continue;
@@ -1344,6 +1355,9 @@ struct SatPass : public Pass {
 		if (prove_skip && tempinduct)
 			log_cmd_error("Options -prove-skip and -tempinduct don't work with each other. Use -seq instead of -prove-skip.\n");
 
+		if (incremental && (tempinduct || seq_len == 0 || loopcount != 0 || max_undef))
+			log_cmd_error("Option -incremental requires -seq <N> and does not work with -tempinduct, -max, -all, or -max_undef.\n");
+
 		if (prove_skip >= seq_len && prove_skip > 0)
 			log_cmd_error("The value of -prove-skip must be smaller than the one of -seq.\n");
 
@@ -1616,13 +1630,31 @@ struct SatPass : public Pass {
 					sathelper.ez->assume(sathelper.ez->NOT(sathelper.setup_proof()));
 			} else {
 				std::vector<int> prove_bits;
-				for (int timestep = 1; timestep <= seq_len; timestep++) {
+				bool incremental_failed = false;
+				for (int timestep = 1; timestep <= seq_len && !incremental_failed; timestep++) {
 					sathelper.setup(timestep, timestep == 1);
 					if (sathelper.prove.size() || sathelper.prove_x.size() || sathelper.prove_asserts)
-						if (timestep > prove_skip)
+						if (timestep > prove_skip) {
 							prove_bits.push_back(sathelper.setup_proof(timestep));
+							if (incremental && timestep < seq_len) {
+								sathelper.generate_model();
+								log("\nSolving time step %d with %d variables and %d clauses..\n",
+										timestep, sathelper.ez->numCnfVariables(), sathelper.ez->numCnfClauses());
+								log_flush();
+								if (sathelper.solve(sathelper.ez->NOT(prove_bits.back()))) {
+									incremental_failed = true;
+									continue;
+								}
+								if (sathelper.gotTimeout)
+									goto timeout;
+								// The property holds in this time step: keep it as a lemma for the deeper ones.
+								sathelper.ez->assume(prove_bits.back());
+							}
+						}
 				}
-				if (sathelper.prove.size() || sathelper.prove_x.size() || sathelper.prove_asserts)
+				if (incremental_failed)
+					sathelper.ez->assume(sathelper.ez->NOT(prove_bits.back()));
+				else if (sathelper.prove.size() || sathelper.prove_x.size() || sathelper.prove_asserts)
 					sathelper.ez->assume(sathelper.ez->NOT(sathelper.ez->expression(ezSAT::OpAnd, prove_bits)));
 			}
 			sathelper.generate_model();
@@ -0,0 +1,479 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2026  The Yosys contributors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *
+ */
+
+#include "kernel/register.h"
+#include "kernel/celltypes.h"
+#include "kernel/sigtools.h"
+#include "kernel/log.h"
+#include "kernel/satgen.h"
+#include "kernel/ff.h"
+#include "kernel/yw.h"
+#include "kernel/json.h"
+
+USING_YOSYS_NAMESPACE
+PRIVATE_NAMESPACE_BEGIN
+
+struct TaintReachWorker
+{
+	RTLIL::Module *module;
+	SigMap sigmap;
+
+	ezSatPtr ez;
+	SatGen satgen;
+
+	// Command line arguments.
+	bool opt_verbose = false;
+	bool opt_set_init_zero = false;
+	int opt_seq = 1;
+	int opt_timeout = 0;
+
+	pool<RTLIL::SigBit> source_inputs;	// Tainted at every time step.
+	pool<RTLIL::SigBit> source_states;	// Tainted in the initial state only.
+	pool<RTLIL::SigBit> undriven_bits;
+	RTLIL::SigSpec sinks;
+
+	std::vector<RTLIL::Wire*> input_wires;
+	std::vector<RTLIL::Wire*> state_wires;
+	dict<RTLIL::SigBit, bool> clock_bits;	// Input clock bit -> is posedge.
+
+	// Witness of the last successful query.
+	int witness_step = -1;
+	std::vector<RTLIL::Const> witness_inputs;	// One concatenation of all input wires per step.
+	RTLIL::Const witness_init;
+
+	TaintReachWorker(RTLIL::Module *module) : module(module), sigmap(module), satgen(ez.get(), &sigmap)
+	{
+	}
+
+	void setup_sources_and_sinks(const std::vector<std::string> &source_args, const std::vector<std::string> &sink_args)
+	{
+		SigPool driven_bits, ff_bits;
+		for (auto cell : module->cells()) {
+			bool is_ff = RTLIL::builtin_ff_cell_types().count(cell->type) || cell->type == ID($anyinit);
+			for (auto &conn : cell->connections())
+				if (cell->output(conn.first)) {
+					driven_bits.add(sigmap(conn.second));
+					if (is_ff)
+						ff_bits.add(sigmap(conn.second));
+				}
+			if (is_ff) {
+				FfData ff(nullptr, cell);
+				if (ff.has_clk)
+					for (auto bit : sigmap(ff.sig_clk))
+						if (bit.wire != nullptr && bit.wire->port_input)
+							clock_bits[bit] = ff.pol_clk;
+			}
+		}
+
+		for (auto wire : module->wires()) {
+			for (auto bit : sigmap(wire))
+				if (bit.wire != nullptr && !driven_bits.check(bit))
+					undriven_bits.insert(bit);
+			if (wire->port_input)
+				input_wires.push_back(wire);
+			else if (ff_bits.check_any(sigmap(wire)) && wire->name.isPublic())
+				state_wires.push_back(wire);
+		}
+
+		for (auto &arg : source_args) {
+			RTLIL::SigSpec sig;
+			if (!RTLIL::SigSpec::parse_sel(sig, module->design, module, arg))
+				log_cmd_error("Failed to parse taint source `%s'.\n", arg.c_str());
+			for (auto bit : sigmap(sig)) {
+				if (bit.wire == nullptr)
+					continue;
+				if (ff_bits.check(bit))
+					source_states.insert(bit);
+				else if (!driven_bits.check(bit))
+					source_inputs.insert(bit);
+				else
+					log_cmd_error("Taint source bit %s is driven by a combinational cell. Only inputs and register outputs can be taint sources.\n", log_signal(bit));
+			}
+		}
+
+		for (auto &arg : sink_args) {
+			RTLIL::SigSpec sig;
+			if (!RTLIL::SigSpec::parse_sel(sig, module->design, module, arg))
+				log_cmd_error("Failed to parse taint sink `%s'.\n", arg.c_str());
+			sinks.append(sig);
+		}
+		sinks = sigmap(sinks);
+
+		log("Taint sources: %d input bits, %d register bits.\n", GetSize(source_inputs), GetSize(source_states));
+		log("Taint sinks: %s\n", log_signal(sinks));
+	}
+
+	void setup_step(int timestep)
+	{
+		if (timestep == 1)
+			satgen.setInitState(timestep);
+
+		for (auto cell : module->cells()) {
+			if (!satgen.importCell(cell, timestep))
+				log_error("Failed to import cell %s (type %s) to SAT database.\n", log_id(cell), log_id(cell->type));
+			if (!satgen.importCellTaint(cell, timestep))
+				log_error("Failed to import taint model of cell %s (type %s) to SAT database.\n", log_id(cell), log_id(cell->type));
+		}
+
+		// Taint of the undriven bits is decided by the source set.
+		for (auto bit : undriven_bits) {
+			int taint = satgen.importTaintSigBit(bit, timestep);
+			ez->SET(source_inputs.count(bit) ? ez->CONST_TRUE : ez->CONST_FALSE, taint);
+		}
+
+		if (timestep == 1)
+		{
+			pool<RTLIL::SigBit> initial_state = satgen.initial_state.export_all().to_sigbit_pool();
+			for (auto bit : initial_state) {
+				int taint = satgen.importTaintSigBit(bit, timestep);
+				ez->SET(source_states.count(bit) ? ez->CONST_TRUE : ez->CONST_FALSE, taint);
+			}
+
+			RTLIL::SigSpec init_lhs, init_rhs;
+			for (auto wire : module->wires()) {
+				if (!wire->attributes.count(ID::init))
+					continue;
+				RTLIL::SigSpec lhs = sigmap(wire);
+				RTLIL::Const rhs = wire->attributes.at(ID::init);
+				for (int i = 0; i < GetSize(lhs) && i < GetSize(rhs); i++)
+					if ((rhs[i] == State::S0 || rhs[i] == State::S1) && initial_state.count(lhs[i])) {
+						init_lhs.append(lhs[i]);
+						init_rhs.append(rhs[i]);
+					}
+			}
+			if (opt_set_init_zero) {
+				pool<RTLIL::SigBit> init_bits = init_lhs.to_sigbit_pool();
+				for (auto bit : initial_state)
+					if (!init_bits.count(bit)) {
+						init_lhs.append(bit);
+						init_rhs.append(State::S0);
+					}
+			}
+			if (GetSize(init_lhs))
+				ez->assume(satgen.signals_eq(init_lhs, init_rhs, timestep));
+		}
+	}
+
+	std::vector<int> import_witness_inputs(int timestep)
+	{
+		std::vector<int> vec;
+		for (auto wire : input_wires) {
+			std::vector<int> bits = satgen.importSigSpec(wire, timestep);
+			vec.insert(vec.end(), bits.begin(), bits.end());
+		}
+		return vec;
+	}
+
+	std::vector<int> import_witness_init()
+	{
+		std::vector<int> vec;
+		for (auto wire : state_wires) {
+			std::vector<int> bits = satgen.importSigSpec(wire, 1);
+			vec.insert(vec.end(), bits.begin(), bits.end());
+		}
+		return vec;
+	}
+
+	bool run()
+	{
+		if (opt_timeout != 0)
+			ez->setSolverTimeout(opt_timeout);
+
+		for (int timestep = 1; timestep <= opt_seq; timestep++)
+		{
+			log("\nSetting up time step %d:\n", timestep);
+			setup_step(timestep);
+
+			// The query for this step is only active under its assumption literal, such
+			// that the solver keeps the clauses and learnt information of previous steps.
+			int sink_reached = ez->expression(ezSAT::OpOr, satgen.importTaintSigSpec(sinks, timestep));
+
+			std::vector<int> model_expressions;
+			std::vector<std::vector<int>> input_exprs;
+			for (int t = 1; t <= timestep; t++) {
+				input_exprs.push_back(import_witness_inputs(t));
+				model_expressions.insert(model_expressions.end(), input_exprs.back().begin(), input_exprs.back().end());
+			}
+			std::vector<int> init_exprs = import_witness_init();
+			model_expressions.insert(model_expressions.end(), init_exprs.begin(), init_exprs.end());
+
+			log("Solving for a taint flow to the sinks in time step %d (%d variables, %d clauses).\n",
+					timestep, ez->numCnfVariables(), ez->numCnfClauses());
+
+			std::vector<bool> model_values;
+			bool found = ez->solve(model_expressions, model_values, sink_reached);
+
+			if (ez->getSolverTimoutStatus())
+				log_error("SAT solver timed out in time step %d.\n", timestep);
+
+			if (!found) {
+				if (opt_verbose)
+					log("No taint flow to the sinks in time step %d.\n", timestep);
+				continue;
+			}
+
+			witness_step = timestep;
+			witness_inputs.clear();
+			int offset = 0;
+			for (auto &exprs : input_exprs) {
+				RTLIL::Const value;
+				for (size_t i = 0; i < exprs.size(); i++)
+					value.bits.push_back(model_values.at(offset++) ? State::S1 : State::S0);
+				witness_inputs.push_back(value);
+			}
+			witness_init = RTLIL::Const();
+			for (size_t i = 0; i < init_exprs.size(); i++)
+				witness_init.bits.push_back(model_values.at(offset++) ? State::S1 : State::S0);
+			return true;
+		}
+		return false;
+	}
+
+	void print_witness()
+	{
+		log("\nTaint reaches the sinks in time step %d:\n\n", witness_step);
+		log("  %-6s %-40s %s\n", "Time", "Signal", "Value");
+		log("  %-6s %-40s %s\n", "----", "------", "-----");
+
+		int offset = 0;
+		for (auto wire : state_wires) {
+			log("  %-6s %-40s %s\n", "init", log_id(wire), log_signal(witness_init.extract(offset, wire->width)));
+			offset += wire->width;
+		}
+		for (int t = 0; t < GetSize(witness_inputs); t++) {
+			offset = 0;
+			for (auto wire : input_wires) {
+				log("  %-6d %-40s %s\n", t + 1, log_id(wire), log_signal(witness_inputs[t].extract(offset, wire->width)));
+				offset += wire->width;
+			}
+		}
+	}
+
+	void write_yw(const std::string &filename)
+	{
+		std::ofstream f;
+		f.open(filename.c_str(), std::ofstream::trunc);
+		if (f.fail())
+			log_error("Can't open file `%s' for writing: %s\n", filename.c_str(), strerror(errno));
+
+		Json::array clocks, signals;
+		for (auto wire : input_wires)
+			for (int i = 0; i < wire->width; i++) {
+				auto it = clock_bits.find(sigmap(SigBit(wire, i)));
+				if (it == clock_bits.end())
+					continue;
+				clocks.push_back(Json::object {
+					{ "path", witness_path(wire) },
+					{ "offset", i },
+					{ "edge", it->second ? "posedge" : "negedge" },
+				});
+			}
+		for (auto wire : input_wires)
+			signals.push_back(Json::object {
+				{ "path", witness_path(wire) },
+				{ "offset", 0 },
+				{ "width", wire->width },
+				{ "init_only", false },
+			});
+		for (auto wire : state_wires)
+			signals.push_back(Json::object {
+				{ "path", witness_path(wire) },
+				{ "offset", 0 },
+				{ "width", wire->width },
+				{ "init_only", true },
+			});
+
+		// Signal bits are stored from the end of the string, the first signal's LSB being the last character.
+		Json::array steps;
+		for (int t = 0; t < GetSize(witness_inputs); t++) {
+			RTLIL::Const bits = witness_inputs[t];
+			int offset = 0;
+			for (auto wire : input_wires) {
+				for (int i = 0; i < wire->width; i++) {
+					auto it = clock_bits.find(sigmap(SigBit(wire, i)));
+					if (it != clock_bits.end())
+						bits.bits[offset + i] = it->second ? State::S0 : State::S1;
+				}
+				offset += wire->width;
+			}
+			if (t == 0)
+				bits.bits.insert(bits.bits.end(), witness_init.bits.begin(), witness_init.bits.end());
+			else
+				bits.bits.insert(bits.bits.end(), GetSize(witness_init), State::Sa);
+			std::string str;
+			for (int i = GetSize(bits) - 1; i >= 0; i--)
+				str += bits[i] == State::S1 ? '1' : bits[i] == State::S0 ? '0' : '?';
+			steps.push_back(Json::object { { "bits", str } });
+		}
+
+		Json json = Json::object {
+			{ "format", "Yosys Witness Trace" },
+			{ "clocks", clocks },
+			{ "signals", signals },
+			{ "steps", steps },
+		};
+		f << json.dump() << "\n";
+		log("Wrote witness trace to `%s'.\n", filename.c_str());
+	}
+};
+
+struct TaintReachPass : public Pass {
+	TaintReachPass() : Pass("taint_reach", "prove or refute taint flows with bounded model checking") { }
+	void help() override
+	{
+		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
+		log("\n");
+		log("    taint_reach [options] [top-module]\n");
+		log("\n");
+		log("This command checks whether a taint originating from a set of sources can reach a\n");
+		log("set of sinks within a bounded number of clock cycles. The taint-propagation\n");
+		log("constraints (precise CellIFT/GLIFT rules for the logic cells, conservative rules\n");
+		log("for arithmetic cells) are generated directly in the SAT model alongside the\n");
+		log("original cell semantics, so no instrumented copy of the design is created.\n");
+		log("\n");
+		log("The time steps are checked one after another on a single incremental solver\n");
+		log("instance. The design must be flattened and must not contain memories or FFs\n");
+		log("with asynchronous inputs (run memory_map and async2sync or clk2fflogic first).\n");
+		log("\n");
+		log("    -source <signal>\n");
+		log("        Taint source. Input bits are tainted in every time step, register outputs\n");
+		log("        are tainted in the initial state. Can be given multiple times.\n");
+		log("\n");
+		log("    -sink <signal>\n");
+		log("        Taint sink. The check succeeds as soon as any sink bit is tainted. Can be\n");
+		log("        given multiple times.\n");
+		log("\n");
+		log("    -seq <N>\n");
+		log("        Check up to N time steps (default: 1).\n");
+		log("\n");
+		log("    -set-init-zero\n");
+		log("        Set all registers without init attribute to zero in the initial state.\n");
+		log("        By default their initial value is unconstrained.\n");
+		log("\n");
+		log("    -timeout <N>\n");
+		log("        Maximum number of seconds a single SAT instance may take.\n");
+		log("\n");
+		log("    -dump_yw <yw-filename>\n");
+		log("        Write the witness trace to a Yosys witness file. Use 'sim -r <yw-filename>\n");
+		log("        -fst <fst-filename>' to convert it to a waveform.\n");
+		log("\n");
+		log("    -verify\n");
+		log("        Return an error if the taint can reach the sinks.\n");
+		log("\n");
+		log("    -falsify\n");
+		log("        Return an error if the taint cannot reach the sinks.\n");
+		log("\n");
+		log("    -verbose\n");
+		log("        Verbose mode.\n");
+		log("\n");
+	}
+	void execute(std::vector<std::string> args, RTLIL::Design *design) override
+	{
+		std::vector<std::string> source_args, sink_args;
+		std::string dump_yw;
+		bool opt_verify = false, opt_falsify = false;
+		bool opt_verbose = false, opt_set_init_zero = false;
+		int opt_seq = 1, opt_timeout = 0;
+
+		log_header(design, "Executing TAINT_REACH pass.\n");
+
+		size_t argidx;
+		for (argidx = 1; argidx < args.size(); argidx++) {
+			if (args[argidx] == "-source" && argidx+1 < args.size()) {
+				source_args.push_back(args[++argidx]);
+				continue;
+			}
+			if (args[argidx] == "-sink" && argidx+1 < args.size()) {
+				sink_args.push_back(args[++argidx]);
+				continue;
+			}
+			if (args[argidx] == "-seq" && argidx+1 < args.size()) {
+				opt_seq = atoi(args[++argidx].c_str());
+				continue;
+			}
+			if (args[argidx] == "-timeout" && argidx+1 < args.size()) {
+				opt_timeout = atoi(args[++argidx].c_str());
+				continue;
+			}
+			if (args[argidx] == "-dump_yw" && argidx+1 < args.size()) {
+				dump_yw = args[++argidx];
+				continue;
+			}
+			if (args[argidx] == "-set-init-zero") {
+				opt_set_init_zero = true;
+				continue;
+			}
+			if (args[argidx] == "-verify") {
+				opt_verify = true;
+				continue;
+			}
+			if (args[argidx] == "-falsify") {
+				opt_falsify = true;
+				continue;
+			}
+			if (args[argidx] == "-verbose") {
+				opt_verbose = true;
+				continue;
+			}
+			break;
+		}
+
+		RTLIL::Module *module = nullptr;
+		for (auto mod : design->selected_modules()) {
+			if (argidx < args.size() && mod->name != RTLIL::escape_id(args[argidx]))
+				continue;
+			if (module)
+				log_cmd_error("Only one module must be selected for the taint_reach pass! (selected: %s and %s)\n", log_id(module), log_id(mod));
+			module = mod;
+		}
+		if (argidx+1 < args.size())
+			extra_args(args, argidx+1, design);
+		if (module == nullptr)
+			log_cmd_error("Can't perform taint_reach on an empty selection!\n");
+
+		if (source_args.empty() || sink_args.empty())
+			log_cmd_error("At least one -source and one -sink must be given.\n");
+		if (opt_seq < 1)
+			log_cmd_error("The number of time steps must be at least 1.\n");
+		if (!module->processes.empty())
+			log_cmd_error("Found processes in module %s. Run 'proc' first.\n", log_id(module));
+
+		TaintReachWorker worker(module);
+		worker.opt_verbose = opt_verbose;
+		worker.opt_set_init_zero = opt_set_init_zero;
+		worker.opt_seq = opt_seq;
+		worker.opt_timeout = opt_timeout;
+
+		worker.setup_sources_and_sinks(source_args, sink_args);
+
+		if (worker.run()) {
+			worker.print_witness();
+			if (!dump_yw.empty())
+				worker.write_yw(dump_yw);
+			if (opt_verify)
+				log_error("Taint can reach the sinks in time step %d!\n", worker.witness_step);
+		} else {
+			log("\nTaint cannot reach the sinks within %d time steps.\n", opt_seq);
+			if (opt_falsify)
+				log_error("Taint cannot reach the sinks within %d time steps!\n", opt_seq);
+		}
+	}
+} TaintReachPass;
+
+PRIVATE_NAMESPACE_END
@@ -464,6 +464,12 @@ struct DfflibmapPass : public Pass {
 		log("This argument can be called multiple times with different cell names. This\n");
 		log("argument also supports simple glob patterns in the cell name.\n");
 		log("\n");
+		log("A liberty file that was already parsed by read_liberty, dfflibmap or stat is\n");
+		log("not parsed again for the same design unless it has changed. The parsed file\n");
+		log("is freed with the design or by 'design -reset'. When the scratchpad variable\n");
+		log("liberty.cache_dir is set, the parsed file is also stored in that directory\n");
+		log("and loaded from there by later runs (see 'help scratchpad').\n");
+		log("\n");
 	}
 	void execute(std::vector<std::string> args, RTLIL::Design *design) override
 	{
@@ -519,33 +525,30 @@ struct DfflibmapPass : public Pass {
 		if (liberty_file.empty())
 			log_cmd_error("Missing `-liberty liberty_file' option!\n");
 
-		std::ifstream f;
-		f.open(liberty_file.c_str());
-		if (f.fail())
+		std::shared_ptr<LibertyAst> libast = LibertyCache::load(design, liberty_file);
+		if (libast == nullptr)
 			log_cmd_error("Can't open liberty file `%s': %s\n", liberty_file.c_str(), strerror(errno));
-		LibertyParser libparser(f);
-		f.close();
-
-		find_cell(libparser.ast, ID($_DFF_N_), false, false, false, false, dont_use_cells);
-		find_cell(libparser.ast, ID($_DFF_P_), true, false, false, false, dont_use_cells);
-
-		find_cell(libparser.ast, ID($_DFF_NN0_), false, true, false, false, dont_use_cells);
-		find_cell(libparser.ast, ID($_DFF_NN1_), false, true, false, true, dont_use_cells);
-		find_cell(libparser.ast, ID($_DFF_NP0_), false, true, true, false, dont_use_cells);
-		find_cell(libparser.ast, ID($_DFF_NP1_), false, true, true, true, dont_use_cells);
-		find_cell(libparser.ast, ID($_DFF_PN0_), true, true, false, false, dont_use_cells);
-		find_cell(libparser.ast, ID($_DFF_PN1_), true, true, false, true, dont_use_cells);
-		find_cell(libparser.ast, ID($_DFF_PP0_), true, true, true, false, dont_use_cells);
-		find_cell(libparser.ast, ID($_DFF_PP1_), true, true, true, true, dont_use_cells);
-
-		find_cell_sr(libparser.ast, ID($_DFFSR_NNN_), false, false, false, dont_use_cells);
-		find_cell_sr(libparser.ast, ID($_DFFSR_NNP_), false, false, true, dont_use_cells);
-		find_cell_sr(libparser.ast, ID($_DFFSR_NPN_), false, true, false, dont_use_cells);
-		find_cell_sr(libparser.ast, ID($_DFFSR_NPP_), false, true, true, dont_use_cells);
-		find_cell_sr(libparser.ast, ID($_DFFSR_PNN_), true, false, false, dont_use_cells);
-		find_cell_sr(libparser.ast, ID($_DFFSR_PNP_), true, false, true, dont_use_cells);
-		find_cell_sr(libparser.ast, ID($_DFFSR_PPN_), true, true, false, dont_use_cells);
-		find_cell_sr(libparser.ast, ID($_DFFSR_PPP_), true, true, true, dont_use_cells);
+
+		find_cell(libast.get(), ID($_DFF_N_), false, false, false, false, dont_use_cells);
+		find_cell(libast.get(), ID($_DFF_P_), true, false, false, false, dont_use_cells);
+
+		find_cell(libast.get(), ID($_DFF_NN0_), false, true, false, false, dont_use_cells);
+		find_cell(libast.get(), ID($_DFF_NN1_), false, true, false, true, dont_use_cells);
+		find_cell(libast.get(), ID($_DFF_NP0_), false, true, true, false, dont_use_cells);
+		find_cell(libast.get(), ID($_DFF_NP1_), false, true, true, true, dont_use_cells);
+		find_cell(libast.get(), ID($_DFF_PN0_), true, true, false, false, dont_use_cells);
+		find_cell(libast.get(), ID($_DFF_PN1_), true, true, false, true, dont_use_cells);
+		find_cell(libast.get(), ID($_DFF_PP0_), true, true, true, false, dont_use_cells);
+		find_cell(libast.get(), ID($_DFF_PP1_), true, true, true, true, dont_use_cells);
+
+		find_cell_sr(libast.get(), ID($_DFFSR_NNN_), false, false, false, dont_use_cells);
+		find_cell_sr(libast.get(), ID($_DFFSR_NNP_), false, false, true, dont_use_cells);
+		find_cell_sr(libast.get(), ID($_DFFSR_NPN_), false, true, false, dont_use_cells);
+		find_cell_sr(libast.get(), ID($_DFFSR_NPP_), false, true, true, dont_use_cells);
+		find_cell_sr(libast.get(), ID($_DFFSR_PNN_), true, false, false, dont_use_cells);
+		find_cell_sr(libast.get(), ID($_DFFSR_PNP_), true, false, true, dont_use_cells);
+		find_cell_sr(libast.get(), ID($_DFFSR_PPN_), true, true, false, dont_use_cells);
+		find_cell_sr(libast.get(), ID($_DFFSR_PPP_), true, true, true, dont_use_cells);
 
 		log("  final dff cell mappings:\n");
 		logmap_all();
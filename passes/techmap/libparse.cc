@@ -27,7 +27,9 @@
 #include <sstream>
 
 #ifndef FILTERLIB
-#include "kernel/log.h"
+#include "kernel/yosys.h"
+#include "libs/sha1/sha1.h"
+#include <sys/stat.h>
 #endif
 
 using namespace Yosys;
@@ -83,26 +85,42 @@ void LibertyAst::dump(FILE *f, std::string indent, std::string path, bool path_o
 		fprintf(f, " ;\n");
 }
 
+bool LibertyParser::fill_buffer()
+{
+	f.read(buffer.data(), buffer.size());
+	if (f.gcount() <= 0)
+		return false;
+	buffer_pos = buffer.data();
+	buffer_end = buffer_pos + f.gcount();
+	return true;
+}
+
+static inline bool liberty_id_char(int c)
+{
+	return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') || c == '_' || c == '-' || c == '+' || c == '.';
+}
+
 int LibertyParser::lexer(std::string &str)
 {
 	int c;
 
 	// eat whitespace
 	do {
-		c = f.get();
+		c = get();
 	} while (c == ' ' || c == '\t' || c == '\r');
 
 	// search for identifiers, numbers, plus or minus.
-	if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') || c == '_' || c == '-' || c == '+' || c == '.') {
-		str = static_cast<char>(c);
+	if (liberty_id_char(c)) {
+		str.assign(1, static_cast<char>(c));
 		while (1) {
-			c = f.get();
-			if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') || c == '_' || c == '-' || c == '+' || c == '.')
-				str += c;
-			else
+			const char *p = buffer_pos;
+			while (p != buffer_end && liberty_id_char(*p))
+				p++;
+			str.append(buffer_pos, p);
+			buffer_pos = p;
+			if (p != buffer_end || !fill_buffer())
 				break;
 		}
-		f.unget();
 		if (str == "+" || str == "-") {
 			/* Single operator is not an identifier */
 			// fprintf(stderr, "LEX: char >>%s<<\n", str.c_str());
@@ -117,14 +135,22 @@ int LibertyParser::lexer(std::string &str)
 	// if it wasn't an identifer, number of array range,
 	// maybe it's a string?
 	if (c == '"') {
-		str = "";
+		str.clear();
 		while (1) {
-			c = f.get();
-			if (c == '\n')
-				line++;
-			if (c == '"')
+			const char *p = buffer_pos;
+			while (p != buffer_end && *p != '"') {
+				if (*p == '\n')
+					line++;
+				p++;
+			}
+			str.append(buffer_pos, p);
+			buffer_pos = p;
+			if (p != buffer_end) {
+				buffer_pos++;
+				break;
+			}
+			if (!fill_buffer())
 				break;
-			str += c;
 		}
 		// fprintf(stderr, "LEX: string >>%s<<\n", str.c_str());
 		return 'v';
@@ -132,37 +158,37 @@ int LibertyParser::lexer(std::string &str)
 
 	// if it wasn't a string, perhaps it's a comment or a forward slash?
 	if (c == '/') {
-		c = f.get();
+		c = get();
 		if (c == '*') {         // start of '/*' block comment
 			int last_c = 0;
 			while (c > 0 && (last_c != '*' || c != '/')) {
 				last_c = c;
-				c = f.get();
+				c = get();
 				if (c == '\n')
 					line++;
 			}
 			return lexer(str);
 		} else if (c == '/') {  // start of '//' line comment
 			while (c > 0 && c != '\n')
-				c = f.get();
+				c = get();
 			line++;
 			return lexer(str);
 		}
-		f.unget();
+		unget(c);
 		// fprintf(stderr, "LEX: char >>/<<\n");
 		return '/';             // a single '/' charater.
 	}
 
 	// check for a backslash
 	if (c == '\\') {
-		c = f.get();		
+		c = get();
 		if (c == '\r')
-			c = f.get();
+			c = get();
 		if (c == '\n') {
 			line++;
 			return lexer(str);
 		}
-		f.unget();
+		unget(c);
 		return '\\';
 	}
 
@@ -223,7 +249,7 @@ LibertyAst *LibertyParser::parse()
 	}
 
 	LibertyAst *ast = new LibertyAst;
-	ast->id = str;
+	ast->id.swap(str);
 
 	while (1)
 	{
@@ -366,6 +392,199 @@ void LibertyParser::error(const std::string &str)
 	log_error("%s", ss.str().c_str());
 }
 
+// Cache files hold the magic line followed by the nodes in depth-first order,
+// each as id, value, args and children. Strings are prefixed by their length
+// and all numbers are stored as LEB128.
+static const char liberty_cache_magic[] = "yosys-liberty-cache-1\n";
+
+static void liberty_cache_write_uint(std::string &out, size_t val)
+{
+	while (val >= 0x80) {
+		out += char(val | 0x80);
+		val >>= 7;
+	}
+	out += char(val);
+}
+
+static void liberty_cache_write_str(std::string &out, const std::string &str)
+{
+	liberty_cache_write_uint(out, str.size());
+	out += str;
+}
+
+static void liberty_cache_write(std::string &out, const LibertyAst *ast)
+{
+	liberty_cache_write_str(out, ast->id);
+	liberty_cache_write_str(out, ast->value);
+	liberty_cache_write_uint(out, ast->args.size());
+	for (auto &arg : ast->args)
+		liberty_cache_write_str(out, arg);
+	liberty_cache_write_uint(out, ast->children.size());
+	for (auto child : ast->children)
+		liberty_cache_write(out, child);
+}
+
+struct LibertyCacheReader
+{
+	const char *pos, *end;
+
+	bool read_uint(size_t &val)
+	{
+		val = 0;
+		for (int shift = 0; pos != end && shift < 64; shift += 7) {
+			unsigned char c = *pos++;
+			val |= size_t(c & 0x7f) << shift;
+			if ((c & 0x80) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	bool read_str(std::string &str)
+	{
+		size_t len;
+		if (!read_uint(len) || len > size_t(end - pos))
+			return false;
+		str.assign(pos, len);
+		pos += len;
+		return true;
+	}
+
+	// every arg and child takes at least one byte, so larger counts can only
+	// come from a corrupted file
+	bool read(LibertyAst *ast)
+	{
+		size_t count;
+		if (!read_str(ast->id) || !read_str(ast->value) || !read_uint(count) || count > size_t(end - pos))
+			return false;
+		ast->args.resize(count);
+		for (auto &arg : ast->args)
+			if (!read_str(arg))
+				return false;
+		if (!read_uint(count) || count > size_t(end - pos))
+			return false;
+		ast->children.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			LibertyAst *child = new LibertyAst;
+			ast->children.push_back(child);
+			if (!read(child))
+				return false;
+		}
+		return true;
+	}
+};
+
+static std::shared_ptr<LibertyAst> liberty_cache_read(const std::string &cache_file)
+{
+	std::ifstream f(cache_file, std::ifstream::binary);
+	if (f.fail())
+		return nullptr;
+
+	std::string data;
+	f.seekg(0, std::ios::end);
+	data.resize(f.tellg());
+	f.seekg(0, std::ios::beg);
+	f.read(&data[0], data.size());
+	if (f.fail())
+		return nullptr;
+
+	size_t magic_len = strlen(liberty_cache_magic);
+	if (data.compare(0, magic_len, liberty_cache_magic) != 0)
+		return nullptr;
+
+	LibertyCacheReader reader;
+	reader.pos = data.data() + magic_len;
+	reader.end = data.data() + data.size();
+
+	std::shared_ptr<LibertyAst> ast = std::make_shared<LibertyAst>();
+	if (!reader.read(ast.get()) || reader.pos != reader.end)
+		return nullptr;
+	return ast;
+}
+
+static void liberty_cache_store(const std::string &cache_dir, const std::string &cache_file, const LibertyAst *ast)
+{
+	std::string data = liberty_cache_magic;
+	liberty_cache_write(data, ast);
+
+	// write to a temporary file first so that concurrent runs never see a
+	// partially written cache file
+	std::string tmp_filename;
+	if (create_directory(cache_dir))
+		tmp_filename = make_temp_file(cache_file + ".XXXXXX");
+	std::ofstream f(tmp_filename, std::ofstream::binary);
+	if (tmp_filename.empty() || f.fail()) {
+		log_warning("Can't write liberty cache file `%s'.\n", cache_file.c_str());
+		return;
+	}
+	f.write(data.data(), data.size());
+	f.close();
+
+	if (f.fail() || rename(tmp_filename.c_str(), cache_file.c_str()) != 0)
+		remove(tmp_filename.c_str());
+}
+
+struct LibertyCacheEntry
+{
+	long long mtime = 0, size = 0;
+	std::shared_ptr<LibertyAst> ast;
+};
+
+std::shared_ptr<LibertyAst> LibertyCache::load(RTLIL::Design *design, const std::string &filename)
+{
+	struct stat st;
+	if (stat(filename.c_str(), &st) != 0)
+		return nullptr;
+
+	// the same file can be reached through different relative paths after
+	// a 'cd' command
+	std::string path = filename;
+#ifndef _WIN32
+	char *real_path = realpath(filename.c_str(), nullptr);
+	if (real_path != nullptr) {
+		path = real_path;
+		free(real_path);
+	}
+#endif
+
+	auto &slot = design->parsed_files["liberty:" + path];
+	if (slot == nullptr)
+		slot = std::make_shared<LibertyCacheEntry>();
+	LibertyCacheEntry &entry = *std::static_pointer_cast<LibertyCacheEntry>(slot);
+	if (entry.ast != nullptr && entry.mtime == (long long)st.st_mtime && entry.size == (long long)st.st_size) {
+		log("Using already parsed liberty file `%s'.\n", filename.c_str());
+		return entry.ast;
+	}
+
+	entry.mtime = st.st_mtime;
+	entry.size = st.st_size;
+	entry.ast = nullptr;
+
+	std::string cache_dir = design->scratchpad_get_string("liberty.cache_dir");
+	std::string cache_file;
+	if (!cache_dir.empty()) {
+		cache_file = cache_dir + "/" + sha1(stringf("%s\n%s\n%lld\n%lld\n", yosys_version_str,
+				path.c_str(), entry.size, entry.mtime)) + ".libcache";
+		entry.ast = liberty_cache_read(cache_file);
+		if (entry.ast != nullptr) {
+			log("Loaded liberty file `%s' from cache file `%s'.\n", filename.c_str(), cache_file.c_str());
+			return entry.ast;
+		}
+	}
+
+	std::ifstream f(filename);
+	if (f.fail())
+		return nullptr;
+
+	LibertyParser parser(f);
+	entry.ast.reset(parser.ast != nullptr ? parser.ast : new LibertyAst);
+	parser.ast = nullptr;
+
+	if (!cache_file.empty())
+		liberty_cache_store(cache_dir, cache_file, entry.ast.get());
+	return entry.ast;
+}
+
 #else
 
 void LibertyParser::error()
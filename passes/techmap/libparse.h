@@ -24,9 +24,14 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <memory>
 
 namespace Yosys
 {
+	namespace RTLIL {
+		struct Design;
+	}
+
 	struct LibertyAst
 	{
 		std::string id, value;
@@ -42,11 +47,25 @@ namespace Yosys
 	struct LibertyParser
 	{
 		std::istream &f;
+		std::vector<char> buffer;
+		const char *buffer_pos, *buffer_end;
 		int line;
 		LibertyAst *ast;
-		LibertyParser(std::istream &f) : f(f), line(1), ast(parse()) {}
+		LibertyParser(std::istream &f) : f(f), buffer(1 << 20), buffer_pos(nullptr), buffer_end(nullptr), line(1), ast(parse()) {}
 		~LibertyParser() { if (ast) delete ast; }
-        
+
+		// the input is read in large blocks instead of character by character
+		bool fill_buffer();
+		int get() {
+			if (buffer_pos == buffer_end && !fill_buffer())
+				return EOF;
+			return (unsigned char)*buffer_pos++;
+		}
+		void unget(int c) {
+			if (c != EOF)
+				buffer_pos--;
+		}
+
         /* lexer return values:
            'v': identifier, string, array range [...] -> str holds the token string
            'n': newline
@@ -58,6 +77,20 @@ namespace Yosys
 		void error();
         void error(const std::string &str);
 	};
+
+#ifndef FILTERLIB
+	// Parsed Liberty files shared by read_liberty, dfflibmap and stat. They are
+	// kept with the design (RTLIL::Design::parsed_files) and freed with it or by
+	// 'design -reset'. A file is parsed again only when its modification time
+	// or size has changed. With the scratchpad variable liberty.cache_dir the
+	// parsed files are also stored in that directory in a compact binary format
+	// and loaded from there by later runs.
+	struct LibertyCache
+	{
+		// returns nullptr if the file can't be opened, errno is set then
+		static std::shared_ptr<LibertyAst> load(RTLIL::Design *design, const std::string &filename);
+	};
+#endif
 }
 
 #endif
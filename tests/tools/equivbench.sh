@@ -0,0 +1,28 @@
+#!/usr/bin/env bash
+#
+# Time equiv_simple with one solver per $equiv group, with batched incremental
+# solving (-batch) and with worker processes (-j) on the grom CPU, e.g.:
+#
+#   tests/tools/equivbench.sh 64 4
+#
+# The arguments are the -batch size and the number of -j workers.
+
+set -eu
+
+YOSYS=${YOSYS:-$(dirname "$0")/../../yosys}
+SATDIR=$(dirname "$0")/../sat
+BATCH=${1:-64}
+JOBS=${2:-2}
+
+cd "$SATDIR"
+prepare="read_verilog grom_cpu.v alu.v; prep -top grom_cpu; rename grom_cpu gold; design -stash gold;
+read_verilog grom_cpu.v alu.v; synth -flatten -top grom_cpu; rename grom_cpu gate; design -stash gate;
+design -copy-from gold -as gold gold; design -copy-from gate -as gate gate;
+equiv_make gold gate equiv; hierarchy -top equiv; async2sync"
+
+for mode in "" "-batch $BATCH" "-j $JOBS"; do
+	start=$(date +%s.%N)
+	result=$("$YOSYS" -p "$prepare; equiv_simple -seq 2 $mode; equiv_status" | grep -m1 "Of those cells")
+	end=$(date +%s.%N)
+	printf "%-20s %10s %s\n" "equiv_simple ${mode:-(serial)}" "$(echo "$end - $start" | bc | xargs printf '%.3fs')" "$result"
+done
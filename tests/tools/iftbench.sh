@@ -0,0 +1,60 @@
+#!/usr/bin/env bash
+#
+# Compare the data-flow tagging logic added by dft_tag with the taint tracking
+# logic added by cellift on designs from the test suite. For each design and
+# instrumentation this prints the number of cells and the time the built-in
+# simulator takes for a number of clock cycles (default 1000), e.g.:
+#
+#   tests/tools/iftbench.sh 5000
+#
+# Both instrumentations track a single label for every input except the
+# clock and reset inputs.
+
+set -eu
+
+TESTDIR=$(cd "$(dirname "$0")/.." && pwd)
+YOSYS=${YOSYS:-$TESTDIR/../yosys}
+CYCLES=${1:-1000}
+WORKDIR=$(mktemp -d)
+trap 'rm -rf "$WORKDIR"' EXIT
+
+PREPARE="flatten; memory_map; opt; async2sync; dffunmap; pmuxtree; opt_clean"
+
+declare -A FLOWS=(
+	[plain]="opt_clean"
+	[cellift]="cellift -exclude-signals clk,reset; opt_clean"
+	[cellift_conj]="cellift -conjunctive-gates -exclude-signals clk,reset; opt_clean"
+	[dft_tag]="dft_tag -tag-ports taint -exclude-signals clk,reset; opt_clean"
+	[dft_tag_conj]="dft_tag -conjunctive-gates -tag-ports taint -exclude-signals clk,reset; opt_clean"
+)
+
+run() {
+	local name=$1 read=$2 flow=$3
+	local log=$WORKDIR/$name-$flow.log
+	if ! "$YOSYS" -p "$read; $PREPARE; ${FLOWS[$flow]}; stat; write_rtlil $WORKDIR/$name-$flow.il" >"$log" 2>&1; then
+		printf " %20s" "failed"
+		return
+	fi
+	local cells=$(grep "Number of cells" "$log" | tail -n1 | awk '{print $NF}')
+	local start=$(date +%s.%N)
+	"$YOSYS" -q -p "read_rtlil $WORKDIR/$name-$flow.il; sim -clock clk -n $CYCLES -zinit -q" >/dev/null 2>&1 || true
+	local end=$(date +%s.%N)
+	printf " %20s" "$cells $(echo "$end - $start" | bc | xargs printf '%.2fs')"
+}
+
+bench() {
+	local name=$1 read=$2
+	printf "%-10s" "$name"
+	for flow in plain cellift cellift_conj dft_tag dft_tag_conj; do
+		run "$name" "$read" $flow
+	done
+	printf "\n"
+}
+
+printf "%-10s" "design"
+for flow in plain cellift cellift_conj dft_tag dft_tag_conj; do printf " %20s" "$flow"; done
+printf "\n"
+
+bench fsm "read_verilog $TESTDIR/simple/fsm.v; hierarchy -top fsm_test; proc"
+bench operators "read_verilog $TESTDIR/simple/operators.v; hierarchy -top optest; proc"
+(cd "$TESTDIR/sat" && bench grom "read_verilog grom_computer.v grom_cpu.v alu.v ram_memory.v; hierarchy -top grom_computer; proc")
@@ -0,0 +1,46 @@
+#!/usr/bin/env bash
+#
+# Time read_json on a large generated netlist, reading the whole JSON tree,
+# with -stream and with -mmap. The first argument scales the design (default
+# 200), e.g.:
+#
+#   tests/tools/jsonbench.sh 2000
+#
+# The peak memory usage is printed as well when GNU time is available.
+
+set -eu
+
+TESTDIR=$(cd "$(dirname "$0")/.." && pwd)
+YOSYS=${YOSYS:-$TESTDIR/../yosys}
+SIZE=${1:-200}
+WORKDIR=$(mktemp -d)
+trap 'rm -rf "$WORKDIR"' EXIT
+
+{
+	echo "module top(input clk, input [31:0] a, b, output [31:0] y);"
+	echo "  reg [31:0] r0;"
+	echo "  always @(posedge clk) r0 <= a;"
+	for ((i = 1; i < SIZE; i++)); do
+		echo "  reg [31:0] r$i;"
+		echo "  always @(posedge clk) r$i <= (r$((i-1)) * b) ^ {r$((i-1))[15:0], a[31:16]};"
+	done
+	echo "  assign y = r$((SIZE-1));"
+	echo "endmodule"
+} > "$WORKDIR/top.v"
+
+"$YOSYS" -q -p "read_verilog $WORKDIR/top.v; synth -flatten -top top; write_json $WORKDIR/top.json"
+ls -l "$WORKDIR/top.json"
+
+for opt in "" -stream -mmap; do
+	cmd=("$YOSYS" -q -p "read_json $opt $WORKDIR/top.json")
+	start=$(date +%s.%N)
+	if [ -x /usr/bin/time ]; then
+		/usr/bin/time -f "%M" -o "$WORKDIR/rss" "${cmd[@]}"
+		rss="$(cat "$WORKDIR/rss") KB"
+	else
+		"${cmd[@]}"
+		rss="-"
+	fi
+	end=$(date +%s.%N)
+	printf "%-8s %8.2fs %12s\n" "${opt:-tree}" "$(echo "$end - $start" | bc)" "$rss"
+done
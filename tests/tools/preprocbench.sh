@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+#
+# Time the Verilog preprocessor on a large generated input with heavy macro
+# usage, similar to the output of Chisel/FIRRTL flows. The first argument is
+# the number of generated modules (default 2000), e.g.:
+#
+#   tests/tools/preprocbench.sh 20000
+#
+# The file is read with -defer, so only the preprocessor and the parser run.
+# For reference, the same design using only flat (non-nested) macros is
+# timed as well.
+
+set -eu
+
+TESTDIR=$(cd "$(dirname "$0")/.." && pwd)
+YOSYS=${YOSYS:-$TESTDIR/../yosys}
+MODULES=${1:-2000}
+WORKDIR=$(mktemp -d)
+trap 'rm -rf "$WORKDIR"' EXIT
+
+gen() {
+	local plain=$1
+	if [ "$plain" = 1 ]; then
+		echo '`define RANDOMIZE'
+		echo '`define REG(name, width) reg [width-1:0] name;'
+		echo '`define ASSIGN(lhs, rhs) assign lhs = rhs;'
+	else
+		echo '`define RANDOMIZE_REG_INIT'
+		echo '`define RANDOMIZE `ifdef RANDOMIZE_REG_INIT `RANDOM_INIT `endif'
+		echo '`define RANDOM_INIT /* random init */'
+		echo '`define WIDTH(w) (w)'
+		echo '`define REG(name, width) reg [`WIDTH(width)-1:0] name;'
+		echo '`define ASSIGN(lhs, rhs) assign lhs = `WIDTH(rhs);'
+	fi
+	for ((i = 0; i < MODULES; i++)); do
+		echo "module m$i(input clk, input [31:0] a, b, output [31:0] y);"
+		for ((j = 0; j < 8; j++)); do
+			echo "  \`REG(r${j}, 32)"
+			echo "  always @(posedge clk) r${j} <= a ^ b; // \`RANDOMIZE"
+		done
+		echo "  \`ASSIGN(y, r0 + r1 + r2 + r3 + r4 + r5 + r6 + r7)"
+		echo "  \`RANDOMIZE"
+		echo "endmodule"
+	done
+}
+
+gen 0 > "$WORKDIR/macros.v"
+gen 1 > "$WORKDIR/plain.v"
+
+for name in macros plain; do
+	size=$(du -h "$WORKDIR/$name.v" | cut -f1)
+	start=$(date +%s.%N)
+	"$YOSYS" -q -p "read_verilog -defer $WORKDIR/$name.v"
+	end=$(date +%s.%N)
+	printf "%-8s %8s %8.2fs\n" "$name" "$size" "$(echo "$end - $start" | bc)"
+done
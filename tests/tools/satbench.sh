@@ -0,0 +1,64 @@
+#!/usr/bin/env bash
+#
+# Dump the CNF of the SAT problems of the tests/sat designs and time external
+# SAT solvers on them, e.g.:
+#
+#   tests/tools/satbench.sh "cadical -q" "kissat -q"
+#
+# The solvers must print their result in SAT competition format ("s SATISFIABLE"
+# or "s UNSATISFIABLE"). The first solver is used as reference: the script fails
+# if another solver reports a different result for any CNF.
+
+set -eu
+
+YOSYS=${YOSYS:-$(dirname "$0")/../../yosys}
+SATDIR=$(dirname "$0")/../sat
+WORKDIR=$(mktemp -d)
+trap 'rm -rf "$WORKDIR"' EXIT
+
+if [ $# -eq 0 ]; then
+	echo "Usage: $0 <solver-command>..." >&2
+	exit 1
+fi
+
+dump() {
+	local name=$1; shift
+	"$YOSYS" -q -p "$*; sat $SAT_ARGS -dump_cnf $WORKDIR/$name.cnf" >/dev/null 2>&1 || true
+}
+
+cd "$SATDIR"
+SAT_ARGS="-seq 20 -prove-asserts -set-init-zero" dump asserts_seq "read_verilog -sv asserts_seq.v; hierarchy -top test_002; proc; opt; async2sync"
+SAT_ARGS="-seq 10 -prove-asserts" dump initval "read_verilog -sv initval.v; proc; async2sync"
+SAT_ARGS="-seq 8 -prove-asserts -set-at 1 in_rst 1" dump counters "read_verilog counters.v; proc; opt; expose -shared counter1 counter2; miter -equiv -make_assert -make_outputs counter1 counter2 miter; cd miter; flatten; opt"
+SAT_ARGS="-seq 12 -set-init-zero -prove-asserts" dump grom "read_verilog grom_computer.v grom_cpu.v alu.v ram_memory.v; prep -top grom_computer; memory_map; flatten; async2sync; chformal -assert -remove; opt_clean"
+
+printf "%-20s" "cnf"
+for solver in "$@"; do printf " %20s" "$solver"; done
+printf "\n"
+
+mismatch=0
+for cnf in "$WORKDIR"/*.cnf; do
+	[ -e "$cnf" ] || continue
+	printf "%-20s" "$(basename "$cnf" .cnf)"
+	reference=
+	for solver in "$@"; do
+		start=$(date +%s.%N)
+		result=$($solver "$cnf" 2>/dev/null | grep -m1 '^s ' || echo "s ERROR")
+		end=$(date +%s.%N)
+		result=${result#s }
+		mark=
+		if [ -z "$reference" ]; then
+			reference=$result
+		elif [ "$result" != "$reference" ]; then
+			mark="!"
+			mismatch=1
+		fi
+		printf " %20s" "$(echo "$end - $start" | bc | xargs printf '%.3fs') $result$mark"
+	done
+	printf "\n"
+done
+
+if [ $mismatch -ne 0 ]; then
+	echo "Results marked with ! differ from those of '$1'." >&2
+	exit 1
+fi
@@ -0,0 +1,67 @@
+#!/usr/bin/env bash
+#
+# Time the AST simplifier on large generated designs with many module items:
+# wide unrolled generate loops, long lists of continuous assignments and a
+# chain of localparams evaluated by a constant function. The first argument
+# scales the designs (default 2000), e.g.:
+#
+#   tests/tools/simplifybench.sh 20000
+#
+# Each design is elaborated by read_verilog, nothing else is run.
+
+set -eu
+
+TESTDIR=$(cd "$(dirname "$0")/.." && pwd)
+YOSYS=${YOSYS:-$TESTDIR/../yosys}
+SIZE=${1:-2000}
+WORKDIR=$(mktemp -d)
+trap 'rm -rf "$WORKDIR"' EXIT
+
+gen_generate() {
+	echo "module top(input clk, input [$((SIZE-1)):0] a, b, output [$((SIZE-1)):0] y);"
+	echo "  genvar i, j;"
+	echo "  for (i = 0; i < $SIZE; i = i + 1) begin : g"
+	echo "    wire [3:0] t;"
+	echo "    for (j = 0; j < 4; j = j + 1) begin : h"
+	echo "      assign t[j] = a[(i + j) % $SIZE] ^ b[i];"
+	echo "    end"
+	echo "    reg r;"
+	echo "    always @(posedge clk) r <= ^t;"
+	echo "    assign y[i] = r;"
+	echo "  end"
+	echo "endmodule"
+}
+
+gen_assigns() {
+	echo "module top(input [31:0] a, output [31:0] y);"
+	for ((i = 0; i < SIZE; i++)); do
+		echo "  wire [31:0] w$i;"
+	done
+	echo "  assign w0 = a;"
+	for ((i = 1; i < SIZE; i++)); do
+		echo "  assign w$i = {w$((i-1))[30:0], w$((i-1))[31]} + $i;"
+	done
+	echo "  assign y = w$((SIZE-1));"
+	echo "endmodule"
+}
+
+gen_params() {
+	echo "module top(output [31:0] y);"
+	echo "  function automatic [31:0] f(input [31:0] x);"
+	echo "    f = x * 3 + 1;"
+	echo "  endfunction"
+	echo "  localparam [31:0] P0 = 1;"
+	for ((i = 1; i < SIZE; i++)); do
+		echo "  localparam [31:0] P$i = f(P$((i-1)));"
+	done
+	echo "  assign y = P$((SIZE-1));"
+	echo "endmodule"
+}
+
+for name in generate assigns params; do
+	gen_$name > "$WORKDIR/$name.v"
+	start=$(date +%s.%N)
+	"$YOSYS" -q -p "read_verilog $WORKDIR/$name.v"
+	end=$(date +%s.%N)
+	printf "%-10s %8.2fs\n" "$name" "$(echo "$end - $start" | bc)"
+done
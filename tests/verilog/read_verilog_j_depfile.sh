@@ -0,0 +1,23 @@
+#!/usr/bin/env bash
+
+# read_verilog -j: the files included by the prefetched files must still be
+# listed in the -E dependencies file.
+set -e
+rm -rf read_verilog_j_depfile.out
+mkdir -p read_verilog_j_depfile.out
+cd read_verilog_j_depfile.out
+
+printf 'module a(output [3:0] y); assign y = 1; endmodule\n' > a.v
+# the headers must not change the defines, otherwise the prefetched results
+# are discarded and the files are preprocessed again in order
+printf 'localparam VB = 2;\n' > inc_b.vh
+printf 'module b(output [3:0] y);\n`include "inc_b.vh"\nassign y = VB;\nendmodule\n' > b.v
+printf 'localparam VC = 3;\n' > inc_c.vh
+printf 'module c(output [3:0] y);\n`include "inc_c.vh"\nassign y = VC;\nendmodule\n' > c.v
+
+../../../yosys -E deps.d -p "read_verilog -j 2 a.v b.v c.v" > log.txt
+grep -q "Preprocessing 2 more file(s) with 2 worker process(es)" log.txt
+grep -q "Using prefetched preprocessor output for .b.v'" log.txt
+grep -q "Using prefetched preprocessor output for .c.v'" log.txt
+grep -q "inc_b.vh" deps.d
+grep -q "inc_c.vh" deps.d
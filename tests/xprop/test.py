@@ -320,6 +320,21 @@ if "verify" in steps:
                 sat{seq_args} -enable_undef -set-def-inputs -prove-asserts -verify -show-all gate
                 design -pop
 
+                design -push-copy
+                dffunmap
+                xprop -compact -formal -split-inputs -required -debug-asserts gate
+                clk2fflogic
+                sat{seq_args} -enable_undef -set-def-inputs -prove-asserts -verify -show-all gate
+                design -pop
+
+                design -push-copy
+                dffunmap
+                xprop -compact -required -assume-encoding gate
+                miter -equiv -make_assert -flatten gold gate miter
+                clk2fflogic
+                sat{seq_args} -enable_undef -set-assumes -prove-asserts -verify -show-all miter
+                design -pop
+
                 dffunmap
                 xprop -required -assume-encoding gate
                 miter -equiv -make_assert -flatten gold gate miter